@@ -2,14 +2,23 @@
 // Licensed under the MIT license.
 #include "pch.h"
 #include "Common/DirectXHelper.h"
+#include "Common/EdgeExtractor.h"
+#include "Common/FileReader.h"
+#include "Common/MeshOptimizer.h"
+#include "Common/PointCloudDownsampler.h"
+#include "Common/SceneLayoutJson.h"
 #include "Content/GeometricPrimitives.h"
 #include "AoaSampleAppMain.h"
 
 #include <windows.graphics.directx.direct3d11.interop.h>
+#include <winrt/Windows.Storage.BulkAccess.h>
+#include <winrt/Windows.Storage.FileProperties.h>
 #include <winrt/Windows.Storage.Search.h>
 #include <winrt/Windows.Data.Json.h>
 #include <winrt/Windows.UI.Popups.h>
 
+#include <unordered_set>
+
 using namespace AoaSampleApp;
 using namespace concurrency;
 using namespace Microsoft::WRL;
@@ -30,8 +39,71 @@ namespace
 {
     // Name of the file in application local cache that turns on diagnostics.
     constexpr WCHAR* c_DebugFilename = L"debug";
+
+    // Name of the file in application local cache that turns on bounded diagnostics, kept only around incidents.
+    constexpr WCHAR* c_DebugRingFilename = L"debug-ring";
+
+    // Frames taking longer than this flush the bounded diagnostics.
+    constexpr double c_FrameHitchSeconds = 0.1;
+
+    // How long each planned search area is searched, and how long an area placed by air-tap holds off the planner.
+    constexpr std::chrono::seconds c_PlannedSearchAreaDwellTime{ 2 };
+    constexpr std::chrono::seconds c_ManualSearchAreaHoldTime{ 10 };
+
+    // Head motion is extrapolated over roughly the time until a new search area is first searched.
+    constexpr std::chrono::milliseconds c_SearchAreaPredictionTime{ 500 };
     constexpr WCHAR* c_ConfigurationFilename = L"ms-appx:///ObjectAnchorsConfig.json";
 
+    // Name of the model catalog file in application local cache.
+    constexpr WCHAR* c_ModelCatalogFilename = L"ModelCatalog.bin";
+
+    // Name of the startup trace file in application local cache.
+    constexpr WCHAR* c_StartupTraceFilename = L"StartupTrace.json";
+
+    // Name of the optional file in application local folder with the relative poses of models arranged together.
+    constexpr WCHAR* c_SceneLayoutFilename = L"SceneLayout.json";
+
+    // Name of the sighting index file in application local cache, and of the anchor its locations are relative to.
+    constexpr WCHAR* c_SightingIndexFilename = L"Sightings.bin";
+    constexpr WCHAR* c_SightingAnchorName = L"AoaSampleApp.Sightings";
+
+    // Name of the file in application local cache with the tracker state of the previous session, and how far
+    // models may have moved since.
+    constexpr WCHAR* c_WarmStartFilename = L"WarmStart.json";
+    constexpr float c_WarmStartTolerance = 0.5f;
+
+    // Number of locations where models were seen before that are considered for the next planned search area.
+    constexpr size_t c_MaxPriorLocations = 8;
+
+    // Model meshes get levels of detail with a quarter of the triangles of the previous one. The full mesh is drawn
+    // within this many bounding radii of the user, and each level beyond covers twice the distance of the previous one,
+    // so that the triangles drawn follow the projected area of the model.
+    constexpr size_t c_MeshLevelOfDetailCount = 4;
+    constexpr float c_MeshFullDetailDistanceRatio = 4.0f;
+
+    // Point clouds get previews downsampled to one point per cell of a grid, with cells of this size in meters
+    // for the first preview and twice the size of the previous one for each preview beyond. Doubling the cell size
+    // keeps about a quarter of the points of a scanned surface, matching the levels of detail of meshes.
+    constexpr float c_PointCloudPreviewLeafSize = 0.01f;
+
+    // Model meshes are split into meshlets of up to this many triangles, culled against each camera's view.
+    // Adjacent visible meshlets are drawn together, so larger meshlets mostly trade culling precision for fewer draws.
+    constexpr size_t c_MaxMeshletTriangleCount = 512;
+
+    // Model meshes and point clouds keep 16-bit positions within their bounding box, which is well under
+    // a millimeter of error for models of a few meters, with half the vertex memory of floats.
+    constexpr PositionFormat c_ModelPositionFormat = PositionFormat::UNorm16;
+
+    // Model meshes are drawn as the unique edges of their triangles, leaving out the edges between triangles within
+    // this angle in radians (1 degree) of each other, which are interior edges of flat areas.
+    constexpr float c_MeshWireframeFeatureAngle = 0.0175f;
+
+    // Post-transform cache size assumed when reporting how well model meshes reuse transformed vertices.
+    constexpr size_t c_ReportedVertexCacheSize = 16;
+
+    // Model meshes farther than this many meters along the user's gaze aren't picked.
+    constexpr float c_MaxGazeDistance = 20.0f;
+
     winrt::guid TryParseGuid(winrt::hstring const& value)
     {
         if (value.size() != 36 || value[8] != '-' || value[13] != '-' || value[18] != '-' || value[23] != '-')
@@ -54,21 +126,39 @@ namespace
     }
     catch (...) { return nullptr; }
 
-    static inline DirectX::BoundingOrientedBox GetObjectModelBoundingBox(winrt::Microsoft::Azure::ObjectAnchors::ObjectModel const& model)
+    // Reports the memory a model's geometry takes, compared to full precision positions.
+    void LogGeometryMemory(winrt::guid const& id, PrimitiveRenderer const& renderer)
     {
-        DirectX::BoundingOrientedBox boundingBox{};
+        const size_t vertexBufferSize = renderer.GetVertexBufferSize();
+        const size_t fullPrecisionSize = renderer.GetVertexCount() * sizeof(VertexPosition);
+        const size_t indexBufferSize = renderer.GetIndexBufferSize();
+        const size_t fullIndexSize = renderer.GetIndexCount() * sizeof(uint32_t);
+
+        std::wostringstream message;
+        message << L"Model " << std::wstring_view(winrt::to_hstring(id)) << L" geometry: " << renderer.GetVertexCount()
+            << L" vertices in " << vertexBufferSize / 1024 << L" KB (" << fullPrecisionSize / 1024 << L" KB as floats), "
+            << indexBufferSize / 1024 << L" KB of indices (" << fullIndexSize / 1024 << L" KB as 32-bit), max position error "
+            << renderer.GetMaxPositionError() * 1000.0f << L" mm\n";
+
+        OutputDebugStringW(message.str().c_str());
+    }
 
-        auto sourceBoundingBox = model.BoundingBox();
-        memcpy(&boundingBox.Center, &sourceBoundingBox.Center, sizeof(sourceBoundingBox.Center));
-        memcpy(&boundingBox.Extents, &sourceBoundingBox.Extents, sizeof(sourceBoundingBox.Extents));
-        memcpy(&boundingBox.Orientation, &sourceBoundingBox.Orientation, sizeof(sourceBoundingBox.Orientation));
+    SpatialOrientedBox ToSpatialOrientedBox(SearchAreaProposal const& area)
+    {
+        SpatialOrientedBox boundingBox;
+        boundingBox.Center = ToFloat3(area.Center);
+        boundingBox.Extents = ToFloat3(area.Extents);
+        boundingBox.Orientation = ToQuaternion(area.Orientation);
+        return boundingBox;
+    }
 
-        // ObjectSptialBoundingOrientedBox uses edge-to-edge length as extent, while DirectX uses half width as extent.
-        boundingBox.Extents.x *= 0.5f;
-        boundingBox.Extents.y *= 0.5f;
-        boundingBox.Extents.z *= 0.5f;
+    bool IsSameArea(SearchAreaProposal const& left, SearchAreaProposal const& right)
+    {
+        using namespace DirectX;
 
-        return boundingBox;
+        return XMVector3Equal(XMLoadFloat3(&left.Center), XMLoadFloat3(&right.Center)) &&
+            XMVector4Equal(XMLoadFloat4(&left.Orientation), XMLoadFloat4(&right.Orientation)) &&
+            XMVector3Equal(XMLoadFloat3(&left.Extents), XMLoadFloat3(&right.Extents));
     }
 }
 
@@ -92,6 +182,20 @@ void AoaSampleAppMain::ObjectRenderer::SetTransform(float4x4 const& frameOfRefer
     PointCloudRenderer->SetTransform(frameOfReferenceFromObject);
 }
 
+void AoaSampleAppMain::ObjectRenderer::SelectLevelOfDetail(float distance)
+{
+    float levelDistance = BoundingRadius * c_MeshFullDetailDistanceRatio;
+    size_t level = 0;
+
+    while (distance > levelDistance && level + 1 < PointCloudRenderer->GetLevelOfDetailCount())
+    {
+        levelDistance *= 2.0f;
+        ++level;
+    }
+
+    PointCloudRenderer->SelectLevelOfDetail(level);
+}
+
 void AoaSampleAppMain::ObjectRenderer::CreateDeviceDependentResources()
 {
     BoundingBoxRenderer->CreateDeviceDependentResources();
@@ -104,9 +208,10 @@ void AoaSampleAppMain::ObjectRenderer::ReleaseDeviceDependentResources()
     PointCloudRenderer->ReleaseDeviceDependentResources();
 }
 
-void AoaSampleAppMain::ObjectRenderer::Render()
+void AoaSampleAppMain::ObjectRenderer::Render(ViewProjectionConstantBuffer const& viewProjection)
 {
     BoundingBoxRenderer->Render();
+    PointCloudRenderer->CullMeshlets(viewProjection);
     PointCloudRenderer->Render();
 }
 
@@ -154,10 +259,16 @@ AoaSampleAppMain::AoaSampleAppMain(std::shared_ptr<DeviceResources> const& devic
 
 winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::InitializeAsync()
 {
+    auto initializeSpan = m_startupTrace.BeginSpan("InitializeAsync");
+    m_startupTracePath = PathJoin(ApplicationData::Current().LocalCacheFolder().Path(), c_StartupTraceFilename);
+
     // Parse account id, key and domain
+    auto configurationSpan = m_startupTrace.BeginSpan("ReadConfiguration", initializeSpan.Id());
     auto configuration = co_await PathIO::ReadTextAsync(c_ConfigurationFilename);
 
     AccountInformation accountInformation = TryParseAccountInformation(configuration);
+    configurationSpan.End();
+
     if (!accountInformation)
     {
         winrt::Windows::UI::Popups::MessageDialog message(
@@ -167,19 +278,70 @@ winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::InitializeAsync()
         co_return;
     }
 
-    m_objectTrackerPtr = std::make_unique<ObjectTracker>(accountInformation);
+    {
+        auto span = m_startupTrace.BeginSpan("CreateObjectTracker", initializeSpan.Id());
+        m_objectTrackerPtr = std::make_unique<ObjectTracker>(accountInformation);
+    }
+
+    {
+        // Attribute the access request and observer creation to their own span rather than to the first model load.
+        auto span = m_startupTrace.BeginSpan("WaitForObjectTracker", initializeSpan.Id());
+        co_await m_objectTrackerPtr->WaitForInitializationAsync();
+    }
+
+    {
+        auto span = m_startupTrace.BeginSpan("LoadModelCatalog", initializeSpan.Id());
+        m_modelCatalogPath = PathJoin(ApplicationData::Current().LocalCacheFolder().Path(), c_ModelCatalogFilename);
+        m_modelCatalog.Load(m_modelCatalogPath);
+    }
+
+    {
+        auto span = m_startupTrace.BeginSpan("LoadSceneLayout", initializeSpan.Id());
+        co_await LoadSceneLayoutAsync();
+    }
 
-    co_await LoadObjectModelAsync(ApplicationData::Current().LocalFolder());
-    co_await LoadObjectModelAsync(KnownFolders::Objects3D());
+    {
+        auto span = m_startupTrace.BeginSpan("LoadSightings", initializeSpan.Id());
+        co_await LoadSightingsAsync();
+    }
+
+    {
+        auto span = m_startupTrace.BeginSpan("AddModelFolders", initializeSpan.Id());
+        co_await AddModelFolderAsync(ApplicationData::Current().LocalFolder());
+        co_await AddModelFolderAsync(KnownFolders::Objects3D());
+    }
+
+    // Models are loaded once here, then added, replaced or removed as the model folders change.
+    co_await SyncObjectModelsAsync(initializeSpan.Id());
 
     // Turn on diagnostics if a "debug" file existing in the local cache.
     // This check is required to be after loading models, otherwise the diagnostics session will not
     // include object models.
-    co_await TurnonDiagnosticsIfRequiredAsync();
+    {
+        auto span = m_startupTrace.BeginSpan("TurnonDiagnostics", initializeSpan.Id());
+        co_await TurnonDiagnosticsIfRequiredAsync();
+    }
+
+    {
+        // Models are loaded, so the ones tracked in the previous session can be searched.
+        std::lock_guard lock(m_sightingsMutex);
+        m_warmStartReady = true;
+    }
+
+    initializeSpan.End();
+
+    m_startupTrace.WriteChromeTrace(m_startupTracePath);
+    OutputDebugStringA(m_startupTrace.Summarize().c_str());
 }
 
 AoaSampleAppMain::~AoaSampleAppMain()
 {
+#ifdef DRAW_SAMPLE_CONTENT
+    // Builds in the background use the model BVHs and pending renderer changes below.
+    StopMeshBuilds();
+#endif
+
+    m_modelFolderQueries.clear();
     m_objectTrackerPtr.reset();
 
     m_objectRenderers.clear();
@@ -255,98 +417,677 @@ void AoaSampleAppMain::UnregisterHolographicEventHandlers()
     }
 }
 
-winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::LoadObjectModelAsync(const StorageFolder& rootFolder)
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::AddModelFolderAsync(StorageFolder const& rootFolder)
 {
     // Round-trip through the path to ensure consistent access to known folders like 3D Objects.
     const auto rootFolderByPath = co_await StorageFolder::GetFolderFromPathAsync(rootFolder.Path());
 
-    for (auto const& item : co_await rootFolderByPath.GetItemsAsync())
+    // Enumerate all object models under the root folder with a single deep query. Size and modification
+    // time are prefetched with the query since they are needed to validate catalog entries.
+    Search::QueryOptions queryOptions(Search::CommonFileQuery::DefaultQuery, { L".ou" });
+    queryOptions.FolderDepth(Search::FolderDepth::Deep);
+    queryOptions.SetPropertyPrefetch(FileProperties::PropertyPrefetchOptions::BasicProperties, {});
+
+    ModelFolderQuery folderQuery;
+    folderQuery.Query = rootFolderByPath.CreateFileQueryWithOptions(queryOptions);
+
+    // The query reports changes once its results have been retrieved at least once.
+    folderQuery.ContentsChangedSubscription = folderQuery.Query.ContentsChanged(winrt::auto_revoke, std::bind(&AoaSampleAppMain::OnModelFolderContentsChanged, this, _1, _2));
+
+    m_modelFolderQueries.emplace_back(std::move(folderQuery));
+}
+
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::SyncObjectModelsAsync(StartupTrace::SpanId parentSpan)
+{
+    // Only the first synchronization is part of the startup.
+    auto beginSpan = [this, parentSpan](std::string name, StartupTrace::SpanId parent)
+    {
+        return parentSpan != StartupTrace::c_noSpan ? m_startupTrace.BeginSpan(std::move(name), parent) : StartupTrace::Span{};
+    };
+
+    auto syncSpan = beginSpan("SyncObjectModels", parentSpan);
+    auto enumerateSpan = beginSpan("EnumerateModelFiles", syncSpan.Id());
+
+    struct ModelFileToLoad
+    {
+        IStorageFile File;
+        std::wstring Path;
+        uint64_t Size;
+        int64_t ModifiedTime;
+    };
+
+    std::unordered_set<std::wstring> currentPaths;
+    std::vector<ModelFileToLoad> changedFiles;
+
+    for (auto const& folderQuery : m_modelFolderQueries)
     {
-        if (item.IsOfType(StorageItemTypes::Folder))
+        // Basic properties were prefetched by the query, so they're read along with the files rather than
+        // awaited for each file.
+        BulkAccess::FileInformationFactory fileInformationFactory(folderQuery.Query, FileProperties::ThumbnailMode::SingleItem);
+        const auto files = co_await fileInformationFactory.GetFilesAsync();
+
+        for (auto const& file : files)
         {
-            co_await LoadObjectModelAsync(item.as<StorageFolder>());
+            auto properties = file.BasicProperties();
+            if (!properties)
+            {
+                properties = co_await file.GetBasicPropertiesAsync();
+            }
+
+            const std::wstring path{ file.Path() };
+            const uint64_t size = properties.Size();
+            const int64_t modifiedTime = properties.DateModified().time_since_epoch().count();
+
+            currentPaths.insert(path);
+
+            auto loadedFile = m_modelFiles.find(path);
+            if (loadedFile != m_modelFiles.cend())
+            {
+                if (loadedFile->second.Size == size && loadedFile->second.ModifiedTime == modifiedTime)
+                {
+                    continue;
+                }
+
+                // The file was replaced, release the model loaded from its previous content.
+                ReleaseModelFile(path);
+            }
+
+            changedFiles.emplace_back(ModelFileToLoad{ file, path, size, modifiedTime });
+        }
+    }
+
+    // Models loaded, or about to be, by the content hash of their files. Files with the same content hold the
+    // same model, which is only read and parsed once.
+    std::unordered_map<uint64_t, winrt::guid> loadedContents;
+    for (auto const& [path, modelFile] : m_modelFiles)
+    {
+        loadedContents.emplace(modelFile.ContentHash, modelFile.ModelId);
+    }
+
+    std::vector<ModelFileToLoad> filesToLoad;
+    std::vector<std::pair<ModelFileToLoad, uint64_t>> duplicateFiles;
+    std::unordered_set<uint64_t> contentsToLoad;
+
+    for (auto& changedFile : changedFiles)
+    {
+        // The catalog knows the content of files that didn't change since they were last hashed.
+        if (ModelCatalogEntry const* cachedEntry = m_modelCatalog.Find(changedFile.Path, changedFile.Size, changedFile.ModifiedTime))
+        {
+            const uint64_t contentHash = cachedEntry->ContentHash;
+
+            auto loadedContent = loadedContents.find(contentHash);
+            if (loadedContent != loadedContents.cend())
+            {
+                m_modelFiles.insert_or_assign(changedFile.Path, ModelFile{ changedFile.Size, changedFile.ModifiedTime, loadedContent->second, contentHash });
+                continue;
+            }
+
+            if (!contentsToLoad.insert(contentHash).second)
+            {
+                duplicateFiles.emplace_back(std::move(changedFile), contentHash);
+                continue;
+            }
+        }
+
+        filesToLoad.emplace_back(std::move(changedFile));
+    }
+
+    enumerateSpan.End();
+
+    // Read model files in batches, reusing the read buffers across batches.
+    constexpr size_t c_modelReadBatchSize = 8;
+
+    std::array<std::vector<uint8_t>, c_modelReadBatchSize> buffers;
+    std::array<FileReadRequest, c_modelReadBatchSize> requests;
+
+    for (size_t batchStart = 0; batchStart < filesToLoad.size(); batchStart += c_modelReadBatchSize)
+    {
+        const size_t batchSize = (std::min)(c_modelReadBatchSize, filesToLoad.size() - batchStart);
+
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            auto const& fileToLoad = filesToLoad[batchStart + i];
+            requests[i] = { fileToLoad.Path, fileToLoad.File, &buffers[i] };
+        }
+
+        {
+            auto span = beginSpan("ReadModelFiles", syncSpan.Id());
+            co_await GetFileReader().ReadAsync(winrt::array_view<FileReadRequest>(requests.data(), static_cast<uint32_t>(batchSize)));
+        }
+
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            auto const& fileToLoad = filesToLoad[batchStart + i];
+
+            // The file may have been deleted or replaced since it was enumerated. It's left out for now, and
+            // the next synchronization picks up whatever changed.
+            if (FAILED(requests[i].Result))
+            {
+                std::wostringstream message;
+                message << L"Failed to read model file " << fileToLoad.Path << L": 0x" << std::hex << requests[i].Result << L"\n";
+                OutputDebugStringW(message.str().c_str());
+                continue;
+            }
+
+            auto span = beginSpan("LoadModel " + winrt::to_string(fileToLoad.File.Name()), syncSpan.Id());
+
+            // Only new or modified files need to be hashed.
+            ModelCatalogEntry const* cachedEntry = m_modelCatalog.Find(fileToLoad.Path, fileToLoad.Size, fileToLoad.ModifiedTime);
+            const uint64_t contentHash = cachedEntry ? cachedEntry->ContentHash : ComputeModelContentHash(buffers[i].data(), buffers[i].size());
+
+            auto loadedContent = loadedContents.find(contentHash);
+            const auto id = loadedContent != loadedContents.cend() ?
+                loadedContent->second :
+                co_await LoadObjectModelAsync(buffers[i]);
+
+            loadedContents.emplace(contentHash, id);
+            m_modelFiles.insert_or_assign(fileToLoad.Path, ModelFile{ fileToLoad.Size, fileToLoad.ModifiedTime, id, contentHash });
+
+            if (!cachedEntry)
+            {
+                // SpatialOrientedBox uses edge-to-edge length as extent, while DirectX uses half width as extent.
+                const auto boundingBox = m_objectTrackerPtr->GetObjectModel(id).BoundingBox();
+                const DirectX::BoundingOrientedBox catalogBoundingBox(
+                    { boundingBox.Center.x, boundingBox.Center.y, boundingBox.Center.z },
+                    { boundingBox.Extents.x * 0.5f, boundingBox.Extents.y * 0.5f, boundingBox.Extents.z * 0.5f },
+                    { boundingBox.Orientation.x, boundingBox.Orientation.y, boundingBox.Orientation.z, boundingBox.Orientation.w });
+
+                m_modelCatalog.Update({ fileToLoad.Path, fileToLoad.Size, fileToLoad.ModifiedTime, contentHash, id, catalogBoundingBox });
+            }
+        }
+    }
+
+    // Copies of models loaded above share their model.
+    for (auto const& [duplicateFile, contentHash] : duplicateFiles)
+    {
+        auto loadedContent = loadedContents.find(contentHash);
+        if (loadedContent != loadedContents.cend())
+        {
+            m_modelFiles.insert_or_assign(duplicateFile.Path, ModelFile{ duplicateFile.Size, duplicateFile.ModifiedTime, loadedContent->second, contentHash });
+        }
+    }
+
+    // Release models whose files were deleted.
+    std::vector<std::wstring> removedPaths;
+    for (auto const& [path, modelFile] : m_modelFiles)
+    {
+        if (currentPaths.count(path) == 0)
+        {
+            removedPaths.emplace_back(path);
+        }
+    }
+
+    for (auto const& path : removedPaths)
+    {
+        ReleaseModelFile(path);
+        m_modelCatalog.Remove(path);
+    }
+
+    auto saveSpan = beginSpan("SaveModelCatalog", syncSpan.Id());
+    m_modelCatalog.SaveIfChanged(m_modelCatalogPath);
+}
+
+winrt::Windows::Foundation::IAsyncOperation<winrt::guid> AoaSampleAppMain::LoadObjectModelAsync(std::vector<uint8_t> const& data)
+{
+    const auto id = co_await m_objectTrackerPtr->AddObjectModelAsync(winrt::array_view<uint8_t const>(data.data(), static_cast<uint32_t>(data.size())));
+    const auto model = m_objectTrackerPtr->GetObjectModel(id);
+
+#ifdef DRAW_SAMPLE_CONTENT
+    // Prepare the geometry here; renderers are created on the rendering thread by the next Update.
+    ObjectGeometry geometry;
+
+    // Bounding box geometry.
+    GetBoundingBoxVerticesAndIndices(model.BoundingBox(), geometry.BoundingBoxVertices, geometry.BoundingBoxIndices);
+    geometry.BoundingRadius = 0.5f * length(model.BoundingBox().Extents);
+
+    // Model mesh or point cloud geometry.
+    {
+        std::vector<float3> vertices(model.VertexCount());
+        model.GetVertexPositions(vertices);
+
+        geometry.MeshVertices.assign(
+            reinterpret_cast<DirectX::XMFLOAT3 const*>(vertices.data()),
+            reinterpret_cast<DirectX::XMFLOAT3 const*>(vertices.data() + vertices.size()));
+
+        if (model.TriangleIndexCount() == 0)
+        {
+            geometry.MeshIndices.resize(vertices.size());
+            std::iota(geometry.MeshIndices.begin(), geometry.MeshIndices.end(), uint32_t(0));
+
+            geometry.MeshTopology = D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
+        }
+        else
+        {
+            geometry.MeshIndices.resize(model.TriangleIndexCount());
+            model.GetTriangleIndices(geometry.MeshIndices);
+
+            geometry.MeshTopology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+        }
+
+        {
+            std::lock_guard lock(m_modelBvhsMutex);
+            m_loadedModelIds.insert(id);
+        }
+
+        // The full mesh or point cloud is drawn until levels of detail are ready.
+        BuildMeshLevelsOfDetailAsync(id, geometry.MeshVertices, geometry.MeshIndices, geometry.MeshTopology);
+    }
+
+    {
+        std::lock_guard lock(m_pendingRendererChangesMutex);
+        m_pendingRendererChanges.emplace_back(id, std::move(geometry));
+    }
+#endif //DRAW_SAMPLE_CONTENT
+
+    co_return id;
+}
+
+void AoaSampleAppMain::ReleaseModelFile(std::wstring const& path)
+{
+    auto it = m_modelFiles.find(path);
+    if (it == m_modelFiles.cend())
+    {
+        return;
+    }
+
+    const auto id = it->second.ModelId;
+    m_modelFiles.erase(it);
+
+    // The same model may have been loaded from more than one file.
+    const bool isReferenced = std::any_of(m_modelFiles.cbegin(), m_modelFiles.cend(), [&id](auto const& modelFile)
+    {
+        return modelFile.second.ModelId == id;
+    });
+
+    if (!isReferenced)
+    {
+        m_objectTrackerPtr->RemoveObjectModel(id);
+
+#ifdef DRAW_SAMPLE_CONTENT
+        {
+            std::lock_guard lock(m_pendingRendererChangesMutex);
+            m_pendingRendererChanges.emplace_back(id, std::nullopt);
+        }
+
+        std::lock_guard lock(m_modelBvhsMutex);
+        m_loadedModelIds.erase(id);
+        m_modelBvhs.erase(id);
+#endif
+    }
+}
+
+void AoaSampleAppMain::OnModelFolderContentsChanged(Search::IStorageQueryResultBase const&, winrt::Windows::Foundation::IInspectable const&)
+{
+    {
+        std::lock_guard lock(m_modelFolderChangeMutex);
+
+        m_lastModelFolderChangeTime = std::chrono::steady_clock::now();
+        m_modelFolderChanged = true;
+
+        if (m_modelSyncRunning)
+        {
+            // The running synchronization will pick up this change.
+            return;
+        }
+
+        m_modelSyncRunning = true;
+    }
+
+    SyncObjectModelsAfterChangesAsync();
+}
+
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::SyncObjectModelsAfterChangesAsync()
+{
+    // Copying or converting several models raises a burst of change notifications; wait for the folders
+    // to settle so the whole batch is applied with a single synchronization.
+    constexpr std::chrono::milliseconds c_modelFolderSettleTime{ 500 };
+
+    co_await m_initializeOperation;
+
+    for (;;)
+    {
+        for (;;)
+        {
+            co_await winrt::resume_after(c_modelFolderSettleTime);
+
+            std::lock_guard lock(m_modelFolderChangeMutex);
+            if (std::chrono::steady_clock::now() - m_lastModelFolderChangeTime >= c_modelFolderSettleTime)
+            {
+                m_modelFolderChanged = false;
+                break;
+            }
+        }
+
+        co_await SyncObjectModelsAsync();
+
+        std::lock_guard lock(m_modelFolderChangeMutex);
+        if (!m_modelFolderChanged)
+        {
+            m_modelSyncRunning = false;
+            co_return;
+        }
+    }
+}
+
+#ifdef DRAW_SAMPLE_CONTENT
+void AoaSampleAppMain::ApplyPendingRendererChanges()
+{
+    decltype(m_pendingRendererChanges) changes;
+    {
+        std::lock_guard lock(m_pendingRendererChangesMutex);
+        changes.swap(m_pendingRendererChanges);
+    }
+
+    const auto meshColor =
+        m_objectTrackerPtr && m_objectTrackerPtr->GetInstanceTrackingMode() == ObjectInstanceTrackingMode::HighLatencyAccuratePosition ?
+        c_Yellow : c_Magenta;
+
+    for (auto& [id, geometry] : changes)
+    {
+        if (!geometry)
+        {
+            m_objectRenderers.erase(id);
             continue;
         }
 
-        const auto file = item.as<StorageFile>();
-        if (file.FileType() != L".ou")
+        if (m_objectRenderers.count(id) != 0)
         {
             continue;
         }
 
-        const auto id = co_await m_objectTrackerPtr->AddObjectModelAsync(file);
-        const auto model = m_objectTrackerPtr->GetObjectModel(id);
+        // The new model may be in space searched for the others already. The planner may be proposing
+        // in the background, so coverage is reset before its next proposal.
+        m_searchCoverageStale = true;
 
-#ifdef DRAW_SAMPLE_CONTENT
         ObjectRenderer renderer;
         renderer.BoundingBoxRenderer = std::make_unique<PrimitiveRenderer>(m_deviceResources);
-        renderer.PointCloudRenderer = std::make_unique<PrimitiveRenderer>(m_deviceResources);
+        renderer.PointCloudRenderer = std::make_unique<PrimitiveRenderer>(m_deviceResources, c_ModelPositionFormat);
 
         // Setup bounding box renderer
+        renderer.BoundingBoxRenderer->SetVerticesAndIndices(
+            geometry->BoundingBoxVertices.data(),
+            static_cast<uint32_t>(geometry->BoundingBoxVertices.size()),
+            geometry->BoundingBoxIndices.data(),
+            static_cast<uint32_t>(geometry->BoundingBoxIndices.size()),
+            D3D11_PRIMITIVE_TOPOLOGY_LINELIST
+        );
+
+        renderer.BoundingBoxRenderer->SetColor(c_Magenta);
+
+        // Setup model point cloud renderer
+        renderer.PointCloudRenderer->SetVerticesAndIndices(
+            geometry->MeshVertices.data(),
+            static_cast<uint32_t>(geometry->MeshVertices.size()),
+            geometry->MeshIndices.data(),
+            static_cast<uint32_t>(geometry->MeshIndices.size()),
+            geometry->MeshTopology
+        );
+
+        renderer.PointCloudRenderer->SetColor(meshColor);
+        renderer.BoundingRadius = geometry->BoundingRadius;
+
+        LogGeometryMemory(id, *renderer.PointCloudRenderer);
+
+        m_objectRenderers.emplace(id, std::move(renderer));
+    }
+
+    decltype(m_pendingMeshLevelsOfDetail) meshLevelsOfDetail;
+    {
+        std::lock_guard lock(m_pendingRendererChangesMutex);
+        meshLevelsOfDetail.swap(m_pendingMeshLevelsOfDetail);
+    }
+
+    for (auto& [id, mesh] : meshLevelsOfDetail)
+    {
+        auto it = m_objectRenderers.find(id);
+        if (it == m_objectRenderers.end())
         {
-            std::vector<DirectX::XMFLOAT3> vertices;
-            std::vector<uint32_t> indices;
-            GetBoundingBoxVerticesAndIndices(model.BoundingBox(), vertices, indices);
-
-            renderer.BoundingBoxRenderer->SetVerticesAndIndices(
-                vertices.data(),
-                static_cast<uint32_t>(vertices.size()),
-                indices.data(),
-                static_cast<uint32_t>(indices.size()),
-                D3D11_PRIMITIVE_TOPOLOGY_LINELIST
-            );
-
-            renderer.BoundingBoxRenderer->SetColor(c_Magenta);
+            continue;
         }
 
-        // Setup model point cloud renderer
+        it->second.PointCloudRenderer->SetVerticesAndIndices(
+            mesh.Vertices.data(),
+            static_cast<uint32_t>(mesh.Vertices.size()),
+            mesh.Indices.data(),
+            static_cast<uint32_t>(mesh.Indices.size()),
+            mesh.Topology);
+
+        it->second.PointCloudRenderer->SetLevelsOfDetail(std::move(mesh.Levels));
+        it->second.PointCloudRenderer->SetMeshlets(std::move(mesh.Meshlets));
+
+        LogGeometryMemory(id, *it->second.PointCloudRenderer);
+    }
+}
+
+bool AoaSampleAppMain::TryBeginMeshBuild()
+{
+    std::lock_guard lock(m_meshBuildsMutex);
+
+    if (m_meshBuildsStopped)
+    {
+        return false;
+    }
+
+    if (m_meshBuildCount++ == 0)
+    {
+        ::ResetEvent(m_meshBuildsEnded.get());
+    }
+
+    return true;
+}
+
+void AoaSampleAppMain::EndMeshBuild()
+{
+    std::lock_guard lock(m_meshBuildsMutex);
+
+    if (--m_meshBuildCount == 0)
+    {
+        ::SetEvent(m_meshBuildsEnded.get());
+    }
+}
+
+bool AoaSampleAppMain::IsMeshBuildStopped()
+{
+    std::lock_guard lock(m_meshBuildsMutex);
+    return m_meshBuildsStopped;
+}
+
+void AoaSampleAppMain::StopMeshBuilds()
+{
+    {
+        std::lock_guard lock(m_meshBuildsMutex);
+        m_meshBuildsStopped = true;
+    }
+
+    // Builds check for the stop between steps, so this waits for at most one step of each.
+    ::WaitForSingleObject(m_meshBuildsEnded.get(), INFINITE);
+}
+
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::BuildMeshLevelsOfDetailAsync(winrt::guid id, std::vector<DirectX::XMFLOAT3> vertices, std::vector<uint32_t> indices, D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+    // Begins before the coroutine first suspends, so that the destructor can't miss a build.
+    if (!TryBeginMeshBuild())
+    {
+        co_return;
+    }
+
+    struct MeshBuildEnd
+    {
+        AoaSampleAppMain* Main;
+        ~MeshBuildEnd() { Main->EndMeshBuild(); }
+    } buildEnd{ this };
+
+    // Each model is simplified on its own thread pool work item, so models loaded together are simplified in parallel.
+    co_await winrt::resume_background();
+
+    MeshLevelsOfDetail mesh;
+    mesh.Topology = topology;
+    if (topology == D3D11_PRIMITIVE_TOPOLOGY_POINTLIST)
+    {
+        mesh.Levels = BuildPointCloudLevelsOfDetail(vertices, indices, c_PointCloudPreviewLeafSize, c_MeshLevelOfDetailCount);
+
+        if (mesh.Levels.size() < 2)
         {
-            std::vector<float3> vertices(model.VertexCount());
-            model.GetVertexPositions(vertices);
+            co_return;
+        }
+    }
+    else
+    {
+        const size_t originalVertexCount = vertices.size();
 
-            D3D_PRIMITIVE_TOPOLOGY topology;
-            std::vector<uint32_t> indices;
+        // Vertices duplicated along seams split the mesh into pieces that are simplified and grouped separately.
+        WeldVertices(vertices, indices);
+
+        mesh.Levels = BuildMeshLevelsOfDetail(vertices, indices, c_MeshLevelOfDetailCount);
+
+        if (IsMeshBuildStopped())
+        {
+            co_return;
+        }
+
+        // Meshlets never span levels, so each level is culled on its own. Reordering triangles for the vertex
+        // cache within each meshlet keeps meshlets contiguous, and orders the edges drawn, which follow the triangles.
+        std::vector<std::vector<Meshlet>> levelMeshlets;
+        for (auto const& level : mesh.Levels)
+        {
+            auto& meshlets = levelMeshlets.emplace_back(BuildMeshlets(vertices, indices, level, c_MaxMeshletTriangleCount));
+            for (auto const& meshlet : meshlets)
+            {
+                OptimizeVertexCache(indices.data() + meshlet.StartIndex, meshlet.IndexCount);
+            }
+        }
+
+        if (IsMeshBuildStopped())
+        {
+            co_return;
+        }
+
+        const size_t triangleIndexCount = mesh.Levels[0].IndexCount;
+
+        // Rays pick the full detail mesh, whichever level is drawn.
+        auto bvh = std::make_shared<MeshBvh const>(vertices, indices.data(), triangleIndexCount);
+        const size_t bvhNodeCount = bvh->GetNodeCount();
+        {
+            // The model may have been released while the hierarchy was built.
+            std::lock_guard lock(m_modelBvhsMutex);
+            if (m_loadedModelIds.count(id) == 0)
+            {
+                co_return;
+            }
+
+            m_modelBvhs.insert_or_assign(id, std::move(bvh));
+        }
+
+        if (IsMeshBuildStopped())
+        {
+            co_return;
+        }
+
+        // Each level's meshlets become ranges of its edges, which are drawn as lines rather than wireframe triangles.
+        std::vector<uint32_t> lines;
+        for (size_t i = 0; i < mesh.Levels.size(); ++i)
+        {
+            auto& meshlets = levelMeshlets[i];
+
+            std::vector<MeshLevelOfDetail> ranges;
+            ranges.reserve(meshlets.size());
+            for (auto const& meshlet : meshlets)
+            {
+                ranges.push_back({ meshlet.StartIndex, meshlet.IndexCount });
+            }
+
+            const auto levelLines = ExtractEdges(vertices, indices, ranges, c_MeshWireframeFeatureAngle);
+            const uint32_t levelStart = static_cast<uint32_t>(lines.size());
+
+            for (size_t j = 0; j < meshlets.size(); ++j)
+            {
+                // Meshlets with only smooth edges have nothing to draw.
+                if (ranges[j].IndexCount > 0)
+                {
+                    meshlets[j].StartIndex = levelStart + ranges[j].StartIndex;
+                    meshlets[j].IndexCount = ranges[j].IndexCount;
+                    mesh.Meshlets.push_back(meshlets[j]);
+                }
+            }
+
+            mesh.Levels[i] = { levelStart, static_cast<uint32_t>(levelLines.size()) };
+            lines.insert(lines.end(), levelLines.cbegin(), levelLines.cend());
+        }
+
+        indices = std::move(lines);
+        mesh.Topology = D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+
+        const float cacheMissRatio = GetAverageCacheMissRatio(indices.data(), mesh.Levels[0].IndexCount, 2, c_ReportedVertexCacheSize);
+
+        std::wostringstream message;
+        message << L"Model " << std::wstring_view(winrt::to_hstring(id)) << L" mesh: " << originalVertexCount << L" vertices welded to "
+            << vertices.size() << L", " << triangleIndexCount << L" wireframe edges drawn as " << mesh.Levels[0].IndexCount / 2
+            << L" lines with an average cache miss ratio of " << cacheMissRatio << L" per line, "
+            << bvhNodeCount << L" picking hierarchy nodes\n";
+
+        OutputDebugStringW(message.str().c_str());
+    }
 
-            if (model.TriangleIndexCount() == 0)
-            {
-                indices.resize(vertices.size());
-                std::iota(indices.begin(), indices.end(), uint32_t(0));
+    mesh.Vertices = std::move(vertices);
+    mesh.Indices = std::move(indices);
 
-                topology = D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
-            }
-            else
-            {
-                indices.resize(model.TriangleIndexCount());
-                model.GetTriangleIndices(indices);
+    std::lock_guard lock(m_pendingRendererChangesMutex);
+    m_pendingMeshLevelsOfDetail.emplace_back(id, std::move(mesh));
+}
 
-                topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-            }
+std::optional<AoaSampleAppMain::ModelHit> AoaSampleAppMain::PickTrackedObject(float3 const& origin, float3 const& direction, std::vector<std::pair<winrt::guid, SpatialPose>> const& modelPoses)
+{
+    std::optional<ModelHit> nearestHit;
+    float maxDistance = c_MaxGazeDistance;
 
-            renderer.PointCloudRenderer->SetVerticesAndIndices(
-                reinterpret_cast<DirectX::XMFLOAT3*>(vertices.data()),
-                static_cast<uint32_t>(vertices.size()),
-                indices.data(),
-                static_cast<uint32_t>(indices.size()),
-                topology
-            );
+    std::lock_guard lock(m_modelBvhsMutex);
 
-            renderer.PointCloudRenderer->SetColor(c_Magenta);
+    for (auto const& [modelId, pose] : modelPoses)
+    {
+        auto it = m_modelBvhs.find(modelId);
+        if (it == m_modelBvhs.cend())
+        {
+            continue;
         }
 
-        m_objectRenderers.emplace(id, std::move(renderer));
-#endif //DRAW_SAMPLE_CONTENT
+        // The ray is moved into the model's space rather than moving the mesh. Poses are rigid, so distances
+        // along the ray are the same in both.
+        const quaternion frameOfReferenceToModel = inverse(pose.Orientation);
+        const float3 modelOrigin = transform(origin - pose.Position, frameOfReferenceToModel);
+        const float3 modelDirection = transform(direction, frameOfReferenceToModel);
+
+        const auto hit = it->second->Intersect(
+            DirectX::XMVectorSet(modelOrigin.x, modelOrigin.y, modelOrigin.z, 0.0f),
+            DirectX::XMVectorSet(modelDirection.x, modelDirection.y, modelDirection.z, 0.0f),
+            maxDistance);
+
+        if (hit)
+        {
+            maxDistance = hit->Distance;
+            nearestHit = ModelHit{ modelId, origin + direction * hit->Distance, hit->Distance };
+        }
     }
+
+    return nearestHit;
 }
+#endif
 
 winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::TurnonDiagnosticsIfRequiredAsync()
 {
     // Check if a file named "debug" existing in the local cache folder or the 3D Objects folder
     // If exists, turn on diagnostics, otherwise turn it off.
+    // A file named "debug-ring" instead turns on bounded diagnostics, copied to the diagnostics folder on incidents.
 
     if (co_await ApplicationData::Current().LocalFolder().TryGetItemAsync(c_DebugFilename) ||
         co_await KnownFolders::Objects3D().TryGetItemAsync(c_DebugFilename))
     {
-        co_await m_objectTrackerPtr->StartDiagnosticsAsync();
+        // Diagnostics are uploaded in segments while they're captured.
+        co_await m_objectTrackerPtr->StartDiagnosticsStreamAsync({});
+    }
+    else if (co_await ApplicationData::Current().LocalFolder().TryGetItemAsync(c_DebugRingFilename) ||
+        co_await KnownFolders::Objects3D().TryGetItemAsync(c_DebugRingFilename))
+    {
+        co_await m_objectTrackerPtr->StartDiagnosticsRingAsync({});
     }
     else
     {
@@ -368,7 +1109,7 @@ winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::StopAndUploadDiagnost
     co_await m_objectTrackerPtr->UploadDiagnosticsAsync(diagnosticsFilePath);
 }
 
-winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::UpdateObjectSearchArea(winrt::Windows::Perception::People::HeadPose const& headPose)
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::UpdateObjectSearchArea(PredictedHeadPose headPose)
 {
     if (m_initializeOperation)
     {
@@ -413,9 +1154,9 @@ winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::UpdateObjectSearchAre
     coordinateSystem.NodeId = frameOfReference.NodeId();
     coordinateSystem.CoordinateSystemToNodeTransform = frameOfReference.CoordinateSystemToNodeTransform();
 
-    const float3 headPosition = headPose.Position();
-    const float3 headForwardDirection = headPose.ForwardDirection();
-    const float3 headUpDirection = headPose.UpDirection();
+    const float3 headPosition = ToFloat3(headPose.Position);
+    const float3 headForwardDirection = ToFloat3(headPose.ForwardDirection);
+    const float3 headUpDirection = ToFloat3(headPose.UpDirection);
 
     constexpr float c_observationDistance = 2.0f;
     const float3 boundsPosition = headPosition + (c_observationDistance * headForwardDirection);
@@ -451,90 +1192,438 @@ winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::UpdateObjectSearchAre
     constexpr float c_minHorizontalFov = 75.0f;
     constexpr float c_maxHorizontalFov = 180.0f;
 
-    // Find maximum bounding box and field of view large enough to cover all objects.
-    float requiredScale = 1.0f;
-    float maxModelExtent = 0.0f;
-    XMFLOAT3 requiredMaxExtents{ 0.0f, 0.0f, 0.0f };
-
-    for (auto const& renderer : m_objectRenderers)
+    // Bounding box and field of view large enough to cover the given models.
+    const auto getRequiredBoundingBox = [&](ModelExtentsSummary const& models)
     {
-        const auto modelId = renderer.first;
-        const auto model = m_objectTrackerPtr->GetObjectModel(modelId);
-        const auto modelBounds = GetObjectModelBoundingBox(model);
+        const float requiredScale = models.MaxModelExtent > 0.0f ? models.MaxModelDiagonal * c_relaxScale / models.MaxModelExtent : 1.0f;
 
-        requiredMaxExtents.x = (std::max)(requiredMaxExtents.x, modelBounds.Extents.x);
-        requiredMaxExtents.y = (std::max)(requiredMaxExtents.y, modelBounds.Extents.y);
-        requiredMaxExtents.z = (std::max)(requiredMaxExtents.z, modelBounds.Extents.z);
+        SpatialOrientedBox requiredBoundingBox = boundingBox;
+        requiredBoundingBox.Extents.x = models.MaxExtents.x * requiredScale * 2.0f;
+        requiredBoundingBox.Extents.y = models.MaxExtents.y * requiredScale * 2.0f;
+        requiredBoundingBox.Extents.z = models.MaxExtents.z * requiredScale * 2.0f;
 
-        const float maxExtent = (std::max)((std::max)(modelBounds.Extents.x, modelBounds.Extents.y), modelBounds.Extents.z);
+        return requiredBoundingBox;
+    };
 
-        if (maxExtent > maxModelExtent)
-        {
-            const float diagonalExtent = XMVectorGetX(XMVector3Length(XMLoadFloat3(&modelBounds.Extents)));
-            const float requiredMaxExtent = diagonalExtent * c_relaxScale;
+    const auto getRequiredFieldOfView = [&](ModelExtentsSummary const& models)
+    {
+        const float horizontalFov = 2.0f * atanf(models.MaxModelExtent / c_observationDistance);
+        const float aspectRatio = 1.0f;
 
-            requiredScale = requiredMaxExtent / maxExtent;
-            maxModelExtent = maxExtent;
-        }
-    }
+        SpatialFieldOfView requiredFieldOfView = fieldOfView;
+        requiredFieldOfView.HorizontalFieldOfViewInDegrees = (std::min)((std::max)(horizontalFov * 180.0f / 3.1415926f, c_minHorizontalFov), c_maxHorizontalFov);
+        requiredFieldOfView.AspectRatio = aspectRatio;
+        requiredFieldOfView.FarDistance = c_observationDistance + models.MaxModelExtent * 1.5f;
+
+        return requiredFieldOfView;
+    };
+
+    // Find maximum bounding box and field of view large enough to cover all objects.
+    auto modelExtents = m_objectTrackerPtr->GetModelExtentsSummary();
 
-    if (m_objectRenderers.empty())
+    if (modelExtents.ModelCount == 0)
     {
-        requiredMaxExtents.x = requiredMaxExtents.y = requiredMaxExtents.z = 2.0f;
+        modelExtents.MaxExtents.x = modelExtents.MaxExtents.y = modelExtents.MaxExtents.z = 2.0f;
     }
 
-    // Bounding volume's vertices and indices, for rendering.
-    std::vector<XMFLOAT3> boundingVolumeVertices;
-    std::vector<uint32_t> boundingVolumeVertexIndices;
+    // Bounding volume's unit mesh and its transform, for rendering.
+    std::optional<LineMesh> boundingVolumeMesh;
+    float4x4 boundingVolumeTransform = float4x4::identity();
     XMFLOAT4 boundingVolumeColor = c_White;
 
     ObjectSearchArea searchArea{ nullptr };
 
+    // Models of similar size share an area sized for them, so that small models aren't searched in an
+    // area sized for the largest one. Only the area covering all models is rendered.
+    std::map<ModelExtentsIndex::SizeClass, ObjectSearchArea> sizeClassSearchAreas;
+    const auto sizeClassSummaries = m_objectTrackerPtr->GetModelSizeClassSummaries();
+
     if (requiredBoundingVolumeKind == ObjectTrackingBoundingVolumeKind::OrientedBox)
     {
-        boundingBox.Extents.x = requiredMaxExtents.x * requiredScale * 2.0f;
-        boundingBox.Extents.y = requiredMaxExtents.y * requiredScale * 2.0f;
-        boundingBox.Extents.z = requiredMaxExtents.z * requiredScale * 2.0f;
+        boundingBox = getRequiredBoundingBox(modelExtents);
 
         boundingVolumeColor = c_White;
-        GetBoundingBoxVerticesAndIndices(boundingBox, boundingVolumeVertices, boundingVolumeVertexIndices);
+        boundingVolumeMesh = GetUnitBoxLineMesh();
+        boundingVolumeTransform = GetUnitBoxTransform(boundingBox);
 
         searchArea = ObjectSearchArea::FromOrientedBox(coordinateSystem, boundingBox);
+
+        if (sizeClassSummaries.size() > 1)
+        {
+            for (auto const& [sizeClass, models] : sizeClassSummaries)
+            {
+                sizeClassSearchAreas.emplace(sizeClass, ObjectSearchArea::FromOrientedBox(coordinateSystem, getRequiredBoundingBox(models)));
+            }
+        }
     }
     else if (requiredBoundingVolumeKind == ObjectTrackingBoundingVolumeKind::FieldOfView)
     {
-        const float horizontalFov = 2.0f * atanf(maxModelExtent / c_observationDistance);
-        const float aspectRatio = 1.0f;
-
-        fieldOfView.HorizontalFieldOfViewInDegrees = (std::min)((std::max)(horizontalFov * 180.0f / 3.1415926f, c_minHorizontalFov), c_maxHorizontalFov);
-        fieldOfView.AspectRatio = aspectRatio;
-        fieldOfView.FarDistance = c_observationDistance + maxModelExtent * 1.5f;
+        fieldOfView = getRequiredFieldOfView(modelExtents);
 
         boundingVolumeColor = c_White;
-        GetFieldOfViewVerticesAndIndices(fieldOfView, boundingVolumeVertices, boundingVolumeVertexIndices);
+        boundingVolumeMesh = GetUnitFieldOfViewLineMesh();
+        boundingVolumeTransform = GetUnitFieldOfViewTransform(fieldOfView);
 
         searchArea = ObjectSearchArea::FromFieldOfView(coordinateSystem, fieldOfView);
+
+        if (sizeClassSummaries.size() > 1)
+        {
+            for (auto const& [sizeClass, models] : sizeClassSummaries)
+            {
+                sizeClassSearchAreas.emplace(sizeClass, ObjectSearchArea::FromFieldOfView(coordinateSystem, getRequiredFieldOfView(models)));
+            }
+        }
     }
     else if (requiredBoundingVolumeKind == ObjectTrackingBoundingVolumeKind::Sphere)
     {
+        // The sphere has a fixed size, so all models share it.
         boundingVolumeColor = c_White;
-        GetSphereVerticesAndIndices(sphere, 15, true, boundingVolumeVertices, boundingVolumeVertexIndices);
+        boundingVolumeMesh = GetUnitSphereLineMesh<15>();
+        boundingVolumeTransform = GetUnitSphereTransform(sphere);
 
         searchArea = ObjectSearchArea::FromSphere(coordinateSystem, sphere);
     }
 
-    m_boundsRenderer->SetVerticesAndIndices(
-        boundingVolumeVertices.data(),
-        static_cast<uint32_t>(boundingVolumeVertices.size()),
-        boundingVolumeVertexIndices.data(),
-        static_cast<uint32_t>(boundingVolumeVertexIndices.size()),
-        D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+    if (boundingVolumeMesh)
+    {
+        m_boundsRenderer->SetLineMesh(*boundingVolumeMesh);
+        m_boundsRenderer->SetTransform(boundingVolumeTransform);
+    }
 
     m_boundsRenderer->SetColor(boundingVolumeColor);
-    m_boundsRenderer->SetActive(!boundingVolumeVertices.empty() && !boundingVolumeVertexIndices.empty());
+    m_boundsRenderer->SetActive(boundingVolumeMesh.has_value());
+
+    m_lastSearchArea = searchArea;
+    co_await m_objectTrackerPtr->DetectAsync(frameOfReference, searchArea, std::move(sizeClassSearchAreas));
+}
+
+void AoaSampleAppMain::UpdatePlannedSearchArea()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    if (!m_searchAreaProposal.valid())
+    {
+        if (now - m_manualSearchAreaTime < c_ManualSearchAreaHoldTime ||
+            now - m_plannedSearchAreaTime < c_PlannedSearchAreaDwellTime)
+        {
+            return;
+        }
+
+        const auto headPose = m_headPosePredictor.Predict(c_SearchAreaPredictionTime);
+        if (!headPose)
+        {
+            return;
+        }
+
+        // Scoring the candidate areas sweeps the coverage map for each of them, which takes longer than a frame.
+        // The planner is only used by this task until its proposal is taken.
+        m_searchAreaProposal = std::async(std::launch::async,
+            [this, headPose = *headPose, searchedArea = m_plannedSearchArea, models = m_objectTrackerPtr->GetModelExtentsSummary(), priorLocations = GetPriorLocations(), now]()
+        {
+            if (m_searchCoverageStale.exchange(false))
+            {
+                m_searchAreaPlanner.ResetCoverage();
+            }
+
+            if (searchedArea)
+            {
+                m_searchAreaPlanner.MarkSearched(*searchedArea, now);
+            }
+
+            return m_searchAreaPlanner.Propose(headPose, models, priorLocations, now);
+        });
+
+        return;
+    }
+
+    if (m_searchAreaProposal.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+    {
+        return;
+    }
+
+    const auto previousArea = m_plannedSearchArea;
+    m_plannedSearchArea = m_searchAreaProposal.get();
+    m_plannedSearchAreaTime = now;
+
+    // The user placed an area while the planner was proposing.
+    if (now - m_manualSearchAreaTime < c_ManualSearchAreaHoldTime)
+    {
+        m_plannedSearchArea.reset();
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_sightingsMutex);
+        m_lastPlannedSearchArea = m_plannedSearchArea;
+    }
+
+    if (!m_plannedSearchArea)
+    {
+        return;
+    }
+
+    auto frameOfReference = Preview::SpatialGraphInteropPreview::TryCreateFrameOfReference(m_stationaryReferenceFrame.CoordinateSystem());
+    SpatialGraphCoordinateSystem coordinateSystem;
+    coordinateSystem.NodeId = frameOfReference.NodeId();
+    coordinateSystem.CoordinateSystemToNodeTransform = frameOfReference.CoordinateSystemToNodeTransform();
+
+    const SpatialOrientedBox boundingBox = ToSpatialOrientedBox(*m_plannedSearchArea);
 
+    // The tracker measures detection latency from when an area is first searched, so an area proposed again
+    // is passed as the same object.
+    const bool sameArea = previousArea && m_lastSearchArea == m_plannedObjectSearchArea && IsSameArea(*previousArea, *m_plannedSearchArea);
+
+    const auto searchArea = sameArea ? m_plannedObjectSearchArea : ObjectSearchArea::FromOrientedBox(coordinateSystem, boundingBox);
+
+    m_plannedObjectSearchArea = searchArea;
     m_lastSearchArea = searchArea;
-    co_await m_objectTrackerPtr->DetectAsync(frameOfReference, searchArea);
+    m_objectTrackerPtr->SetSearchArea(frameOfReference, searchArea);
+
+#ifdef DRAW_SAMPLE_CONTENT
+    m_boundsRenderer->SetLineMesh(GetUnitBoxLineMesh());
+    m_boundsRenderer->SetTransform(GetUnitBoxTransform(boundingBox));
+
+    // Planned areas are drawn in cyan, areas placed by air-tap in white.
+    m_boundsRenderer->SetColor(c_Cyan);
+    m_boundsRenderer->SetActive(true);
+#endif
+}
+
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::LoadSceneLayoutAsync()
+{
+    auto item = co_await ApplicationData::Current().LocalFolder().TryGetItemAsync(c_SceneLayoutFilename);
+    if (!item || !item.IsOfType(StorageItemTypes::File))
+    {
+        co_return;
+    }
+
+    try
+    {
+        auto json = co_await FileIO::ReadTextAsync(item.as<StorageFile>());
+        m_objectTrackerPtr->SetSceneLayout(ParseSceneLayout(json));
+    }
+    catch (...)
+    {
+        // Models are searched independently without a valid layout.
+        OutputDebugStringW(L"Ignoring malformed scene layout\n");
+    }
+}
+
+winrt::Windows::Foundation::IAsyncAction AoaSampleAppMain::LoadSightingsAsync()
+{
+    if (!m_stationaryReferenceFrame)
+    {
+        co_return;
+    }
+
+    const auto indexPath = PathJoin(ApplicationData::Current().LocalCacheFolder().Path(), c_SightingIndexFilename);
+    const auto warmStartPath = PathJoin(ApplicationData::Current().LocalCacheFolder().Path(), c_WarmStartFilename);
+
+    // Locations are only meaningful relative to the anchor they were recorded with, so start over with
+    // a new anchor if it's missing. The index and the warm start state are saved separately, and either may be
+    // missing with the anchor present, e.g. the index when no model was seen in the last session.
+    auto store = co_await SpatialAnchorManager::RequestStoreAsync();
+    auto savedAnchors = store.GetAllSavedAnchors();
+
+    SpatialAnchor anchor{ nullptr };
+
+    std::lock_guard lock(m_sightingsMutex);
+
+    if (savedAnchors.HasKey(c_SightingAnchorName))
+    {
+        anchor = savedAnchors.Lookup(c_SightingAnchorName);
+
+        // A missing index starts empty.
+        m_sightingIndex.Load(indexPath);
+
+        // Restore the tracking mode before models are loaded, so that their renderers get the matching color.
+        m_warmStartState = WarmStartState::Load(warmStartPath);
+        if (m_warmStartState)
+        {
+            m_objectTrackerPtr->SetInstanceTrackingMode(m_warmStartState->TrackingMode);
+        }
+    }
+    else
+    {
+        anchor = SpatialAnchor::TryCreateRelativeTo(m_stationaryReferenceFrame.CoordinateSystem());
+        if (!anchor)
+        {
+            co_return;
+        }
+
+        store.Remove(c_SightingAnchorName);
+        if (!store.TrySave(c_SightingAnchorName, anchor))
+        {
+            co_return;
+        }
+
+        m_sightingIndex.Clear();
+    }
+
+    m_sightingIndexPath = indexPath;
+    m_warmStartPath = warmStartPath;
+    m_sightingAnchor = anchor;
+}
+
+void AoaSampleAppMain::RestoreWarmStart()
+{
+    std::optional<WarmStartState> state;
+    float4x4 anchorToFrameOfReference;
+    {
+        std::lock_guard lock(m_sightingsMutex);
+
+        if (!m_warmStartReady || !m_warmStartState || !m_stationaryReferenceFrame)
+        {
+            return;
+        }
+
+        // Wait until the anchor is located, e.g. until the device recognizes the space.
+        const auto anchorTransform = m_sightingAnchor.CoordinateSystem().TryGetTransformTo(m_stationaryReferenceFrame.CoordinateSystem());
+        if (!anchorTransform)
+        {
+            return;
+        }
+
+        anchorToFrameOfReference = anchorTransform.Value();
+        state = std::move(m_warmStartState);
+        m_warmStartState.reset();
+    }
+
+    auto frameOfReference = Preview::SpatialGraphInteropPreview::TryCreateFrameOfReference(m_stationaryReferenceFrame.CoordinateSystem());
+    if (!frameOfReference)
+    {
+        return;
+    }
+
+    const quaternion anchorToFrameOfReferenceRotation = make_quaternion_from_rotation_matrix(anchorToFrameOfReference);
+
+    for (auto const& placement : state->Placements)
+    {
+        m_objectTrackerPtr->SearchAtExpectedPose(
+            placement.ModelId,
+            frameOfReference,
+            transform(placement.Position, anchorToFrameOfReference),
+            concatenate(placement.Orientation, anchorToFrameOfReferenceRotation),
+            c_WarmStartTolerance);
+    }
+
+    if (state->SearchArea)
+    {
+        // Resume planning from the last planned area.
+        SearchAreaProposal area = *state->SearchArea;
+        area.Center = ToXMFloat3(transform(ToFloat3(area.Center), anchorToFrameOfReference));
+        area.Orientation = ToXMFloat4(concatenate(ToQuaternion(area.Orientation), anchorToFrameOfReferenceRotation));
+
+        SpatialGraphCoordinateSystem coordinateSystem;
+        coordinateSystem.NodeId = frameOfReference.NodeId();
+        coordinateSystem.CoordinateSystemToNodeTransform = frameOfReference.CoordinateSystemToNodeTransform();
+
+        const SpatialOrientedBox boundingBox = ToSpatialOrientedBox(area);
+
+        m_plannedSearchArea = area;
+        m_plannedSearchAreaTime = std::chrono::steady_clock::now();
+        m_objectTrackerPtr->SetSearchArea(frameOfReference, ObjectSearchArea::FromOrientedBox(coordinateSystem, boundingBox));
+    }
+
+    m_warmStarted = true;
+    m_startupTrace.Mark("WarmStart");
+}
+
+void AoaSampleAppMain::SaveWarmStart()
+{
+    // Called with the sightings lock held.
+    if (!m_sightingAnchor || !m_stationaryReferenceFrame || m_warmStartPath.empty())
+    {
+        return;
+    }
+
+    const auto frameOfReferenceToAnchor = m_stationaryReferenceFrame.CoordinateSystem().TryGetTransformTo(m_sightingAnchor.CoordinateSystem());
+    if (!frameOfReferenceToAnchor)
+    {
+        return;
+    }
+
+    const quaternion frameOfReferenceToAnchorRotation = make_quaternion_from_rotation_matrix(frameOfReferenceToAnchor.Value());
+
+    WarmStartState state;
+    state.TrackingMode = m_objectTrackerPtr->GetInstanceTrackingMode();
+
+    for (auto const& [modelId, pose] : m_lastModelPoses)
+    {
+        state.Placements.push_back({
+            modelId,
+            transform(pose.Position, frameOfReferenceToAnchor.Value()),
+            concatenate(pose.Orientation, frameOfReferenceToAnchorRotation)
+        });
+    }
+
+    if (m_lastPlannedSearchArea)
+    {
+        state.SearchArea = m_lastPlannedSearchArea;
+        state.SearchArea->Center = ToXMFloat3(transform(ToFloat3(state.SearchArea->Center), frameOfReferenceToAnchor.Value()));
+        state.SearchArea->Orientation = ToXMFloat4(concatenate(ToQuaternion(state.SearchArea->Orientation), frameOfReferenceToAnchorRotation));
+    }
+
+    state.Save(m_warmStartPath);
+}
+
+void AoaSampleAppMain::AddSightings(std::vector<std::pair<winrt::guid, SpatialPose>> const& detections)
+{
+    std::lock_guard lock(m_sightingsMutex);
+
+    if (!m_sightingAnchor)
+    {
+        return;
+    }
+
+    // The anchor may not be located yet, e.g. until the device recognizes the space it was created in.
+    const auto frameOfReferenceToAnchor = m_stationaryReferenceFrame.CoordinateSystem().TryGetTransformTo(m_sightingAnchor.CoordinateSystem());
+    if (!frameOfReferenceToAnchor)
+    {
+        return;
+    }
+
+    for (auto const& [modelId, pose] : detections)
+    {
+        m_sightingIndex.Add(modelId, ToXMFloat3(transform(pose.Position, frameOfReferenceToAnchor.Value())));
+    }
+}
+
+std::vector<DirectX::XMFLOAT3> AoaSampleAppMain::GetPriorLocations()
+{
+    std::vector<winrt::guid> modelIds;
+    for (auto const& model : m_objectTrackerPtr->GetObjectModels())
+    {
+        modelIds.emplace_back(model.Id());
+    }
+
+    std::lock_guard lock(m_sightingsMutex);
+
+    std::vector<DirectX::XMFLOAT3> locations;
+
+    if (!m_sightingAnchor)
+    {
+        return locations;
+    }
+
+    const auto anchorToFrameOfReference = m_sightingAnchor.CoordinateSystem().TryGetTransformTo(m_stationaryReferenceFrame.CoordinateSystem());
+    if (!anchorToFrameOfReference)
+    {
+        return locations;
+    }
+
+    // Models being tracked don't need to be searched.
+    modelIds.erase(std::remove_if(modelIds.begin(), modelIds.end(), [this](auto const& modelId)
+    {
+        return m_trackedModelIds.count(modelId) > 0;
+    }), modelIds.end());
+
+    for (auto const& priorLocation : m_sightingIndex.GetPriorLocations(modelIds, c_MaxPriorLocations))
+    {
+        locations.emplace_back(ToXMFloat3(transform(ToFloat3(priorLocation.Position), anchorToFrameOfReference.Value())));
+    }
+
+    return locations;
 }
 
 // Updates the application state once per frame.
@@ -546,6 +1635,11 @@ HolographicFrame AoaSampleAppMain::Update(HolographicFrame const& previousFrame)
         m_initializeOperation = InitializeAsync();
     }
 
+#ifdef DRAW_SAMPLE_CONTENT
+    // Create or release renderers of object models loaded or removed since the last frame.
+    ApplyPendingRendererChanges();
+#endif
+
     // TODO: Put CPU work that does not depend on the HolographicCameraPose here.
 
     // Apps should wait for the optimal time to begin pose-dependent work.
@@ -599,6 +1693,14 @@ HolographicFrame AoaSampleAppMain::Update(HolographicFrame const& previousFrame)
 #ifdef DRAW_SAMPLE_CONTENT
     if (m_stationaryReferenceFrame && m_objectTrackerPtr)
     {
+        // Follow head motion, to place search areas where the user will be looking.
+        const SpatialPointerPose gazePose = SpatialPointerPose::TryGetAtTimestamp(m_stationaryReferenceFrame.CoordinateSystem(), prediction.Timestamp());
+        if (gazePose)
+        {
+            const auto head = gazePose.Head();
+            m_headPosePredictor.AddHeadPose(ToXMFloat3(head.Position()), ToXMFloat3(head.ForwardDirection()), ToXMFloat3(head.UpDirection()), std::chrono::steady_clock::now());
+        }
+
         SpatialInteractionSourceState pointerState = m_spatialInputHandler->CheckForInput();
 
         if (pointerState != nullptr && pointerState.Source().Kind() == SpatialInteractionSourceKind::Hand)
@@ -622,7 +1724,11 @@ HolographicFrame AoaSampleAppMain::Update(HolographicFrame const& previousFrame)
                     if (pointerState.Source().Handedness() == SpatialInteractionSourceHandedness::Right)
                     {
                         // Update search area by air-tap with right hand.
-                        m_searchAreaOperation = UpdateObjectSearchArea(pose.Head());
+                        m_manualSearchAreaTime = std::chrono::steady_clock::now();
+                        m_plannedSearchArea.reset();
+                        const auto head = pose.Head();
+                        m_searchAreaOperation = UpdateObjectSearchArea(
+                            m_headPosePredictor.Predict(c_SearchAreaPredictionTime).value_or(PredictedHeadPose{ ToXMFloat3(head.Position()), ToXMFloat3(head.ForwardDirection()), ToXMFloat3(head.UpDirection()) }));
                     }
                     else if (pointerState.Source().Handedness() == SpatialInteractionSourceHandedness::Left)
                     {
@@ -654,8 +1760,76 @@ HolographicFrame AoaSampleAppMain::Update(HolographicFrame const& previousFrame)
             }
         }
 
+        // Search where models were in the previous session, once their location is known.
+        RestoreWarmStart();
+
+        // Search around the user without input.
+        UpdatePlannedSearchArea();
+
         // Get currently detected objects.
         trackedObjects = m_objectTrackerPtr->GetTrackedObjects(m_stationaryReferenceFrame.CoordinateSystem());
+        m_gazedModel.reset();
+
+        if (const SpatialLocation viewLocation = m_spatialLocator.TryLocateAtTimestamp(prediction.Timestamp(), m_stationaryReferenceFrame.CoordinateSystem()))
+        {
+            // Models detected since the last frame, and all tracked models, with the pose of their origin.
+            std::vector<std::pair<winrt::guid, SpatialPose>> detections;
+            std::vector<std::pair<winrt::guid, SpatialPose>> modelPoses;
+            std::unordered_set<winrt::guid> trackedModelIds;
+            {
+                std::lock_guard lock(m_sightingsMutex);
+
+                for (auto const& trackedObject : trackedObjects)
+                {
+                    const SpatialPose pose = trackedObject.ComputeOriginForView({ viewLocation.Position(), viewLocation.Orientation() }, trackedObject.CoordinateSystemToPlacement);
+
+                    modelPoses.emplace_back(trackedObject.ModelId, pose);
+                    trackedModelIds.insert(trackedObject.ModelId);
+                    m_lastModelPoses.insert_or_assign(trackedObject.ModelId, pose);
+
+                    if (m_trackedModelIds.count(trackedObject.ModelId) == 0)
+                    {
+                        detections.emplace_back(trackedObject.ModelId, pose);
+                    }
+                }
+            }
+
+            m_trackedModelIds = std::move(trackedModelIds);
+
+            // Find the model mesh the user is looking at, to highlight it and stabilize the image on it.
+            if (gazePose && !modelPoses.empty())
+            {
+                const auto head = gazePose.Head();
+                m_gazedModel = PickTrackedObject(head.Position(), head.ForwardDirection(), modelPoses);
+            }
+
+            if (!detections.empty())
+            {
+                AddSightings(detections);
+
+                // Models arranged with the detected ones are searched where the scene layout expects them.
+                if (auto frameOfReference = Preview::SpatialGraphInteropPreview::TryCreateFrameOfReference(m_stationaryReferenceFrame.CoordinateSystem()))
+                {
+                    for (auto const& [modelId, pose] : detections)
+                    {
+                        m_objectTrackerPtr->SearchNeighbors(modelId, frameOfReference, pose.Position, pose.Orientation);
+                    }
+                }
+            }
+        }
+
+        if (!trackedObjects.empty() && !m_firstDetectionTraced)
+        {
+            // Rewrite the startup trace off the rendering thread to include the time to first detection.
+            m_firstDetectionTraced = true;
+            m_startupTrace.Mark(m_warmStarted ? "FirstDetection (warm start)" : "FirstDetection (cold start)");
+
+            create_task([this]()
+            {
+                m_startupTrace.WriteChromeTrace(m_startupTracePath);
+                OutputDebugStringA(m_startupTrace.Summarize().c_str());
+            });
+        }
     }
 
 #endif
@@ -689,12 +1863,19 @@ HolographicFrame AoaSampleAppMain::Update(HolographicFrame const& previousFrame)
                 const SpatialPose modelPose = it->ComputeOriginForView({ viewLocation.Position(), viewLocation.Orientation() }, it->CoordinateSystemToPlacement);
 
                 renderer.second.SetTransform(make_float4x4_from_quaternion(modelPose.Orientation) * make_float4x4_translation(modelPose.Position));
+                renderer.second.SelectLevelOfDetail(distance(modelPose.Position, viewLocation.Position()));
+                renderer.second.BoundingBoxRenderer->SetColor(m_gazedModel && m_gazedModel->ModelId == renderer.first ? c_White : c_Magenta);
                 renderer.second.SetActive(true);
             }
         }
 #endif
     });
 
+    if (m_objectTrackerPtr && m_timer.GetFrameCount() > 1 && m_timer.GetElapsedSeconds() > c_FrameHitchSeconds)
+    {
+        m_objectTrackerPtr->RequestDiagnosticsFlush("FrameHitch");
+    }
+
     // On HoloLens 2, the platform can achieve better image stabilization results if it has
     // a stabilization plane and a depth buffer.
     // Note that the SetFocusPoint API includes an override which takes velocity as a
@@ -710,10 +1891,15 @@ HolographicFrame AoaSampleAppMain::Update(HolographicFrame const& previousFrame)
         // prioritize for image stabilization. The focus point is set independently
         // for each holographic camera. When setting the focus point, put it on or
         // near content that the user is looking at.
-        // In this example, we put the focus point at the center of the sample hologram.
+        // In this example, we put the focus point where the user is looking at a model
+        // mesh, or else at the center of the first tracked model.
         // You can also set the relative velocity and facing of the stabilization
         // plane using overloads of this method.
-        if (m_stationaryReferenceFrame != nullptr)
+        if (m_stationaryReferenceFrame != nullptr && m_gazedModel)
+        {
+            renderingParameters.SetFocusPoint(m_stationaryReferenceFrame.CoordinateSystem(), m_gazedModel->Point);
+        }
+        else if (m_stationaryReferenceFrame != nullptr)
         {
             auto it = std::find_if(m_objectRenderers.cbegin(), m_objectRenderers.cend(), [](auto const& renderer)
             {
@@ -829,7 +2015,7 @@ bool AoaSampleAppMain::Render(HolographicFrame const& holographicFrame)
                 // Draw object bounding box.
                 for (auto& renderer : m_objectRenderers)
                 {
-                    renderer.second.Render();
+                    renderer.second.Render(pCameraResources->GetViewProjection());
                 }
 
                 if (m_canCommitDirect3D11DepthBuffer)
@@ -857,7 +2043,19 @@ bool AoaSampleAppMain::Render(HolographicFrame const& holographicFrame)
 
 void AoaSampleAppMain::SaveAppState()
 {
+    // Only closes the last diagnostics segment; it's uploaded in the background or after the next launch.
     StopAndUploadDiagnosticsAsync().get();
+
+    std::lock_guard lock(m_sightingsMutex);
+    if (!m_sightingIndexPath.empty())
+    {
+        m_sightingIndex.SaveIfChanged(m_sightingIndexPath);
+    }
+
+    if (m_objectTrackerPtr)
+    {
+        SaveWarmStart();
+    }
 }
 
 void AoaSampleAppMain::LoadAppState()
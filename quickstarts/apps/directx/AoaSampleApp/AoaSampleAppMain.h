@@ -13,10 +13,24 @@
 #define DRAW_SAMPLE_CONTENT
 
 #include "Common/DeviceResources.h"
+#include "Common/HeadPosePredictor.h"
+#include "Common/ModelCatalog.h"
+#include "Common/SearchAreaPlanner.h"
+#include "Common/SightingIndex.h"
+#include "Common/StartupTrace.h"
 #include "Common/StepTimer.h"
+#include "Common/WarmStartState.h"
 #include "Common/ObjectTracker.h"
 
+#include <winrt/Windows.Storage.Search.h>
+
+#include <atomic>
+#include <future>
+#include <optional>
+#include <unordered_set>
+
 #ifdef DRAW_SAMPLE_CONTENT
+#include "Common/MeshBvh.h"
 #include "Content/PrimitiveRenderer.h"
 #include "Content/SpatialInputHandler.h"
 #endif
@@ -74,14 +88,82 @@ namespace AoaSampleApp
 
         winrt::Windows::Foundation::IAsyncAction InitializeAsync();
 
-        // Load OU object models from application's local storage.
-        winrt::Windows::Foundation::IAsyncAction LoadObjectModelAsync(winrt::Windows::Storage::StorageFolder const& rootFolder);
+        // Watch a folder of application's storage for OU object models.
+        winrt::Windows::Foundation::IAsyncAction AddModelFolderAsync(winrt::Windows::Storage::StorageFolder const& rootFolder);
+
+        // Load, replace or release object models to match the current content of the model folders.
+        // Startup traces the synchronization under the given parent span.
+        winrt::Windows::Foundation::IAsyncAction SyncObjectModelsAsync(StartupTrace::SpanId parentSpan = StartupTrace::c_noSpan);
+
+        // Load an OU object model read from a file and queue its renderer for creation.
+        winrt::Windows::Foundation::IAsyncOperation<winrt::guid> LoadObjectModelAsync(std::vector<uint8_t> const& data);
+
+        // Release the object model loaded from a file unless another file provides the same model.
+        void ReleaseModelFile(std::wstring const& path);
+
+        // Used to notify the app when files in a model folder are added, changed or removed.
+        void OnModelFolderContentsChanged(
+            winrt::Windows::Storage::Search::IStorageQueryResultBase const& sender,
+            winrt::Windows::Foundation::IInspectable const& args);
+
+        // Synchronize object models once a batch of model folder changes has settled.
+        winrt::Windows::Foundation::IAsyncAction SyncObjectModelsAfterChangesAsync();
+
+#ifdef DRAW_SAMPLE_CONTENT
+        // Create and release object renderers on the rendering thread.
+        void ApplyPendingRendererChanges();
+
+        // Build levels of detail, meshlets, edges and the picking hierarchy of a model mesh, or downsampled previews of a point cloud, in the background and queue them for its renderer.
+        winrt::Windows::Foundation::IAsyncAction BuildMeshLevelsOfDetailAsync(winrt::guid id, std::vector<DirectX::XMFLOAT3> vertices, std::vector<uint32_t> indices, D3D11_PRIMITIVE_TOPOLOGY topology);
+
+        // Track the builds above, which use this object, so that the destructor can stop them and wait for them to end.
+        bool TryBeginMeshBuild();
+        void EndMeshBuild();
+        bool IsMeshBuildStopped();
+        void StopMeshBuilds();
+
+        // A model mesh hit by a ray, and where, in the stationary frame.
+        struct ModelHit
+        {
+            winrt::guid ModelId;
+            winrt::Windows::Foundation::Numerics::float3 Point;
+            float Distance;
+        };
+
+        // Nearest model mesh hit by a ray in the stationary frame, among models at the given poses of their origin.
+        std::optional<ModelHit> PickTrackedObject(
+            winrt::Windows::Foundation::Numerics::float3 const& origin,
+            winrt::Windows::Foundation::Numerics::float3 const& direction,
+            std::vector<std::pair<winrt::guid, winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialPose>> const& modelPoses);
+#endif
 
         // Check diagnostics flag and turn on diagnostics if required.
         winrt::Windows::Foundation::IAsyncAction TurnonDiagnosticsIfRequiredAsync();
 
         // Update object location hint based on current head pose.
-        winrt::Windows::Foundation::IAsyncAction UpdateObjectSearchArea(winrt::Windows::Perception::People::HeadPose const& headPose);
+        winrt::Windows::Foundation::IAsyncAction UpdateObjectSearchArea(PredictedHeadPose headPose);
+
+        // Move the search area to the next area proposed by the planner, unless the user recently placed one.
+        // Areas are proposed in the background and applied on the first update after they're ready.
+        void UpdatePlannedSearchArea();
+
+        // Load the relative poses of models arranged together, if the application local folder provides them.
+        winrt::Windows::Foundation::IAsyncAction LoadSceneLayoutAsync();
+
+        // Load the locations where models were seen in previous sessions, relative to a persisted anchor.
+        winrt::Windows::Foundation::IAsyncAction LoadSightingsAsync();
+
+        // Search where models were tracked in the previous session, once models are loaded and the anchor is located.
+        void RestoreWarmStart();
+
+        // Save where models were last tracked, the tracking mode and the last planned search area for the next session.
+        void SaveWarmStart();
+
+        // Record the location of models detected since the last frame, given the pose of their origin.
+        void AddSightings(std::vector<std::pair<winrt::guid, winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialPose>> const& detections);
+
+        // Locations where models not tracked at the moment were seen before, most sighted first, in the stationary frame.
+        std::vector<DirectX::XMFLOAT3> GetPriorLocations();
 
         // Stop diagnostics capture and upload to Object Anchors service if a subscription account is provided.
         winrt::Windows::Foundation::IAsyncAction StopAndUploadDiagnosticsAsync();
@@ -99,14 +181,68 @@ namespace AoaSampleApp
             void SetActive(bool flag);
             void SetTransform(winrt::Windows::Foundation::Numerics::float4x4 const& frameOfReferenceFromObject);
 
+            // Draw the mesh in less detail the farther it is from the user, relative to the model size.
+            void SelectLevelOfDetail(float distance);
+
+            // Half diagonal of the model's bounding box.
+            float BoundingRadius{ 0.0f };
+
             void CreateDeviceDependentResources();
             void ReleaseDeviceDependentResources();
-            void Render();
+
+            // Draw for one camera, culling the mesh to its view.
+            void Render(ViewProjectionConstantBuffer const& viewProjection);
 
             winrt::Windows::Foundation::Numerics::float3 GetPosition() const;
         };
 
         std::unordered_map<winrt::guid, ObjectRenderer>             m_objectRenderers;
+
+        // Geometry of an object model, prepared off the rendering thread.
+        struct ObjectGeometry
+        {
+            std::vector<DirectX::XMFLOAT3> BoundingBoxVertices;
+            std::vector<uint32_t> BoundingBoxIndices;
+            std::vector<DirectX::XMFLOAT3> MeshVertices;
+            std::vector<uint32_t> MeshIndices;
+            D3D11_PRIMITIVE_TOPOLOGY MeshTopology{ D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED };
+            float BoundingRadius{ 0.0f };
+        };
+
+        // Mesh indices extended with levels of detail and split into meshlets, replacing the ones a renderer was created with.
+        // Triangle meshes come back as line lists of their edges.
+        struct MeshLevelsOfDetail
+        {
+            std::vector<DirectX::XMFLOAT3> Vertices;
+            std::vector<uint32_t> Indices;
+            std::vector<MeshLevelOfDetail> Levels;
+            std::vector<Meshlet> Meshlets;
+            D3D11_PRIMITIVE_TOPOLOGY Topology{ D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED };
+        };
+
+        // Renderers to create (with geometry) or release (without geometry), in order of the model changes.
+        std::mutex                                                  m_pendingRendererChangesMutex;
+        std::vector<std::pair<winrt::guid, std::optional<ObjectGeometry>>> m_pendingRendererChanges;
+        std::vector<std::pair<winrt::guid, MeshLevelsOfDetail>>     m_pendingMeshLevelsOfDetail;
+
+        // Hierarchies to pick model meshes with rays, built in the background, with object model id as the key.
+        // Point clouds have no triangles to pick.
+        std::mutex                                                  m_modelBvhsMutex;
+        std::unordered_map<winrt::guid, std::shared_ptr<MeshBvh const>> m_modelBvhs;
+
+        // Models loaded and not yet released, guarded by the same mutex, so that a hierarchy finished after its model
+        // was released is dropped.
+        std::unordered_set<winrt::guid>                             m_loadedModelIds;
+
+        // Levels of detail being built in the background.
+        std::mutex                                                  m_meshBuildsMutex;
+        uint32_t                                                    m_meshBuildCount{ 0 };
+        bool                                                        m_meshBuildsStopped{ false };
+        winrt::handle                                               m_meshBuildsEnded{ ::CreateEvent(nullptr, true, true, nullptr) };  // manual reset event
+
+        // Model mesh the user is looking at.
+        std::optional<ModelHit>                                     m_gazedModel;
+
         std::unique_ptr<PrimitiveRenderer>                          m_boundsRenderer;
 
         // Listens for the Pressed spatial input event.
@@ -150,6 +286,67 @@ namespace AoaSampleApp
         // Object tracker.
         std::unique_ptr<ObjectTracker>                              m_objectTrackerPtr;
         winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea    m_lastSearchArea{ nullptr };
+        std::unordered_set<winrt::guid>                             m_trackedModelIds;     // Models tracked at the last frame.
+        bool                                                        m_warmStarted{ false };    // Whether the last session's state was restored.
+
+        // Recent head poses, to place search areas where the user will be looking once they're searched.
+        HeadPosePredictor                                           m_headPosePredictor;
+
+        // Search areas proposed without user input.
+        SearchAreaPlanner                                           m_searchAreaPlanner;
+        std::optional<SearchAreaProposal>                           m_plannedSearchArea;
+        winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea    m_plannedObjectSearchArea{ nullptr };
+        std::chrono::steady_clock::time_point                       m_plannedSearchAreaTime;
+        std::chrono::steady_clock::time_point                       m_manualSearchAreaTime;
+        std::future<std::optional<SearchAreaProposal>>              m_searchAreaProposal;      // Valid while proposing, owns the planner.
+        std::atomic<bool>                                           m_searchCoverageStale{ false };
+
+        // Locations where models were seen and tracker state for the next session, relative to an anchor persisted
+        // across sessions.
+        std::mutex                                                  m_sightingsMutex;
+        SightingIndex                                               m_sightingIndex;
+        std::wstring                                                m_sightingIndexPath;
+        winrt::Windows::Perception::Spatial::SpatialAnchor          m_sightingAnchor{ nullptr };
+        std::unordered_map<winrt::guid, winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialPose> m_lastModelPoses;
+        std::optional<SearchAreaProposal>                           m_lastPlannedSearchArea;
+        std::wstring                                                m_warmStartPath;
+        std::optional<WarmStartState>                               m_warmStartState;      // Restored once ready.
+        bool                                                        m_warmStartReady{ false };
+
+        // Index of the object model files found in the model folders.
+        ModelCatalog                                                m_modelCatalog;
+        std::wstring                                                m_modelCatalogPath;
+
+        // Queries over the model folders, watched for added, changed and removed models.
+        struct ModelFolderQuery
+        {
+            winrt::Windows::Storage::Search::StorageFileQueryResult Query{ nullptr };
+            winrt::Windows::Storage::Search::StorageFileQueryResult::ContentsChanged_revoker ContentsChangedSubscription;
+        };
+
+        std::vector<ModelFolderQuery>                               m_modelFolderQueries;
+
+        // Model files currently loaded, with the path as the key.
+        struct ModelFile
+        {
+            uint64_t Size;
+            int64_t ModifiedTime;
+            winrt::guid ModelId;
+            uint64_t ContentHash;
+        };
+
+        std::unordered_map<std::wstring, ModelFile>                 m_modelFiles;
+
+        // Debouncing state of model folder changes.
+        std::mutex                                                  m_modelFolderChangeMutex;
+        std::chrono::steady_clock::time_point                       m_lastModelFolderChangeTime;
+        bool                                                        m_modelFolderChanged{ false };
+        bool                                                        m_modelSyncRunning{ false };
+
+        // Startup timeline, written to the local cache once initialized and again on the first detection.
+        StartupTrace                                                m_startupTrace;
+        std::wstring                                                m_startupTracePath;
+        bool                                                        m_firstDetectionTraced{ false };
 
         shared_awaitable<winrt::Windows::Foundation::IAsyncAction>  m_initializeOperation{ nullptr };
         shared_awaitable<winrt::Windows::Foundation::IAsyncAction>  m_searchAreaOperation{ nullptr };
@@ -0,0 +1,327 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "BoundingVolumeBatch.h"
+
+using namespace AoaSampleApp;
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Number of elements tested at a time.
+    constexpr size_t c_width = 4;
+
+    // A plane with its normal pointing out of the volume, replicated across lanes. Points p with
+    // dot(Normal, p) <= Distance are on the inner side.
+    struct Plane
+    {
+        XMVECTOR NormalX;
+        XMVECTOR NormalY;
+        XMVECTOR NormalZ;
+        XMVECTOR Distance;
+    };
+
+    Plane MakePlane(FXMVECTOR normal, FXMVECTOR point)
+    {
+        return { XMVectorSplatX(normal), XMVectorSplatY(normal), XMVectorSplatZ(normal), XMVector3Dot(normal, point) };
+    }
+
+    vector<Plane> GetPlanes(BoundingOrientedBox const& box)
+    {
+        const XMVECTOR center = XMLoadFloat3(&box.Center);
+        const XMVECTOR orientation = XMLoadFloat4(&box.Orientation);
+        const XMVECTOR axisX = XMVector3Rotate(g_XMIdentityR0, orientation);
+        const XMVECTOR axisY = XMVector3Rotate(g_XMIdentityR1, orientation);
+        const XMVECTOR axisZ = XMVector3Rotate(g_XMIdentityR2, orientation);
+
+        const XMVECTOR halfX = XMVectorScale(axisX, box.Extents.x);
+        const XMVECTOR halfY = XMVectorScale(axisY, box.Extents.y);
+        const XMVECTOR halfZ = XMVectorScale(axisZ, box.Extents.z);
+
+        return {
+            MakePlane(axisX, XMVectorAdd(center, halfX)),
+            MakePlane(XMVectorNegate(axisX), XMVectorSubtract(center, halfX)),
+            MakePlane(axisY, XMVectorAdd(center, halfY)),
+            MakePlane(XMVectorNegate(axisY), XMVectorSubtract(center, halfY)),
+            MakePlane(axisZ, XMVectorAdd(center, halfZ)),
+            MakePlane(XMVectorNegate(axisZ), XMVectorSubtract(center, halfZ)),
+        };
+    }
+
+    vector<Plane> GetPlanes(BoundingFrustum const& frustum)
+    {
+        // The frustum looks towards +Z, and its side planes go through its origin.
+        const XMVECTOR origin = XMLoadFloat3(&frustum.Origin);
+        const XMVECTOR orientation = XMLoadFloat4(&frustum.Orientation);
+        const XMVECTOR forward = XMVector3Rotate(g_XMIdentityR2, orientation);
+
+        const auto makeSidePlane = [&](float x, float y, float z)
+        {
+            return MakePlane(XMVector3Rotate(XMVector3Normalize(XMVectorSet(x, y, z, 0.0f)), orientation), origin);
+        };
+
+        return {
+            MakePlane(XMVectorNegate(forward), XMVectorMultiplyAdd(forward, XMVectorReplicate(frustum.Near), origin)),
+            MakePlane(forward, XMVectorMultiplyAdd(forward, XMVectorReplicate(frustum.Far), origin)),
+            makeSidePlane(1.0f, 0.0f, -frustum.RightSlope),
+            makeSidePlane(-1.0f, 0.0f, frustum.LeftSlope),
+            makeSidePlane(0.0f, 1.0f, -frustum.TopSlope),
+            makeSidePlane(0.0f, -1.0f, frustum.BottomSlope),
+        };
+    }
+
+    XMVECTOR Load(vector<float> const& values, size_t index)
+    {
+        return XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values.data() + index));
+    }
+
+    // a * b + c * d + e * f
+    XMVECTOR Dot(FXMVECTOR a, FXMVECTOR b, FXMVECTOR c, GXMVECTOR d, HXMVECTOR e, HXMVECTOR f)
+    {
+        return XMVectorMultiplyAdd(e, f, XMVectorMultiplyAdd(c, d, XMVectorMultiply(a, b)));
+    }
+
+    void StoreResults(FXMVECTOR inside, size_t index, size_t size, vector<uint8_t>& results)
+    {
+        uint32_t lanes[c_width];
+        XMStoreInt4(lanes, inside);
+
+        for (size_t lane = 0; lane < c_width && index + lane < size; ++lane)
+        {
+            results[index + lane] = lanes[lane] != 0 ? 1 : 0;
+        }
+    }
+
+    void IntersectPlanes(vector<Plane> const& planes, SphereBatch const& batch, vector<uint8_t>& results)
+    {
+        results.resize(batch.Size());
+
+        for (size_t i = 0; i < batch.Size(); i += c_width)
+        {
+            const XMVECTOR centerX = Load(batch.CenterX, i);
+            const XMVECTOR centerY = Load(batch.CenterY, i);
+            const XMVECTOR centerZ = Load(batch.CenterZ, i);
+            const XMVECTOR radius = Load(batch.Radius, i);
+
+            XMVECTOR inside = XMVectorTrueInt();
+            for (auto const& plane : planes)
+            {
+                const XMVECTOR distance = XMVectorSubtract(Dot(centerX, plane.NormalX, centerY, plane.NormalY, centerZ, plane.NormalZ), plane.Distance);
+                inside = XMVectorAndInt(inside, XMVectorLessOrEqual(distance, radius));
+            }
+
+            StoreResults(inside, i, batch.Size(), results);
+        }
+    }
+
+    void IntersectPlanes(vector<Plane> const& planes, OrientedBoxBatch const& batch, vector<uint8_t>& results)
+    {
+        results.resize(batch.Size());
+
+        for (size_t i = 0; i < batch.Size(); i += c_width)
+        {
+            const XMVECTOR centerX = Load(batch.CenterX, i);
+            const XMVECTOR centerY = Load(batch.CenterY, i);
+            const XMVECTOR centerZ = Load(batch.CenterZ, i);
+            const XMVECTOR axisXX = Load(batch.AxisXX, i);
+            const XMVECTOR axisXY = Load(batch.AxisXY, i);
+            const XMVECTOR axisXZ = Load(batch.AxisXZ, i);
+            const XMVECTOR axisYX = Load(batch.AxisYX, i);
+            const XMVECTOR axisYY = Load(batch.AxisYY, i);
+            const XMVECTOR axisYZ = Load(batch.AxisYZ, i);
+            const XMVECTOR axisZX = Load(batch.AxisZX, i);
+            const XMVECTOR axisZY = Load(batch.AxisZY, i);
+            const XMVECTOR axisZZ = Load(batch.AxisZZ, i);
+            const XMVECTOR halfExtentX = Load(batch.HalfExtentX, i);
+            const XMVECTOR halfExtentY = Load(batch.HalfExtentY, i);
+            const XMVECTOR halfExtentZ = Load(batch.HalfExtentZ, i);
+
+            XMVECTOR inside = XMVectorTrueInt();
+            for (auto const& plane : planes)
+            {
+                const XMVECTOR distance = XMVectorSubtract(Dot(centerX, plane.NormalX, centerY, plane.NormalY, centerZ, plane.NormalZ), plane.Distance);
+
+                // Half width of the boxes along the plane normal.
+                const XMVECTOR radius = Dot(
+                    XMVectorAbs(Dot(axisXX, plane.NormalX, axisXY, plane.NormalY, axisXZ, plane.NormalZ)), halfExtentX,
+                    XMVectorAbs(Dot(axisYX, plane.NormalX, axisYY, plane.NormalY, axisYZ, plane.NormalZ)), halfExtentY,
+                    XMVectorAbs(Dot(axisZX, plane.NormalX, axisZY, plane.NormalY, axisZZ, plane.NormalZ)), halfExtentZ);
+
+                inside = XMVectorAndInt(inside, XMVectorLessOrEqual(distance, radius));
+            }
+
+            StoreResults(inside, i, batch.Size(), results);
+        }
+    }
+
+    // Grows the arrays by one group of lanes when full.
+    void Grow(size_t size, initializer_list<vector<float>*> arrays)
+    {
+        for (auto* values : arrays)
+        {
+            if (size == values->size())
+            {
+                values->resize(size + c_width, 0.0f);
+            }
+        }
+    }
+
+    void ReserveAll(size_t count, initializer_list<vector<float>*> arrays)
+    {
+        for (auto* values : arrays)
+        {
+            values->reserve((count + c_width - 1) / c_width * c_width);
+        }
+    }
+}
+
+namespace AoaSampleApp
+{
+    void SphereBatch::Add(XMFLOAT3 const& center, float radius)
+    {
+        Grow(m_size, { &CenterX, &CenterY, &CenterZ, &Radius });
+
+        CenterX[m_size] = center.x;
+        CenterY[m_size] = center.y;
+        CenterZ[m_size] = center.z;
+        Radius[m_size] = radius;
+
+        ++m_size;
+    }
+
+    void SphereBatch::Clear()
+    {
+        CenterX.clear();
+        CenterY.clear();
+        CenterZ.clear();
+        Radius.clear();
+
+        m_size = 0;
+    }
+
+    void SphereBatch::Reserve(size_t count)
+    {
+        ReserveAll(count, { &CenterX, &CenterY, &CenterZ, &Radius });
+    }
+
+    void OrientedBoxBatch::Add(BoundingOrientedBox const& box)
+    {
+        Grow(m_size, {
+            &CenterX, &CenterY, &CenterZ,
+            &AxisXX, &AxisXY, &AxisXZ, &AxisYX, &AxisYY, &AxisYZ, &AxisZX, &AxisZY, &AxisZZ,
+            &HalfExtentX, &HalfExtentY, &HalfExtentZ });
+
+        const XMVECTOR orientation = XMLoadFloat4(&box.Orientation);
+
+        XMFLOAT3 axisX, axisY, axisZ;
+        XMStoreFloat3(&axisX, XMVector3Rotate(g_XMIdentityR0, orientation));
+        XMStoreFloat3(&axisY, XMVector3Rotate(g_XMIdentityR1, orientation));
+        XMStoreFloat3(&axisZ, XMVector3Rotate(g_XMIdentityR2, orientation));
+
+        CenterX[m_size] = box.Center.x;
+        CenterY[m_size] = box.Center.y;
+        CenterZ[m_size] = box.Center.z;
+        AxisXX[m_size] = axisX.x;
+        AxisXY[m_size] = axisX.y;
+        AxisXZ[m_size] = axisX.z;
+        AxisYX[m_size] = axisY.x;
+        AxisYY[m_size] = axisY.y;
+        AxisYZ[m_size] = axisY.z;
+        AxisZX[m_size] = axisZ.x;
+        AxisZY[m_size] = axisZ.y;
+        AxisZZ[m_size] = axisZ.z;
+        HalfExtentX[m_size] = box.Extents.x;
+        HalfExtentY[m_size] = box.Extents.y;
+        HalfExtentZ[m_size] = box.Extents.z;
+
+        ++m_size;
+    }
+
+    void OrientedBoxBatch::Clear()
+    {
+        for (auto* values : {
+            &CenterX, &CenterY, &CenterZ,
+            &AxisXX, &AxisXY, &AxisXZ, &AxisYX, &AxisYY, &AxisYZ, &AxisZX, &AxisZY, &AxisZZ,
+            &HalfExtentX, &HalfExtentY, &HalfExtentZ })
+        {
+            values->clear();
+        }
+
+        m_size = 0;
+    }
+
+    void OrientedBoxBatch::Reserve(size_t count)
+    {
+        ReserveAll(count, {
+            &CenterX, &CenterY, &CenterZ,
+            &AxisXX, &AxisXY, &AxisXZ, &AxisYX, &AxisYY, &AxisYZ, &AxisZX, &AxisZY, &AxisZZ,
+            &HalfExtentX, &HalfExtentY, &HalfExtentZ });
+    }
+
+    void IntersectBatch(BoundingSphere const& volume, SphereBatch const& batch, vector<uint8_t>& results)
+    {
+        results.resize(batch.Size());
+
+        const XMVECTOR volumeX = XMVectorReplicate(volume.Center.x);
+        const XMVECTOR volumeY = XMVectorReplicate(volume.Center.y);
+        const XMVECTOR volumeZ = XMVectorReplicate(volume.Center.z);
+        const XMVECTOR volumeRadius = XMVectorReplicate(volume.Radius);
+
+        for (size_t i = 0; i < batch.Size(); i += c_width)
+        {
+            const XMVECTOR offsetX = XMVectorSubtract(Load(batch.CenterX, i), volumeX);
+            const XMVECTOR offsetY = XMVectorSubtract(Load(batch.CenterY, i), volumeY);
+            const XMVECTOR offsetZ = XMVectorSubtract(Load(batch.CenterZ, i), volumeZ);
+            const XMVECTOR radius = XMVectorAdd(Load(batch.Radius, i), volumeRadius);
+
+            const XMVECTOR distanceSquared = Dot(offsetX, offsetX, offsetY, offsetY, offsetZ, offsetZ);
+            StoreResults(XMVectorLessOrEqual(distanceSquared, XMVectorMultiply(radius, radius)), i, batch.Size(), results);
+        }
+    }
+
+    void IntersectBatch(BoundingOrientedBox const& volume, SphereBatch const& batch, vector<uint8_t>& results)
+    {
+        IntersectPlanes(GetPlanes(volume), batch, results);
+    }
+
+    void IntersectBatch(BoundingFrustum const& volume, SphereBatch const& batch, vector<uint8_t>& results)
+    {
+        IntersectPlanes(GetPlanes(volume), batch, results);
+    }
+
+    void IntersectBatch(BoundingSphere const& volume, OrientedBoxBatch const& batch, vector<uint8_t>& results)
+    {
+        results.resize(batch.Size());
+
+        const XMVECTOR volumeX = XMVectorReplicate(volume.Center.x);
+        const XMVECTOR volumeY = XMVectorReplicate(volume.Center.y);
+        const XMVECTOR volumeZ = XMVectorReplicate(volume.Center.z);
+        const XMVECTOR volumeRadius = XMVectorReplicate(volume.Radius);
+
+        for (size_t i = 0; i < batch.Size(); i += c_width)
+        {
+            const XMVECTOR offsetX = XMVectorSubtract(volumeX, Load(batch.CenterX, i));
+            const XMVECTOR offsetY = XMVectorSubtract(volumeY, Load(batch.CenterY, i));
+            const XMVECTOR offsetZ = XMVectorSubtract(volumeZ, Load(batch.CenterZ, i));
+
+            // Distance from the sphere center to the closest point of the boxes, along each box axis.
+            const XMVECTOR outsideX = XMVectorMax(XMVectorSubtract(XMVectorAbs(Dot(offsetX, Load(batch.AxisXX, i), offsetY, Load(batch.AxisXY, i), offsetZ, Load(batch.AxisXZ, i))), Load(batch.HalfExtentX, i)), XMVectorZero());
+            const XMVECTOR outsideY = XMVectorMax(XMVectorSubtract(XMVectorAbs(Dot(offsetX, Load(batch.AxisYX, i), offsetY, Load(batch.AxisYY, i), offsetZ, Load(batch.AxisYZ, i))), Load(batch.HalfExtentY, i)), XMVectorZero());
+            const XMVECTOR outsideZ = XMVectorMax(XMVectorSubtract(XMVectorAbs(Dot(offsetX, Load(batch.AxisZX, i), offsetY, Load(batch.AxisZY, i), offsetZ, Load(batch.AxisZZ, i))), Load(batch.HalfExtentZ, i)), XMVectorZero());
+
+            const XMVECTOR distanceSquared = Dot(outsideX, outsideX, outsideY, outsideY, outsideZ, outsideZ);
+            StoreResults(XMVectorLessOrEqual(distanceSquared, XMVectorMultiply(volumeRadius, volumeRadius)), i, batch.Size(), results);
+        }
+    }
+
+    void IntersectBatch(BoundingOrientedBox const& volume, OrientedBoxBatch const& batch, vector<uint8_t>& results)
+    {
+        IntersectPlanes(GetPlanes(volume), batch, results);
+    }
+
+    void IntersectBatch(BoundingFrustum const& volume, OrientedBoxBatch const& batch, vector<uint8_t>& results)
+    {
+        IntersectPlanes(GetPlanes(volume), batch, results);
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Spheres in structure-of-arrays layout, so that they are tested against a search volume four at a time.
+    // Points are spheres with a zero radius.
+    //
+    // Arrays are padded with empty spheres at the origin up to a multiple of four.
+    class SphereBatch
+    {
+    public:
+        void Add(DirectX::XMFLOAT3 const& center, float radius = 0.0f);
+        void Clear();
+        void Reserve(size_t count);
+
+        size_t Size() const { return m_size; }
+
+        std::vector<float> CenterX;
+        std::vector<float> CenterY;
+        std::vector<float> CenterZ;
+        std::vector<float> Radius;
+
+    private:
+        size_t m_size{ 0 };
+    };
+
+    // Oriented boxes in structure-of-arrays layout, with unit axes and half widths along them.
+    //
+    // Arrays are padded with empty boxes at the origin up to a multiple of four.
+    class OrientedBoxBatch
+    {
+    public:
+        void Add(DirectX::BoundingOrientedBox const& box);
+        void Clear();
+        void Reserve(size_t count);
+
+        size_t Size() const { return m_size; }
+
+        std::vector<float> CenterX;
+        std::vector<float> CenterY;
+        std::vector<float> CenterZ;
+        std::vector<float> AxisXX, AxisXY, AxisXZ;
+        std::vector<float> AxisYX, AxisYY, AxisYZ;
+        std::vector<float> AxisZX, AxisZY, AxisZZ;
+        std::vector<float> HalfExtentX;
+        std::vector<float> HalfExtentY;
+        std::vector<float> HalfExtentZ;
+
+    private:
+        size_t m_size{ 0 };
+    };
+
+    // Sets results[i] to 1 if the i-th element of the batch intersects the search volume, or to 0 otherwise.
+    //
+    // Tests against a sphere are exact. Tests against a box or frustum check the volume's face planes, which is
+    // exact for points and may report elements near the volume's edges and corners as intersecting, where
+    // DirectXCollision's Intersects reports them as disjoint.
+    //
+    // A SpatialFieldOfView is a frustum with a zero near distance, turned half a turn around Y since it looks
+    // towards -Z.
+    void IntersectBatch(DirectX::BoundingSphere const& volume, SphereBatch const& batch, std::vector<uint8_t>& results);
+    void IntersectBatch(DirectX::BoundingOrientedBox const& volume, SphereBatch const& batch, std::vector<uint8_t>& results);
+    void IntersectBatch(DirectX::BoundingFrustum const& volume, SphereBatch const& batch, std::vector<uint8_t>& results);
+
+    void IntersectBatch(DirectX::BoundingSphere const& volume, OrientedBoxBatch const& batch, std::vector<uint8_t>& results);
+    void IntersectBatch(DirectX::BoundingOrientedBox const& volume, OrientedBoxBatch const& batch, std::vector<uint8_t>& results);
+    void IntersectBatch(DirectX::BoundingFrustum const& volume, OrientedBoxBatch const& batch, std::vector<uint8_t>& results);
+}
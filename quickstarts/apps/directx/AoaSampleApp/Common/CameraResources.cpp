@@ -194,6 +194,8 @@ void AoaSampleApp::CameraResources::UpdateViewProjectionBuffer(
             &viewProjectionConstantBufferData.viewProjection[1],
             XMMatrixTranspose(XMLoadFloat4x4(&viewCoordinateSystemTransform.Right) * XMLoadFloat4x4(&cameraProjectionTransform.Right))
         );
+
+        m_viewProjection = viewProjectionConstantBufferData;
     }
 
     // Use the D3D device context to update Direct3D device-based resources.
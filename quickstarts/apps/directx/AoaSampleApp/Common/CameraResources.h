@@ -53,6 +53,9 @@ namespace AoaSampleApp
         // The holographic camera these resources are for.
         winrt::Windows::Graphics::Holographic::HolographicCamera const& GetHolographicCamera() const { return m_holographicCamera; }
 
+        // View-projection matrices of the last update, transposed as in the constant buffer.
+        ViewProjectionConstantBuffer const& GetViewProjection()    const { return m_viewProjection; }
+
     private:
         // Direct3D rendering objects. Required for 3D.
         Microsoft::WRL::ComPtr<ID3D11RenderTargetView>              m_d3dRenderTargetView;
@@ -63,6 +66,9 @@ namespace AoaSampleApp
         // Device resource to store view and projection matrices.
         Microsoft::WRL::ComPtr<ID3D11Buffer>                        m_viewProjectionConstantBuffer;
 
+        // CPU copy of the view and projection matrices, for culling.
+        ViewProjectionConstantBuffer                                m_viewProjection{};
+
         // Direct3D rendering properties.
         DXGI_FORMAT                                                 m_dxgiFormat;
         winrt::Windows::Foundation::Size                            m_d3dRenderTargetSize;
@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "DiagnosticsRing.h"
+
+#include <fileapifromapp.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace winrt::Microsoft::Azure::ObjectAnchors;
+using namespace winrt::Microsoft::Azure::ObjectAnchors::Diagnostics;
+
+namespace
+{
+    uint64_t GetFileSize(wstring const& path)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA attributes{};
+        if (!::GetFileAttributesExFromAppW(path.c_str(), GetFileExInfoStandard, &attributes))
+        {
+            return 0;
+        }
+
+        return (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    }
+
+    // Keeps letters, digits and dashes so that the reason can be part of a folder name.
+    wstring ToFolderName(string const& reason)
+    {
+        wstring name;
+        for (const char c : reason)
+        {
+            name += isalnum(static_cast<unsigned char>(c)) || c == '-' ? static_cast<wchar_t>(c) : L'_';
+        }
+
+        return name;
+    }
+}
+
+namespace AoaSampleApp
+{
+    DiagnosticsRing::DiagnosticsRing(
+        ObjectObserver const& observer,
+        DiagnosticsRingLimits const& limits,
+        wstring segmentFolderPath,
+        wstring captureFolderPath,
+        function<void(wstring const& segmentPath)> segmentSink)
+        : m_observer(observer)
+        , m_limits(limits)
+        , m_segmentFolderPath(move(segmentFolderPath))
+        , m_captureFolderPath(move(captureFolderPath))
+        , m_segmentSink(move(segmentSink))
+        , m_wake(::CreateEvent(nullptr, false, false, nullptr))     // auto reset event
+        , m_stopped(::CreateEvent(nullptr, true, false, nullptr))   // manual reset event
+    {
+        winrt::check_bool(bool{ m_wake } && bool{ m_stopped });
+
+        // Segments of a previous run are outside of the window.
+        ::CreateDirectoryFromAppW(m_segmentFolderPath.c_str(), nullptr);
+
+        WIN32_FIND_DATAW findData;
+        const HANDLE find = ::FindFirstFileExFromAppW(PathJoin(m_segmentFolderPath, L"*.zip").c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, 0);
+        if (find != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                ::DeleteFileFromAppW(PathJoin(m_segmentFolderPath, findData.cFileName).c_str());
+            } while (::FindNextFileW(find, &findData));
+
+            ::FindClose(find);
+        }
+
+        RunAsync();
+    }
+
+    DiagnosticsRing::~DiagnosticsRing()
+    {
+        {
+            lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+
+        winrt::check_bool(::SetEvent(m_wake.get()));
+        ::WaitForSingleObject(m_stopped.get(), INFINITE);
+    }
+
+    void DiagnosticsRing::RequestFlush(string reason)
+    {
+        {
+            lock_guard lock(m_mutex);
+
+            const auto now = steady_clock::now();
+            if (m_stopping || !m_flushReason.empty() || (m_lastFlushTime && now - *m_lastFlushTime < m_limits.MinFlushInterval))
+            {
+                return;
+            }
+
+            m_flushReason = move(reason);
+            m_lastFlushTime = now;
+        }
+
+        winrt::check_bool(::SetEvent(m_wake.get()));
+    }
+
+    winrt::Windows::Foundation::IAsyncAction DiagnosticsRing::StopAsync()
+    {
+        {
+            lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+
+        winrt::check_bool(::SetEvent(m_wake.get()));
+        co_await winrt::resume_on_signal(m_stopped.get());
+    }
+
+    winrt::Windows::Foundation::IAsyncAction DiagnosticsRing::RunAsync()
+    {
+        co_await winrt::resume_background();
+
+        try
+        {
+            ObjectDiagnosticsSession session(m_observer, m_limits.SegmentCapacity);
+            auto segmentStartTime = steady_clock::now();
+
+            for (;;)
+            {
+                const auto segmentTimeLeft = m_limits.SegmentDuration - (steady_clock::now() - segmentStartTime);
+                if (segmentTimeLeft > 0s)
+                {
+                    co_await winrt::resume_on_signal(m_wake.get(), duration_cast<winrt::Windows::Foundation::TimeSpan>(segmentTimeLeft));
+                }
+
+                bool stopping;
+                string flushReason;
+                {
+                    lock_guard lock(m_mutex);
+                    stopping = m_stopping;
+                    flushReason = std::exchange(m_flushReason, {});
+                }
+
+                if (!stopping && flushReason.empty() && steady_clock::now() - segmentStartTime < m_limits.SegmentDuration)
+                {
+                    continue;
+                }
+
+                // A flush closes the current session early so that the copy includes the moments before the request.
+                co_await CloseSegmentAsync(std::move(session));
+                TrimSegments();
+
+                if (stopping)
+                {
+                    break;
+                }
+
+                session = ObjectDiagnosticsSession(m_observer, m_limits.SegmentCapacity);
+                segmentStartTime = steady_clock::now();
+
+                if (!flushReason.empty() && !m_segmentSink)
+                {
+                    CopySegments(flushReason);
+                }
+            }
+        }
+        catch (...)
+        {
+            // Diagnostics are best effort; a failure only stops the capture.
+        }
+
+        ::SetEvent(m_stopped.get());
+    }
+
+    winrt::Windows::Foundation::IAsyncAction DiagnosticsRing::CloseSegmentAsync(ObjectDiagnosticsSession session)
+    {
+        const wstring path = PathJoin(m_segmentFolderPath, L"segment-" + to_wstring(m_nextSegmentNumber++) + L".zip");
+
+        co_await session.CloseAsync(path);
+
+        if (m_segmentSink)
+        {
+            // The sink owns the file from now on.
+            m_segmentSink(path);
+            co_return;
+        }
+
+        const uint64_t size = GetFileSize(path);
+        m_segments.push_back({ path, size, steady_clock::now() });
+        m_segmentBytes += size;
+    }
+
+    void DiagnosticsRing::TrimSegments()
+    {
+        const auto now = steady_clock::now();
+
+        while (!m_segments.empty() &&
+            (now - m_segments.front().EndTime > m_limits.Window || m_segmentBytes > m_limits.MaxBytes))
+        {
+            ::DeleteFileFromAppW(m_segments.front().Path.c_str());
+            m_segmentBytes -= m_segments.front().Size;
+            m_segments.pop_front();
+        }
+    }
+
+    void DiagnosticsRing::CopySegments(string const& reason) const
+    {
+        const wstring captureFolderPath = PathJoin(m_captureFolderPath, StringToWideString(FormatDateTime(std::time(nullptr))) + L"-" + ToFolderName(reason));
+        if (!::CreateDirectoryFromAppW(captureFolderPath.c_str(), nullptr))
+        {
+            return;
+        }
+
+        for (auto const& segment : m_segments)
+        {
+            ::CopyFileFromAppW(segment.Path.c_str(), PathJoin(captureFolderPath, PathFilename(segment.Path)).c_str(), false);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <winrt/Microsoft.Azure.ObjectAnchors.h>
+#include <winrt/Microsoft.Azure.ObjectAnchors.Diagnostics.h>
+#include <winrt/Windows.Foundation.h>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace AoaSampleApp
+{
+    // Bounds of a diagnostics capture that runs continuously.
+    struct DiagnosticsRingLimits
+    {
+        // Age of the oldest capture kept.
+        std::chrono::seconds Window{ 60 };
+
+        // Total size of the captures kept on disk.
+        uint64_t MaxBytes{ 64ull * 1024 * 1024 };
+
+        // A session is closed to disk and replaced after this long, which bounds the capture held in memory.
+        std::chrono::seconds SegmentDuration{ 10 };
+
+        // Capacity of each session.
+        uint32_t SegmentCapacity{ 64 };
+
+        // Flushes requested sooner than this after the previous one are ignored, since they would copy the same window.
+        std::chrono::seconds MinFlushInterval{ 30 };
+    };
+
+    // Keeps the last few seconds of diagnostics as a ring of short diagnostics sessions written to the local cache,
+    // and copies them to a capture folder when something worth investigating happens.
+    //
+    // With a segment sink, closed segments are handed over to the sink instead, e.g. to stream them to the service.
+    //
+    // Sessions are opened, closed and copied by a single background loop, so requesting a flush never blocks.
+    class DiagnosticsRing
+    {
+    public:
+        DiagnosticsRing(
+            winrt::Microsoft::Azure::ObjectAnchors::ObjectObserver const& observer,
+            DiagnosticsRingLimits const& limits,
+            std::wstring segmentFolderPath,
+            std::wstring captureFolderPath,
+            std::function<void(std::wstring const& segmentPath)> segmentSink = nullptr);
+
+        // Stops capturing and waits for the loop to exit.
+        ~DiagnosticsRing();
+
+        // Copies the captures in the window to a new folder of the capture folder, named by time and reason.
+        void RequestFlush(std::string reason);
+
+        // Closes the current session into the ring and stops capturing.
+        winrt::Windows::Foundation::IAsyncAction StopAsync();
+
+    private:
+        struct Segment
+        {
+            std::wstring Path;
+            uint64_t Size;
+            std::chrono::steady_clock::time_point EndTime;
+        };
+
+        winrt::Windows::Foundation::IAsyncAction RunAsync();
+
+        winrt::Windows::Foundation::IAsyncAction CloseSegmentAsync(winrt::Microsoft::Azure::ObjectAnchors::Diagnostics::ObjectDiagnosticsSession session);
+        void TrimSegments();
+        void CopySegments(std::string const& reason) const;
+
+        winrt::Microsoft::Azure::ObjectAnchors::ObjectObserver m_observer{ nullptr };
+        DiagnosticsRingLimits m_limits;
+        std::wstring m_segmentFolderPath;
+        std::wstring m_captureFolderPath;
+        std::function<void(std::wstring const& segmentPath)> m_segmentSink;
+
+        // Accessed by the loop only.
+        std::deque<Segment> m_segments;
+        uint64_t m_segmentBytes{ 0 };
+        uint32_t m_nextSegmentNumber{ 0 };
+
+        // Requests to the loop.
+        std::mutex m_mutex;
+        winrt::handle m_wake{ nullptr };
+        winrt::handle m_stopped{ nullptr };
+        bool m_stopping{ false };
+        std::string m_flushReason;
+        std::optional<std::chrono::steady_clock::time_point> m_lastFlushTime;
+    };
+}
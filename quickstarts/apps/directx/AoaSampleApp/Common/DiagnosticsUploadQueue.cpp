@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "DiagnosticsUploadQueue.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace AoaSampleApp
+{
+    DiagnosticsUploadQueue::DiagnosticsUploadQueue(IDiagnosticsUploadTransport& transport, DiagnosticsUploadLimits const& limits)
+        : m_transport(transport)
+        , m_limits(limits)
+        , m_retryDelay(limits.InitialRetryDelay)
+    {
+    }
+
+    void DiagnosticsUploadQueue::Add(wstring path, uint64_t size)
+    {
+        vector<wstring> droppedPaths;
+        {
+            lock_guard lock(m_mutex);
+
+            m_files.push_back({ move(path), size, m_addedCount++ });
+            m_queuedBytes += size;
+
+            droppedPaths = TrimLocked();
+        }
+
+        Delete(droppedPaths);
+    }
+
+    optional<steady_clock::duration> DiagnosticsUploadQueue::UploadNext()
+    {
+        QueuedFile file;
+        {
+            lock_guard lock(m_mutex);
+            if (m_files.empty())
+            {
+                return nullopt;
+            }
+
+            file = m_files.front();
+            m_uploading = true;
+        }
+
+        const auto startTime = steady_clock::now();
+        const bool uploaded = m_transport.Upload(file.Path);
+        const auto uploadTime = steady_clock::now() - startTime;
+
+        vector<wstring> droppedPaths;
+        {
+            lock_guard lock(m_mutex);
+
+            // The file being uploaded is never trimmed, so it's still at the front.
+            m_uploading = false;
+            m_files.pop_front();
+
+            if (uploaded)
+            {
+                m_queuedBytes -= file.Size;
+            }
+            else
+            {
+                m_files.push_back(file);
+            }
+
+            // Files queued during the upload may have been kept over the budget for it.
+            droppedPaths = TrimLocked();
+        }
+
+        Delete(droppedPaths);
+
+        if (!uploaded)
+        {
+            const auto retryDelay = m_retryDelay;
+            m_retryDelay = (min)(m_retryDelay * 2, duration_cast<steady_clock::duration>(m_limits.MaxRetryDelay));
+            return retryDelay;
+        }
+
+        m_transport.Delete(file.Path);
+        m_retryDelay = m_limits.InitialRetryDelay;
+
+        // Pause so that the average rate stays under the limit.
+        const auto minimumTime = duration_cast<steady_clock::duration>(duration<double>(double(file.Size) / m_limits.MaxBytesPerSecond));
+        return uploadTime < minimumTime ? minimumTime - uploadTime : steady_clock::duration::zero();
+    }
+
+    vector<wstring> DiagnosticsUploadQueue::GetPaths() const
+    {
+        lock_guard lock(m_mutex);
+
+        vector<wstring> paths;
+        paths.reserve(m_files.size());
+
+        for (auto const& file : m_files)
+        {
+            paths.push_back(file.Path);
+        }
+
+        return paths;
+    }
+
+    uint64_t DiagnosticsUploadQueue::GetQueuedBytes() const
+    {
+        lock_guard lock(m_mutex);
+        return m_queuedBytes;
+    }
+
+    vector<wstring> DiagnosticsUploadQueue::TrimLocked()
+    {
+        vector<wstring> droppedPaths;
+
+        // Failed uploads go back in the queue, so the oldest files may be anywhere in it. The file uploading and
+        // the last one added are kept even over the budget.
+        while (m_queuedBytes > m_limits.MaxQueueBytes)
+        {
+            auto oldest = m_files.end();
+            for (auto it = m_uploading ? next(m_files.begin()) : m_files.begin(); it != m_files.end(); ++it)
+            {
+                if (it->AddedNumber + 1 != m_addedCount && (oldest == m_files.end() || it->AddedNumber < oldest->AddedNumber))
+                {
+                    oldest = it;
+                }
+            }
+
+            if (oldest == m_files.end())
+            {
+                break;
+            }
+
+            m_queuedBytes -= oldest->Size;
+            droppedPaths.push_back(move(oldest->Path));
+            m_files.erase(oldest);
+        }
+
+        return droppedPaths;
+    }
+
+    void DiagnosticsUploadQueue::Delete(vector<wstring> const& paths)
+    {
+        for (auto const& path : paths)
+        {
+            m_transport.Delete(path);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    struct DiagnosticsUploadLimits
+    {
+        // Average upload rate. Each file is uploaded at once, so the rate is enforced by pausing between files.
+        uint64_t MaxBytesPerSecond{ 256 * 1024 };
+
+        // Delay before the next upload after a failed one, doubled on each consecutive failure.
+        std::chrono::seconds InitialRetryDelay{ 5 };
+        std::chrono::seconds MaxRetryDelay{ 300 };
+
+        // Total size of the queued files. Queuing a file past it drops the oldest ones that aren't uploading, but
+        // never the file just queued.
+        uint64_t MaxQueueBytes{ 256ull * 1024 * 1024 };
+    };
+
+    // How queued files are uploaded and deleted, so that the queue can be tested without the Object Anchors service.
+    class IDiagnosticsUploadTransport
+    {
+    public:
+        virtual ~IDiagnosticsUploadTransport() = default;
+
+        // Uploads a file, blocking until done. Returns false if the upload failed or was canceled.
+        virtual bool Upload(std::wstring const& path) = 0;
+
+        // Deletes a file once uploaded or dropped from the queue.
+        virtual void Delete(std::wstring const& path) = 0;
+    };
+
+    // Diagnostics files waiting to be uploaded, and the order and pace of their uploads.
+    //
+    // Files are uploaded in the order they were queued. A file whose upload failed goes behind the files queued
+    // since, so that a file the service keeps rejecting doesn't hold back the others, and the next upload waits
+    // for the retry delay. Failed files stay queued however long the device is offline, within the byte budget
+    // of the queue. Files may be added from any thread while one thread uploads them. The transport is called
+    // without holding the lock of the queue.
+    class DiagnosticsUploadQueue
+    {
+    public:
+        DiagnosticsUploadQueue(IDiagnosticsUploadTransport& transport, DiagnosticsUploadLimits const& limits);
+
+        // Queues a file last, then drops the files queued the longest ago, other than the one uploading and the new
+        // one, until the queue fits in its budget.
+        void Add(std::wstring path, uint64_t size);
+
+        // Uploads the file at the front of the queue and returns how long to wait before the next upload: after
+        // a success, long enough for the average rate to stay under the limit, and after a failure, the retry
+        // delay. Returns nothing if the queue is empty.
+        std::optional<std::chrono::steady_clock::duration> UploadNext();
+
+        // Paths of the queued files, in upload order.
+        std::vector<std::wstring> GetPaths() const;
+
+        uint64_t GetQueuedBytes() const;
+
+    private:
+        struct QueuedFile
+        {
+            std::wstring Path;
+            uint64_t Size;
+            uint64_t AddedNumber;           // Order in which files were added, which failed uploads don't change.
+        };
+
+        // Removes files from the queue to fit in the budget, returning their paths for the caller to delete
+        // outside of the lock.
+        std::vector<std::wstring> TrimLocked();
+
+        void Delete(std::vector<std::wstring> const& paths);
+
+        IDiagnosticsUploadTransport& m_transport;
+        DiagnosticsUploadLimits m_limits;
+
+        mutable std::mutex m_mutex;
+        std::deque<QueuedFile> m_files;
+        uint64_t m_queuedBytes{ 0 };
+        bool m_uploading{ false };          // The front file is uploading.
+        uint64_t m_addedCount{ 0 };
+
+        std::chrono::steady_clock::duration m_retryDelay;
+    };
+}
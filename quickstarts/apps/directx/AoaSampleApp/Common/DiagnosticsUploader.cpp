@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "DiagnosticsUploader.h"
+
+#include <fileapifromapp.h>
+#include <winrt/Microsoft.Azure.ObjectAnchors.Diagnostics.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace winrt::Microsoft::Azure::ObjectAnchors;
+using namespace winrt::Microsoft::Azure::ObjectAnchors::Diagnostics;
+
+namespace
+{
+    uint64_t GetFileSize(wstring const& path)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA attributes{};
+        return ::GetFileAttributesExFromAppW(path.c_str(), GetFileExInfoStandard, &attributes) ?
+            (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow : 0;
+    }
+
+    // Signals an event when going out of scope, however the scope is left.
+    struct SetEventOnExit
+    {
+        HANDLE Event;
+
+        ~SetEventOnExit()
+        {
+            ::SetEvent(Event);
+        }
+    };
+}
+
+namespace AoaSampleApp
+{
+    // Uploads with the Object Anchors service, and deletes files from the queue folder.
+    class DiagnosticsUploader::ObjectAnchorsUploadTransport : public IDiagnosticsUploadTransport
+    {
+    public:
+        explicit ObjectAnchorsUploadTransport(ObjectAnchorsSession const& session)
+            : m_session(session)
+        {
+        }
+
+        // Called by the upload loop on the thread pool, where blocking on the upload is allowed.
+        bool Upload(wstring const& path) override
+        {
+            winrt::Windows::Foundation::IAsyncAction upload{ nullptr };
+            bool uploaded = false;
+
+            try
+            {
+                {
+                    lock_guard lock(m_mutex);
+                    if (m_canceled)
+                    {
+                        return false;
+                    }
+
+                    upload = ObjectDiagnosticsSession::UploadDiagnosticsAsync(path, m_session);
+                    m_currentUpload = upload;
+                }
+
+                upload.get();
+                uploaded = true;
+            }
+            catch (...)
+            {
+                // Retried by the queue, unless stopping.
+            }
+
+            lock_guard lock(m_mutex);
+            m_currentUpload = nullptr;
+
+            return uploaded;
+        }
+
+        void Delete(wstring const& path) override
+        {
+            ::DeleteFileFromAppW(path.c_str());
+        }
+
+        // Cancels the upload in progress, and fails the ones that follow.
+        void Cancel()
+        {
+            lock_guard lock(m_mutex);
+            m_canceled = true;
+
+            if (m_currentUpload)
+            {
+                m_currentUpload.Cancel();
+            }
+        }
+
+    private:
+        ObjectAnchorsSession m_session{ nullptr };
+
+        mutex m_mutex;
+        winrt::Windows::Foundation::IAsyncAction m_currentUpload{ nullptr };
+        bool m_canceled{ false };
+    };
+
+    DiagnosticsUploader::DiagnosticsUploader(
+        ObjectAnchorsSession const& session,
+        wstring queueFolderPath,
+        DiagnosticsUploadLimits const& limits)
+        : m_queueFolderPath(move(queueFolderPath))
+        , m_transport(make_unique<ObjectAnchorsUploadTransport>(session))
+        , m_queue(*m_transport, limits)
+        , m_wake(::CreateEvent(nullptr, false, false, nullptr))     // auto reset event
+        , m_stop(::CreateEvent(nullptr, true, false, nullptr))      // manual reset event
+        , m_stopped(::CreateEvent(nullptr, true, false, nullptr))   // manual reset event
+    {
+        winrt::check_bool(bool{ m_wake } && bool{ m_stop } && bool{ m_stopped });
+
+        // Resume the uploads left by a previous run. Names start with the time they were queued.
+        ::CreateDirectoryFromAppW(m_queueFolderPath.c_str(), nullptr);
+
+        vector<pair<wstring, uint64_t>> files;
+
+        WIN32_FIND_DATAW findData;
+        const HANDLE find = ::FindFirstFileExFromAppW(PathJoin(m_queueFolderPath, L"*.zip").c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, 0);
+        if (find != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                const uint64_t size = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+                files.emplace_back(PathJoin(m_queueFolderPath, findData.cFileName), size);
+            } while (::FindNextFileW(find, &findData));
+
+            ::FindClose(find);
+        }
+
+        sort(files.begin(), files.end());
+        for (auto& [path, size] : files)
+        {
+            m_queue.Add(move(path), size);
+        }
+
+        RunAsync();
+    }
+
+    DiagnosticsUploader::~DiagnosticsUploader()
+    {
+        {
+            lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_transport->Cancel();
+
+        winrt::check_bool(::SetEvent(m_stop.get()));
+        winrt::check_bool(::SetEvent(m_wake.get()));
+
+        // The loop uses the members of the uploader until it ends. Its upload was canceled, so this doesn't wait
+        // for the upload to complete.
+        ::WaitForSingleObject(m_stopped.get(), INFINITE);
+    }
+
+    void DiagnosticsUploader::Enqueue(wstring const& filePath)
+    {
+        {
+            lock_guard lock(m_mutex);
+
+            wostringstream name;
+            name << StringToWideString(FormatDateTime(std::time(nullptr))) << L"-" << setw(6) << setfill(L'0') << m_nextFileNumber++ << L".zip";
+
+            const uint64_t size = GetFileSize(filePath);
+
+            auto queuedPath = PathJoin(m_queueFolderPath, name.str());
+            if (!::MoveFileFromAppW(filePath.c_str(), queuedPath.c_str()))
+            {
+                return;
+            }
+
+            m_queue.Add(move(queuedPath), size);
+        }
+
+        winrt::check_bool(::SetEvent(m_wake.get()));
+    }
+
+    winrt::Windows::Foundation::IAsyncAction DiagnosticsUploader::RunAsync()
+    {
+        // The destructor waits for this, however the loop ends.
+        SetEventOnExit signalStopped{ m_stopped.get() };
+
+        co_await winrt::resume_background();
+
+        for (;;)
+        {
+            {
+                lock_guard lock(m_mutex);
+                if (m_stopping)
+                {
+                    break;
+                }
+            }
+
+            const auto delay = m_queue.UploadNext();
+            if (!delay)
+            {
+                co_await winrt::resume_on_signal(m_wake.get());
+                continue;
+            }
+
+            // Pauses between uploads, and retry delays, end early on stop.
+            if (*delay > steady_clock::duration::zero())
+            {
+                co_await winrt::resume_on_signal(m_stop.get(), duration_cast<winrt::Windows::Foundation::TimeSpan>(*delay));
+            }
+        }
+    }
+}
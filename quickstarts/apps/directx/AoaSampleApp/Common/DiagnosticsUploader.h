@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "DiagnosticsUploadQueue.h"
+
+#include <winrt/Microsoft.Azure.ObjectAnchors.h>
+#include <winrt/Windows.Foundation.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace AoaSampleApp
+{
+    // Uploads diagnostics files to the Object Anchors service in the background, in the order of DiagnosticsUploadQueue.
+    //
+    // The queue is the content of a folder in the local cache: a file is moved there when queued and deleted once
+    // uploaded, so uploads that didn't complete resume the next time the uploader is created.
+    class DiagnosticsUploader
+    {
+    public:
+        DiagnosticsUploader(
+            winrt::Microsoft::Azure::ObjectAnchors::ObjectAnchorsSession const& session,
+            std::wstring queueFolderPath,
+            DiagnosticsUploadLimits const& limits);
+
+        // Cancels the upload in progress, which resumes with the next uploader, and waits for the upload loop to end.
+        ~DiagnosticsUploader();
+
+        // Moves the file to the queue.
+        void Enqueue(std::wstring const& filePath);
+
+    private:
+        class ObjectAnchorsUploadTransport;
+
+        winrt::Windows::Foundation::IAsyncAction RunAsync();
+
+        std::wstring m_queueFolderPath;
+
+        std::unique_ptr<ObjectAnchorsUploadTransport> m_transport;
+        DiagnosticsUploadQueue m_queue;
+
+        std::mutex m_mutex;
+        uint32_t m_nextFileNumber{ 0 };
+        bool m_stopping{ false };
+
+        winrt::handle m_wake{ nullptr };        // Signaled when a file is queued or on stop.
+        winrt::handle m_stop{ nullptr };        // Ends the pauses between uploads, which new files don't.
+        winrt::handle m_stopped{ nullptr };
+    };
+}
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "DirectFileRead.h"
+
+#ifdef _WIN32
+#include <fileapifromapp.h>
+#else
+#include <fcntl.h>
+#include <filesystem>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace AoaSampleApp
+{
+#ifdef _WIN32
+    bool TryReadFileDirect(wstring const& path, vector<uint8_t>& data)
+    {
+        CREATEFILE2_EXTENDED_PARAMETERS parameters{};
+        parameters.dwSize = sizeof(parameters);
+        parameters.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+        parameters.dwFileFlags = FILE_FLAG_SEQUENTIAL_SCAN;
+
+        winrt::file_handle file{ ::CreateFile2FromAppW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, &parameters) };
+        if (!file)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!::GetFileSizeEx(file.get(), &fileSize))
+        {
+            return false;
+        }
+
+        data.resize(static_cast<size_t>(fileSize.QuadPart));
+
+        size_t offset = 0;
+        while (offset < data.size())
+        {
+            const DWORD chunkSize = static_cast<DWORD>((min)(data.size() - offset, size_t{ 1 } << 30));
+
+            DWORD bytesRead = 0;
+            if (!::ReadFile(file.get(), data.data() + offset, chunkSize, &bytesRead, nullptr) || bytesRead == 0)
+            {
+                return false;
+            }
+
+            offset += bytesRead;
+        }
+
+        return true;
+    }
+#else
+    // POSIX version, so that the reads can be measured off the device.
+    bool TryReadFileDirect(wstring const& path, vector<uint8_t>& data)
+    {
+        const int file = ::open(filesystem::path(path).c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStatus{};
+        bool succeeded = ::fstat(file, &fileStatus) == 0;
+
+        if (succeeded)
+        {
+            ::posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+            data.resize(static_cast<size_t>(fileStatus.st_size));
+        }
+
+        size_t offset = 0;
+        while (succeeded && offset < data.size())
+        {
+            const ssize_t bytesRead = ::read(file, data.data() + offset, (min)(data.size() - offset, size_t{ 1 } << 30));
+            succeeded = bytesRead > 0;
+            offset += succeeded ? static_cast<size_t>(bytesRead) : 0;
+        }
+
+        ::close(file);
+        return succeeded;
+    }
+#endif
+}
@@ -0,0 +1,14 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Reads a whole file into the caller's buffer, resized to the file size, with the platform's file APIs and
+    // without going through the storage APIs. Returns false if the file can't be opened this way, e.g. in
+    // brokered locations of a UWP app, or if the read fails.
+    bool TryReadFileDirect(std::wstring const& path, std::vector<uint8_t>& data);
+}
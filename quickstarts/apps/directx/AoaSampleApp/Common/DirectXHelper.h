@@ -4,25 +4,32 @@
 
 namespace AoaSampleApp
 {
-    // Function that reads from a binary file asynchronously.
-    inline std::future<std::vector<byte>> ReadDataAsync(const std::wstring_view& filename)
+    // Converts a length in device-independent pixels (DIPs) to a length in physical pixels.
+    inline float ConvertDipsToPixels(float dips, float dpi)
     {
-        using namespace winrt::Windows::Storage;
-        using namespace winrt::Windows::Storage::Streams;
+        constexpr float dipsPerInch = 96.0f;
+        return floorf(dips * dpi / dipsPerInch + 0.5f); // Round to nearest integer.
+    }
 
-        IBuffer fileBuffer = co_await PathIO::ReadBufferAsync(filename);
+    // Conversions between the WinRT numerics types and the DirectXMath ones used by the portable parts of the sample.
+    inline DirectX::XMFLOAT3 ToXMFloat3(winrt::Windows::Foundation::Numerics::float3 const& value)
+    {
+        return { value.x, value.y, value.z };
+    }
 
-        std::vector<byte> returnBuffer;
-        returnBuffer.resize(fileBuffer.Length());
-        DataReader::FromBuffer(fileBuffer).ReadBytes(winrt::array_view<uint8_t>(returnBuffer));
-        return returnBuffer;
+    inline winrt::Windows::Foundation::Numerics::float3 ToFloat3(DirectX::XMFLOAT3 const& value)
+    {
+        return { value.x, value.y, value.z };
     }
 
-    // Converts a length in device-independent pixels (DIPs) to a length in physical pixels.
-    inline float ConvertDipsToPixels(float dips, float dpi)
+    inline DirectX::XMFLOAT4 ToXMFloat4(winrt::Windows::Foundation::Numerics::quaternion const& value)
     {
-        constexpr float dipsPerInch = 96.0f;
-        return floorf(dips * dpi / dipsPerInch + 0.5f); // Round to nearest integer.
+        return { value.x, value.y, value.z, value.w };
+    }
+
+    inline winrt::Windows::Foundation::Numerics::quaternion ToQuaternion(DirectX::XMFLOAT4 const& value)
+    {
+        return { value.x, value.y, value.z, value.w };
     }
 
     inline winrt::Windows::Graphics::DirectX::Direct3D11::IDirect3DSurface CreateDepthTextureInteropObject(
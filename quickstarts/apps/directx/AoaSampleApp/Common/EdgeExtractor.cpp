@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "EdgeExtractor.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // An edge by its vertices, lower index first, and where it comes up in the ranges.
+    struct EdgeUse
+    {
+        uint64_t Key;
+        uint32_t Order;
+        uint32_t Triangle;
+        uint32_t Range;
+
+        bool operator<(EdgeUse const& other) const
+        {
+            return Key < other.Key || (Key == other.Key && Order < other.Order);
+        }
+    };
+
+    uint64_t GetEdgeKey(uint32_t a, uint32_t b)
+    {
+        return a < b ? (uint64_t{ a } << 32) | b : (uint64_t{ b } << 32) | a;
+    }
+
+    // Unit normal of a triangle, or zero if it is degenerate.
+    XMVECTOR GetTriangleNormal(vector<XMFLOAT3> const& vertices, uint32_t const* corners)
+    {
+        const XMVECTOR a = XMLoadFloat3(&vertices[corners[0]]);
+        const XMVECTOR b = XMLoadFloat3(&vertices[corners[1]]);
+        const XMVECTOR c = XMLoadFloat3(&vertices[corners[2]]);
+
+        return XMVector3Normalize(XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a)));
+    }
+}
+
+namespace AoaSampleApp
+{
+    vector<uint32_t> ExtractEdges(vector<XMFLOAT3> const& vertices, vector<uint32_t> const& indices, vector<MeshLevelOfDetail>& ranges, float featureAngle)
+    {
+        // Every corner of every triangle starts an edge, in order of the ranges.
+        vector<EdgeUse> uses;
+        vector<size_t> rangeUseEnds;
+        rangeUseEnds.reserve(ranges.size());
+
+        for (uint32_t r = 0; r < ranges.size(); ++r)
+        {
+            auto const& range = ranges[r];
+            const uint32_t triangleEnd = range.StartIndex + range.IndexCount / 3 * 3;
+            for (uint32_t i = range.StartIndex; i < triangleEnd && i + 2 < indices.size(); i += 3)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    const uint32_t order = static_cast<uint32_t>(uses.size());
+                    uses.push_back({ GetEdgeKey(indices[i + corner], indices[i + (corner + 1) % 3]), order, i, r });
+                }
+            }
+
+            rangeUseEnds.push_back(uses.size());
+        }
+
+        // Group the uses of each edge, first use first, and keep the edge at its first use in each range if it's
+        // a feature.
+        vector<bool> keep(uses.size(), false);
+        {
+            vector<EdgeUse> sorted = uses;
+            sort(sorted.begin(), sorted.end());
+
+            const float minDot = cosf(featureAngle);
+
+            for (size_t first = 0; first < sorted.size();)
+            {
+                size_t last = first + 1;
+                while (last < sorted.size() && sorted[last].Key == sorted[first].Key)
+                {
+                    ++last;
+                }
+
+                bool isFeature = featureAngle <= 0.0f || last - first != 2;
+                if (!isFeature)
+                {
+                    const XMVECTOR n0 = GetTriangleNormal(vertices, &indices[sorted[first].Triangle]);
+                    const XMVECTOR n1 = GetTriangleNormal(vertices, &indices[sorted[first + 1].Triangle]);
+
+                    // Degenerate triangles don't tell which way the surface bends, so their edges are kept.
+                    isFeature =
+                        XMVector3Equal(n0, XMVectorZero()) ||
+                        XMVector3Equal(n1, XMVectorZero()) ||
+                        XMVectorGetX(XMVector3Dot(n0, n1)) < minDot;
+                }
+
+                // Uses of a range are next to each other, since they are ordered by range.
+                for (size_t use = first; use < last; ++use)
+                {
+                    if (use == first || sorted[use].Range != sorted[use - 1].Range)
+                    {
+                        keep[sorted[use].Order] = isFeature;
+                    }
+                }
+
+                first = last;
+            }
+        }
+
+        // Emit the kept edges range by range.
+        vector<uint32_t> lines;
+        lines.reserve(uses.size());
+
+        size_t order = 0;
+        for (size_t r = 0; r < ranges.size(); ++r)
+        {
+            const uint32_t lineStart = static_cast<uint32_t>(lines.size());
+
+            for (; order < rangeUseEnds[r]; ++order)
+            {
+                if (keep[order])
+                {
+                    lines.push_back(static_cast<uint32_t>(uses[order].Key >> 32));
+                    lines.push_back(static_cast<uint32_t>(uses[order].Key));
+                }
+            }
+
+            ranges[r] = { lineStart, static_cast<uint32_t>(lines.size()) - lineStart };
+        }
+
+        return lines;
+    }
+}
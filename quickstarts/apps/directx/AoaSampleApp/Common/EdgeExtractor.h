@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "MeshSimplifier.h"
+
+#include <DirectXMath.h>
+
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Converts ranges of a triangle list into ranges of a line list with the edges of their triangles, so that
+    // each edge is drawn once per range rather than once per triangle sharing it. Ranges are updated to index the
+    // returned line list, and must not overlap.
+    //
+    // Edges shared by triangles of different ranges are kept in each of them, so that every range draws all of
+    // its triangles' edges whichever other ranges are culled. Edges between two triangles whose normals
+    // are less than featureAngle radians apart are dropped, unless featureAngle is zero; edges on a boundary
+    // or shared by more than two triangles are always kept.
+    std::vector<uint32_t> ExtractEdges(
+        std::vector<DirectX::XMFLOAT3> const& vertices,
+        std::vector<uint32_t> const& indices,
+        std::vector<MeshLevelOfDetail>& ranges,
+        float featureAngle);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "FileReader.h"
+#include "DirectFileRead.h"
+
+#include <winrt/Windows.ApplicationModel.h>
+
+using namespace std;
+using namespace winrt::Windows::Foundation;
+using namespace winrt::Windows::Storage;
+
+namespace AoaSampleApp
+{
+    IAsyncAction ThreadPoolFileReader::ReadAsync(winrt::array_view<FileReadRequest> requests)
+    {
+        // Each read switches to the thread pool on its first suspension, so all of them are in flight
+        // before the first one is awaited. Reads don't throw, so none of them is still writing to the
+        // caller's buffers when this completes.
+        vector<IAsyncAction> reads;
+        reads.reserve(requests.size());
+
+        for (auto& request : requests)
+        {
+            reads.emplace_back(ReadFileAsync(request));
+        }
+
+        for (auto const& read : reads)
+        {
+            co_await read;
+        }
+    }
+
+    IAsyncAction ThreadPoolFileReader::ReadFileAsync(FileReadRequest& request)
+    {
+        request.Result = S_OK;
+
+        try
+        {
+            winrt::check_pointer(request.Buffer);
+
+            co_await winrt::resume_background();
+
+            if (TryReadFileDirect(request.Path, *request.Buffer))
+            {
+                co_return;
+            }
+
+            // Brokered locations like known folders may only be accessible through the storage APIs.
+            auto file = request.File ? request.File : co_await StorageFile::GetFileFromPathAsync(request.Path);
+            auto buffer = co_await FileIO::ReadBufferAsync(file);
+
+            request.Buffer->assign(buffer.data(), buffer.data() + buffer.Length());
+        }
+        catch (...)
+        {
+            request.Result = winrt::to_hresult();
+        }
+    }
+
+    IFileReader& GetFileReader()
+    {
+        static ThreadPoolFileReader s_fileReader;
+        return s_fileReader;
+    }
+
+    wstring GetPackageFilePath(wstring_view const& filename)
+    {
+        static const wstring s_installedPath{ winrt::Windows::ApplicationModel::Package::Current().InstalledLocation().Path() };
+        return PathJoin(s_installedPath, wstring(filename));
+    }
+}
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <winrt/Windows.Foundation.h>
+#include <winrt/Windows.Storage.h>
+
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // A read of a whole file into a caller-provided buffer.
+    struct FileReadRequest
+    {
+        // Full path of the file to read.
+        std::wstring Path;
+
+        // Optional storage file for the path, used when the file can't be opened directly.
+        winrt::Windows::Storage::IStorageFile File{ nullptr };
+
+        // Resized to the file size. Reusing a buffer across reads avoids reallocating it.
+        std::vector<uint8_t>* Buffer{ nullptr };
+
+        // Set once the read completes. The buffer holds the file only if the read succeeded.
+        HRESULT Result{ S_OK };
+    };
+
+    // Reads files asynchronously, in batches.
+    class IFileReader
+    {
+    public:
+        virtual ~IFileReader() = default;
+
+        // Issues all reads of the batch at once and completes when all of them are done. Requests and their
+        // buffers must stay alive until the returned action completes. A failed read, e.g. of a file deleted
+        // since it was found, only sets the result of its own request.
+        virtual winrt::Windows::Foundation::IAsyncAction ReadAsync(winrt::array_view<FileReadRequest> requests) = 0;
+    };
+
+    // Reads directly into the caller's buffers with Win32 file APIs on the thread pool, one work item per file.
+    // Files that can't be opened this way, e.g. in brokered locations, are read with the storage APIs instead.
+    class ThreadPoolFileReader : public IFileReader
+    {
+    public:
+        winrt::Windows::Foundation::IAsyncAction ReadAsync(winrt::array_view<FileReadRequest> requests) override;
+
+    private:
+        static winrt::Windows::Foundation::IAsyncAction ReadFileAsync(FileReadRequest& request);
+    };
+
+    // File reader shared by the app.
+    IFileReader& GetFileReader();
+
+    // Full path of a file in the application package, such as compiled shaders.
+    std::wstring GetPackageFilePath(std::wstring_view const& filename);
+}
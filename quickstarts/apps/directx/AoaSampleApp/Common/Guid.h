@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#if __has_include(<winrt/base.h>)
+#include <winrt/base.h>
+#else
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#endif
+
+namespace AoaSampleApp
+{
+#if __has_include(<winrt/base.h>)
+    // Identifies object models in the parts of the sample that also build without WinRT, e.g. for the tests.
+    using Guid = winrt::guid;
+#else
+    // Stands in for winrt::guid where WinRT isn't available, with the same layout.
+    struct Guid
+    {
+        uint32_t Data1;
+        uint16_t Data2;
+        uint16_t Data3;
+        uint8_t Data4[8];
+    };
+
+    inline bool operator==(Guid const& left, Guid const& right)
+    {
+        return memcmp(&left, &right, sizeof(Guid)) == 0;
+    }
+
+    inline bool operator!=(Guid const& left, Guid const& right)
+    {
+        return !(left == right);
+    }
+#endif
+}
+
+#if !__has_include(<winrt/base.h>)
+namespace std
+{
+    template <>
+    struct hash<AoaSampleApp::Guid>
+    {
+        size_t operator()(AoaSampleApp::Guid const& value) const noexcept
+        {
+            uint64_t halves[2];
+            memcpy(halves, &value, sizeof(halves));
+            return hash<uint64_t>{}(halves[0] ^ (halves[1] * 0x9e3779b97f4a7c15ull));
+        }
+    };
+}
+#endif
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "HeadPosePredictor.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace DirectX;
+
+namespace
+{
+    constexpr float c_pi = 3.1415926f;
+    constexpr float c_degreesToRadians = c_pi / 180.0f;
+
+    // Predicted pitch stays short of straight up or down, where yaw is undefined.
+    constexpr float c_maxPitch = 85.0f * c_degreesToRadians;
+
+    float GetYaw(XMFLOAT3 const& direction)
+    {
+        return atan2f(direction.x, direction.z);
+    }
+
+    float GetPitch(XMFLOAT3 const& direction)
+    {
+        return asinf(std::clamp(direction.y, -1.0f, 1.0f));
+    }
+
+    XMVECTOR GetDirection(float yaw, float pitch)
+    {
+        return XMVectorSet(sinf(yaw) * cosf(pitch), sinf(pitch), cosf(yaw) * cosf(pitch), 0.0f);
+    }
+
+    // Signed difference between two angles, in [-pi, pi].
+    float GetAngleDifference(float to, float from)
+    {
+        return remainderf(to - from, 2.0f * c_pi);
+    }
+}
+
+namespace AoaSampleApp
+{
+    HeadPosePredictor::HeadPosePredictor(HeadPosePredictorSettings const& settings)
+        : m_settings(settings)
+    {
+    }
+
+    void HeadPosePredictor::AddHeadPose(XMFLOAT3 const& position, XMFLOAT3 const& forwardDirection, XMFLOAT3 const& upDirection, steady_clock::time_point time)
+    {
+        m_headPoses.push_back({ position, forwardDirection, upDirection, time });
+
+        while (time - m_headPoses.front().Time > m_settings.History)
+        {
+            m_headPoses.pop_front();
+        }
+    }
+
+    optional<PredictedHeadPose> HeadPosePredictor::Predict(steady_clock::duration predictionTime) const
+    {
+        if (m_headPoses.empty())
+        {
+            return nullopt;
+        }
+
+        auto const& latest = m_headPoses.back();
+        const float latestYaw = GetYaw(latest.ForwardDirection);
+
+        PredictedHeadPose predicted{ latest.Position, latest.ForwardDirection, latest.UpDirection };
+
+        //
+        // Fit position, yaw and pitch over time, with time relative to the latest pose.
+        // Yaw is unwrapped around the latest one so that turning past behind the user doesn't jump by 2 pi.
+        //
+
+        const float count = static_cast<float>(m_headPoses.size());
+
+        float meanTime = 0.0f;
+        XMVECTOR meanPosition = XMVectorZero();
+        float meanYaw = 0.0f;
+        float meanPitch = 0.0f;
+
+        for (auto const& sample : m_headPoses)
+        {
+            meanTime += duration<float>(sample.Time - latest.Time).count();
+            meanPosition = XMVectorAdd(meanPosition, XMLoadFloat3(&sample.Position));
+            meanYaw += latestYaw + GetAngleDifference(GetYaw(sample.ForwardDirection), latestYaw);
+            meanPitch += GetPitch(sample.ForwardDirection);
+        }
+
+        meanTime /= count;
+        meanPosition = XMVectorScale(meanPosition, 1.0f / count);
+        meanYaw /= count;
+        meanPitch /= count;
+
+        float timeVariance = 0.0f;
+        XMVECTOR velocity = XMVectorZero();
+        float yawRate = 0.0f;
+        float pitchRate = 0.0f;
+
+        for (auto const& sample : m_headPoses)
+        {
+            const float time = duration<float>(sample.Time - latest.Time).count() - meanTime;
+
+            timeVariance += time * time;
+            velocity = XMVectorMultiplyAdd(XMVectorSubtract(XMLoadFloat3(&sample.Position), meanPosition), XMVectorReplicate(time), velocity);
+            yawRate += (latestYaw + GetAngleDifference(GetYaw(sample.ForwardDirection), latestYaw) - meanYaw) * time;
+            pitchRate += (GetPitch(sample.ForwardDirection) - meanPitch) * time;
+        }
+
+        if (timeVariance <= 0.0f)
+        {
+            // A single pose, or poses all at the same time.
+            return predicted;
+        }
+
+        velocity = XMVectorScale(velocity, 1.0f / timeVariance);
+        yawRate /= timeVariance;
+        pitchRate /= timeVariance;
+
+        const float speed = XMVectorGetX(XMVector3Length(velocity));
+        if (speed > m_settings.MaxSpeed)
+        {
+            velocity = XMVectorScale(velocity, m_settings.MaxSpeed / speed);
+        }
+
+        const float maxAngularSpeed = m_settings.MaxAngularSpeedInDegrees * c_degreesToRadians;
+        yawRate = std::clamp(yawRate, -maxAngularSpeed, maxAngularSpeed);
+        pitchRate = std::clamp(pitchRate, -maxAngularSpeed, maxAngularSpeed);
+
+        //
+        // Extrapolate the fitted lines.
+        //
+
+        const float time = duration<float>(predictionTime).count() - meanTime;
+
+        const XMVECTOR forwardDirection = GetDirection(meanYaw + yawRate * time, std::clamp(meanPitch + pitchRate * time, -c_maxPitch, c_maxPitch));
+
+        XMStoreFloat3(&predicted.Position, XMVectorMultiplyAdd(velocity, XMVectorReplicate(time), meanPosition));
+        XMStoreFloat3(&predicted.ForwardDirection, forwardDirection);
+
+        // Keep the latest up direction, made orthogonal to the predicted forward direction.
+        const XMVECTOR latestUpDirection = XMLoadFloat3(&latest.UpDirection);
+        const XMVECTOR upDirection = XMVectorSubtract(latestUpDirection, XMVectorMultiply(forwardDirection, XMVector3Dot(latestUpDirection, forwardDirection)));
+        if (XMVectorGetX(XMVector3LengthSq(upDirection)) > 0.0f)
+        {
+            XMStoreFloat3(&predicted.UpDirection, XMVector3Normalize(upDirection));
+        }
+
+        return predicted;
+    }
+}
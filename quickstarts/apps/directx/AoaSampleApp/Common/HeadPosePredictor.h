@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <chrono>
+#include <deque>
+#include <optional>
+
+namespace AoaSampleApp
+{
+    struct HeadPosePredictorSettings
+    {
+        // Head poses older than this are ignored, so that the prediction follows changes of direction.
+        std::chrono::milliseconds History{ 500 };
+
+        // Limits of the extrapolated motion, so that tracking glitches don't throw the prediction off.
+        float MaxSpeed{ 2.0f };                         // Meters per second, a brisk walk.
+        float MaxAngularSpeedInDegrees{ 180.0f };       // Degrees per second.
+    };
+
+    struct PredictedHeadPose
+    {
+        DirectX::XMFLOAT3 Position;
+        DirectX::XMFLOAT3 ForwardDirection;
+        DirectX::XMFLOAT3 UpDirection;
+    };
+
+    // Predicts where the user will be and look from recent head poses, so that a search area is placed where
+    // the device will observe during the detection rather than where the user was looking when it started.
+    //
+    // Position, yaw and pitch are each fitted with a line over the history by least squares, which is less
+    // sensitive to the jitter of individual poses than extrapolating from the oldest and latest ones.
+    class HeadPosePredictor
+    {
+    public:
+        HeadPosePredictor(HeadPosePredictorSettings const& settings = {});
+
+        void AddHeadPose(
+            DirectX::XMFLOAT3 const& position,
+            DirectX::XMFLOAT3 const& forwardDirection,
+            DirectX::XMFLOAT3 const& upDirection,
+            std::chrono::steady_clock::time_point time);
+
+        // Returns the head pose expected at the given time after the latest one, or nothing until a head pose is known.
+        std::optional<PredictedHeadPose> Predict(std::chrono::steady_clock::duration predictionTime) const;
+
+    private:
+        struct HeadPoseSample
+        {
+            DirectX::XMFLOAT3 Position;
+            DirectX::XMFLOAT3 ForwardDirection;
+            DirectX::XMFLOAT3 UpDirection;
+            std::chrono::steady_clock::time_point Time;
+        };
+
+        HeadPosePredictorSettings m_settings;
+
+        std::deque<HeadPoseSample> m_headPoses;     // Oldest first.
+    };
+}
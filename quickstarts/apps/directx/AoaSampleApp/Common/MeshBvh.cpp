@@ -0,0 +1,415 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "MeshBvh.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Centroids are binned along each axis to find the cheapest split.
+    constexpr size_t c_binCount = 12;
+
+    // Nodes this small are always leaves, and nodes up to the larger count become leaves when splitting
+    // doesn't pay off.
+    constexpr uint32_t c_minSplitTriangleCount = 2;
+    constexpr uint32_t c_maxLeafTriangleCount = 8;
+
+    // Cost of visiting a node relative to testing a triangle.
+    constexpr float c_traversalCost = 1.0f;
+
+    // Nodes deeper than this are split at their median triangle, which halves them and so bounds the depth of the
+    // hierarchy, and the traversal stack, for any mesh.
+    constexpr uint32_t c_maxHeuristicDepth = 64;
+    constexpr uint32_t c_maxDepth = c_maxHeuristicDepth + 32;
+
+    float Component(XMFLOAT3 const& value, size_t axis)
+    {
+        return axis == 0 ? value.x : axis == 1 ? value.y : value.z;
+    }
+
+    // Half the surface area of a box, which is proportional to the chance that a random ray crossing its
+    // parent crosses it too.
+    float HalfSurfaceArea(FXMVECTOR min, FXMVECTOR max)
+    {
+        XMFLOAT3 extent;
+        XMStoreFloat3(&extent, XMVectorMax(XMVectorSubtract(max, min), XMVectorZero()));
+
+        return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+    }
+
+    struct Bin
+    {
+        XMVECTOR Min;
+        XMVECTOR Max;
+        uint32_t TriangleCount;
+    };
+
+    // Distance at which a ray enters a box before maxDistance, or infinity if it misses the box. The slabs of
+    // all three axes are intersected at once.
+    float EnterBox(XMFLOAT3 const& boxMin, XMFLOAT3 const& boxMax, FXMVECTOR origin, FXMVECTOR inverseDirection, float maxDistance)
+    {
+        const XMVECTOR t0 = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&boxMin), origin), inverseDirection);
+        const XMVECTOR t1 = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&boxMax), origin), inverseDirection);
+
+        const XMVECTOR enters = XMVectorMin(t0, t1);
+        const XMVECTOR exits = XMVectorMax(t0, t1);
+
+        const XMVECTOR enter = XMVectorMax(XMVectorMax(XMVectorSplatX(enters), XMVectorSplatY(enters)), XMVectorSplatZ(enters));
+        const XMVECTOR exit = XMVectorMin(XMVectorMin(XMVectorSplatX(exits), XMVectorSplatY(exits)), XMVectorSplatZ(exits));
+
+        const float enterDistance = (max)(XMVectorGetX(enter), 0.0f);
+        const float exitDistance = (min)(XMVectorGetX(exit), maxDistance);
+
+        return enterDistance <= exitDistance ? enterDistance : numeric_limits<float>::infinity();
+    }
+
+    // Distance at which a ray hits a triangle (Moller and Trumbore), or infinity if it misses it.
+    float IntersectTriangle(XMFLOAT3 const* corners, FXMVECTOR origin, FXMVECTOR direction)
+    {
+        const XMVECTOR a = XMLoadFloat3(&corners[0]);
+        const XMVECTOR edge1 = XMVectorSubtract(XMLoadFloat3(&corners[1]), a);
+        const XMVECTOR edge2 = XMVectorSubtract(XMLoadFloat3(&corners[2]), a);
+
+        const XMVECTOR p = XMVector3Cross(direction, edge2);
+        const float determinant = XMVectorGetX(XMVector3Dot(edge1, p));
+
+        // The ray is parallel to the triangle.
+        if (fabs(determinant) < 1e-12f)
+        {
+            return numeric_limits<float>::infinity();
+        }
+
+        const float inverseDeterminant = 1.0f / determinant;
+        const XMVECTOR s = XMVectorSubtract(origin, a);
+
+        const float u = XMVectorGetX(XMVector3Dot(s, p)) * inverseDeterminant;
+        if (u < 0.0f || u > 1.0f)
+        {
+            return numeric_limits<float>::infinity();
+        }
+
+        const XMVECTOR q = XMVector3Cross(s, edge1);
+
+        const float v = XMVectorGetX(XMVector3Dot(direction, q)) * inverseDeterminant;
+        if (v < 0.0f || u + v > 1.0f)
+        {
+            return numeric_limits<float>::infinity();
+        }
+
+        const float distance = XMVectorGetX(XMVector3Dot(edge2, q)) * inverseDeterminant;
+        return distance >= 0.0f ? distance : numeric_limits<float>::infinity();
+    }
+}
+
+namespace AoaSampleApp
+{
+    MeshBvh::MeshBvh(vector<XMFLOAT3> const& vertices, uint32_t const* indices, size_t indexCount)
+    {
+        const size_t triangleCount = indexCount / 3;
+
+        vector<XMFLOAT3> triangleMins;
+        vector<XMFLOAT3> triangleMaxs;
+        vector<XMFLOAT3> centroids;
+        vector<uint32_t> triangleIds;
+
+        triangleMins.reserve(triangleCount);
+        triangleMaxs.reserve(triangleCount);
+        centroids.reserve(triangleCount);
+        triangleIds.reserve(triangleCount);
+
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            const uint32_t* corners = &indices[t * 3];
+            if (corners[0] >= vertices.size() || corners[1] >= vertices.size() || corners[2] >= vertices.size())
+            {
+                continue;
+            }
+
+            const XMVECTOR a = XMLoadFloat3(&vertices[corners[0]]);
+            const XMVECTOR b = XMLoadFloat3(&vertices[corners[1]]);
+            const XMVECTOR c = XMLoadFloat3(&vertices[corners[2]]);
+
+            XMStoreFloat3(&triangleMins.emplace_back(), XMVectorMin(XMVectorMin(a, b), c));
+            XMStoreFloat3(&triangleMaxs.emplace_back(), XMVectorMax(XMVectorMax(a, b), c));
+            XMStoreFloat3(&centroids.emplace_back(), XMVectorScale(XMVectorAdd(XMVectorAdd(a, b), c), 1.0f / 3.0f));
+            triangleIds.push_back(t);
+        }
+
+        // Triangles are referred to by their position among the valid ones while building.
+        vector<uint32_t> order(triangleIds.size());
+        iota(order.begin(), order.end(), 0u);
+
+        if (order.empty())
+        {
+            return;
+        }
+
+        // A binary tree with a triangle or more per leaf has fewer than twice as many nodes as triangles.
+        m_nodes.reserve(order.size() * 2);
+        m_nodes.push_back({ {}, 0, {}, static_cast<uint32_t>(order.size()) });
+
+        // Nodes left to split, holding their range of the order, with their depth.
+        vector<pair<uint32_t, uint32_t>> pendingNodes{ { 0u, 0u } };
+
+        while (!pendingNodes.empty())
+        {
+            const auto [nodeIndex, depth] = pendingNodes.back();
+            pendingNodes.pop_back();
+
+            const uint32_t first = m_nodes[nodeIndex].First;
+            const uint32_t count = m_nodes[nodeIndex].TriangleCount;
+
+            XMVECTOR boundsMin = g_XMFltMax;
+            XMVECTOR boundsMax = XMVectorNegate(g_XMFltMax);
+            XMVECTOR centroidMin = g_XMFltMax;
+            XMVECTOR centroidMax = XMVectorNegate(g_XMFltMax);
+
+            for (uint32_t i = first; i < first + count; ++i)
+            {
+                const uint32_t t = order[i];
+                const XMVECTOR centroid = XMLoadFloat3(&centroids[t]);
+
+                boundsMin = XMVectorMin(boundsMin, XMLoadFloat3(&triangleMins[t]));
+                boundsMax = XMVectorMax(boundsMax, XMLoadFloat3(&triangleMaxs[t]));
+                centroidMin = XMVectorMin(centroidMin, centroid);
+                centroidMax = XMVectorMax(centroidMax, centroid);
+            }
+
+            XMStoreFloat3(&m_nodes[nodeIndex].Min, boundsMin);
+            XMStoreFloat3(&m_nodes[nodeIndex].Max, boundsMax);
+
+            if (count <= c_minSplitTriangleCount)
+            {
+                continue;
+            }
+
+            XMFLOAT3 centroidLow;
+            XMFLOAT3 centroidHigh;
+            XMStoreFloat3(&centroidLow, centroidMin);
+            XMStoreFloat3(&centroidHigh, centroidMax);
+
+            float bestCost = numeric_limits<float>::infinity();
+            size_t bestAxis = 0;
+            size_t bestSplit = 0;
+
+            for (size_t axis = 0; axis < 3 && depth < c_maxHeuristicDepth; ++axis)
+            {
+                const float low = Component(centroidLow, axis);
+                const float extent = Component(centroidHigh, axis) - low;
+                if (extent <= 0.0f)
+                {
+                    continue;
+                }
+
+                const float binScale = c_binCount / extent;
+
+                array<Bin, c_binCount> bins;
+                for (auto& bin : bins)
+                {
+                    bin = { g_XMFltMax, XMVectorNegate(g_XMFltMax), 0 };
+                }
+
+                for (uint32_t i = first; i < first + count; ++i)
+                {
+                    const uint32_t t = order[i];
+                    auto& bin = bins[(min)(c_binCount - 1, static_cast<size_t>((Component(centroids[t], axis) - low) * binScale))];
+
+                    bin.Min = XMVectorMin(bin.Min, XMLoadFloat3(&triangleMins[t]));
+                    bin.Max = XMVectorMax(bin.Max, XMLoadFloat3(&triangleMaxs[t]));
+                    ++bin.TriangleCount;
+                }
+
+                // Cost of the triangles left of each split, swept from the left, then added to the cost of the
+                // triangles right of it, swept from the right.
+                array<float, c_binCount> leftCosts{};
+                XMVECTOR sweepMin = g_XMFltMax;
+                XMVECTOR sweepMax = XMVectorNegate(g_XMFltMax);
+                uint32_t sweepCount = 0;
+
+                for (size_t split = 1; split < c_binCount; ++split)
+                {
+                    sweepMin = XMVectorMin(sweepMin, bins[split - 1].Min);
+                    sweepMax = XMVectorMax(sweepMax, bins[split - 1].Max);
+                    sweepCount += bins[split - 1].TriangleCount;
+                    leftCosts[split] = sweepCount > 0 ? sweepCount * HalfSurfaceArea(sweepMin, sweepMax) : 0.0f;
+                }
+
+                sweepMin = g_XMFltMax;
+                sweepMax = XMVectorNegate(g_XMFltMax);
+                sweepCount = 0;
+
+                for (size_t split = c_binCount - 1; split > 0; --split)
+                {
+                    sweepMin = XMVectorMin(sweepMin, bins[split].Min);
+                    sweepMax = XMVectorMax(sweepMax, bins[split].Max);
+                    sweepCount += bins[split].TriangleCount;
+
+                    // Splits with every triangle on one side don't divide the node.
+                    if (sweepCount == 0 || sweepCount == count)
+                    {
+                        continue;
+                    }
+
+                    const float cost = leftCosts[split] + sweepCount * HalfSurfaceArea(sweepMin, sweepMax);
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+
+            const float nodeArea = HalfSurfaceArea(boundsMin, boundsMax);
+            const bool isSplitCheaper = c_traversalCost * nodeArea + bestCost < count * nodeArea;
+
+            if (count <= c_maxLeafTriangleCount && !isSplitCheaper)
+            {
+                continue;
+            }
+
+            auto const begin = order.begin() + first;
+            auto const end = begin + count;
+            uint32_t leftCount;
+
+            if (bestSplit > 0)
+            {
+                const float low = Component(centroidLow, bestAxis);
+                const float binScale = c_binCount / (Component(centroidHigh, bestAxis) - low);
+
+                leftCount = static_cast<uint32_t>(partition(begin, end, [&](uint32_t t)
+                {
+                    return (min)(c_binCount - 1, static_cast<size_t>((Component(centroids[t], bestAxis) - low) * binScale)) < bestSplit;
+                }) - begin);
+            }
+            else
+            {
+                // Without a useful split, such as when all centroids are the same, split at the median along
+                // the longest axis of the centroids.
+                const XMFLOAT3 extent{ centroidHigh.x - centroidLow.x, centroidHigh.y - centroidLow.y, centroidHigh.z - centroidLow.z };
+                const size_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+
+                leftCount = count / 2;
+                nth_element(begin, begin + leftCount, end, [&](uint32_t a, uint32_t b)
+                {
+                    return Component(centroids[a], axis) < Component(centroids[b], axis);
+                });
+            }
+
+            const uint32_t childIndex = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.push_back({ {}, first, {}, leftCount });
+            m_nodes.push_back({ {}, first + leftCount, {}, count - leftCount });
+
+            m_nodes[nodeIndex].First = childIndex;
+            m_nodes[nodeIndex].TriangleCount = 0;
+
+            pendingNodes.emplace_back(childIndex, depth + 1);
+            pendingNodes.emplace_back(childIndex + 1, depth + 1);
+        }
+
+        m_nodes.shrink_to_fit();
+
+        // Leaf ranges are final, so triangles are laid out in leaf order.
+        m_corners.reserve(order.size() * 3);
+        m_triangleIds.reserve(order.size());
+
+        for (const uint32_t t : order)
+        {
+            const uint32_t triangle = triangleIds[t];
+            for (size_t i = 0; i < 3; ++i)
+            {
+                m_corners.push_back(vertices[indices[triangle * 3 + i]]);
+            }
+
+            m_triangleIds.push_back(triangle);
+        }
+    }
+
+    optional<MeshRayHit> MeshBvh::Intersect(FXMVECTOR origin, FXMVECTOR direction, float maxDistance) const
+    {
+        if (m_nodes.empty())
+        {
+            return nullopt;
+        }
+
+        const XMVECTOR inverseDirection = XMVectorReciprocal(direction);
+
+        optional<MeshRayHit> hit;
+        float nearestDistance = maxDistance;
+
+        // Nodes still to visit, farther ones first, with the distance at which the ray enters them.
+        array<pair<uint32_t, float>, c_maxDepth + 1> pendingNodes;
+        size_t pendingCount = 0;
+
+        const float rootDistance = EnterBox(m_nodes[0].Min, m_nodes[0].Max, origin, inverseDirection, nearestDistance);
+        if (rootDistance != numeric_limits<float>::infinity())
+        {
+            pendingNodes[pendingCount++] = { 0u, rootDistance };
+        }
+
+        while (pendingCount > 0)
+        {
+            const auto [nodeIndex, enterDistance] = pendingNodes[--pendingCount];
+
+            // A nearer hit was found since the node was reached.
+            if (enterDistance > nearestDistance)
+            {
+                continue;
+            }
+
+            const Node* node = &m_nodes[nodeIndex];
+
+            // Descend into the nearer child, leaving the farther one for later, until reaching a leaf.
+            while (node->TriangleCount == 0)
+            {
+                const Node& left = m_nodes[node->First];
+                const Node& right = m_nodes[node->First + 1];
+
+                const float leftDistance = EnterBox(left.Min, left.Max, origin, inverseDirection, nearestDistance);
+                const float rightDistance = EnterBox(right.Min, right.Max, origin, inverseDirection, nearestDistance);
+
+                if (leftDistance == numeric_limits<float>::infinity() && rightDistance == numeric_limits<float>::infinity())
+                {
+                    node = nullptr;
+                    break;
+                }
+
+                if (leftDistance <= rightDistance)
+                {
+                    if (rightDistance != numeric_limits<float>::infinity())
+                    {
+                        pendingNodes[pendingCount++] = { node->First + 1, rightDistance };
+                    }
+                    node = &left;
+                }
+                else
+                {
+                    if (leftDistance != numeric_limits<float>::infinity())
+                    {
+                        pendingNodes[pendingCount++] = { node->First, leftDistance };
+                    }
+                    node = &right;
+                }
+            }
+
+            if (!node)
+            {
+                continue;
+            }
+
+            for (uint32_t i = node->First; i < node->First + node->TriangleCount; ++i)
+            {
+                const float distance = IntersectTriangle(&m_corners[i * 3], origin, direction);
+                if (distance < nearestDistance)
+                {
+                    nearestDistance = distance;
+                    hit = MeshRayHit{ distance, m_triangleIds[i] };
+                }
+            }
+        }
+
+        return hit;
+    }
+}
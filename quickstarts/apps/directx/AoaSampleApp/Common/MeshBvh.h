@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <optional>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Where a ray first hits a mesh.
+    struct MeshRayHit
+    {
+        // Distance along the ray, in lengths of its direction.
+        float Distance;
+
+        // Index of the triangle hit in the triangle list the hierarchy was built from.
+        uint32_t Triangle;
+    };
+
+    // Bounding volume hierarchy over the triangles of a mesh, to find where rays hit it without testing
+    // each triangle.
+    //
+    // Nodes are split where the surface area heuristic finds the cheapest split among a few bins of triangle
+    // centroids along each axis, and triangles are copied into leaf order so that traversal reads them in sequence.
+    class MeshBvh
+    {
+    public:
+        MeshBvh(
+            std::vector<DirectX::XMFLOAT3> const& vertices,
+            uint32_t const* indices,
+            size_t indexCount);
+
+        // Nearest hit of the ray within maxDistance, from either side of the triangles.
+        std::optional<MeshRayHit> Intersect(
+            DirectX::FXMVECTOR origin,
+            DirectX::FXMVECTOR direction,
+            float maxDistance) const;
+
+        size_t GetNodeCount() const { return m_nodes.size(); }
+        size_t GetTriangleCount() const { return m_triangleIds.size(); }
+
+    private:
+        // Inner nodes have no triangles, and their children are next to each other starting at First.
+        struct Node
+        {
+            DirectX::XMFLOAT3 Min;
+            uint32_t First;
+            DirectX::XMFLOAT3 Max;
+            uint32_t TriangleCount;
+        };
+
+        std::vector<Node> m_nodes;
+
+        // Corners of the triangles in leaf order, and the index of each triangle in the original list.
+        std::vector<DirectX::XMFLOAT3> m_corners;
+        std::vector<uint32_t> m_triangleIds;
+    };
+}
@@ -0,0 +1,326 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "MeshOptimizer.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Scoring of the vertex cache optimization, as tuned by Forsyth.
+    constexpr size_t c_scoredCacheSize = 32;
+    constexpr float c_cacheDecayPower = 1.5f;
+    constexpr float c_lastTriangleScore = 0.75f;
+    constexpr float c_valenceBoostScale = 2.0f;
+    constexpr float c_valenceBoostPower = 0.5f;
+
+    constexpr uint32_t c_noTriangle = UINT32_MAX;
+
+    // Positions compare by bits, with negative zero turned into zero.
+    struct PositionKey
+    {
+        array<uint32_t, 3> Bits;
+
+        explicit PositionKey(XMFLOAT3 const& position)
+        {
+            const array<float, 3> values = { position.x + 0.0f, position.y + 0.0f, position.z + 0.0f };
+            memcpy(Bits.data(), values.data(), sizeof(Bits));
+        }
+
+        bool operator==(PositionKey const& other) const { return Bits == other.Bits; }
+    };
+
+    struct PositionKeyHash
+    {
+        size_t operator()(PositionKey const& key) const
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (const uint32_t bits : key.Bits)
+            {
+                hash = (hash ^ bits) * 1099511628211ull;
+            }
+
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    // Vertices in the last three cache positions were used by the last triangle, and get a fixed score so that
+    // the next triangle doesn't favor one of them. Vertices with few triangles left get a boost, so that they
+    // are finished off rather than left to be transformed again later.
+    float GetVertexScore(int cachePosition, uint32_t remainingTriangleCount)
+    {
+        if (remainingTriangleCount == 0)
+        {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                score = c_lastTriangleScore;
+            }
+            else
+            {
+                const float scale = 1.0f / (c_scoredCacheSize - 3);
+                score = powf(1.0f - (cachePosition - 3) * scale, c_cacheDecayPower);
+            }
+        }
+
+        return score + c_valenceBoostScale * powf(static_cast<float>(remainingTriangleCount), -c_valenceBoostPower);
+    }
+}
+
+namespace AoaSampleApp
+{
+    void WeldVertices(vector<XMFLOAT3>& vertices, vector<uint32_t>& indices)
+    {
+        unordered_map<PositionKey, uint32_t, PositionKeyHash> welded;
+        welded.reserve(vertices.size());
+
+        // Vertices are first numbered by position, with the first vertex of each position to take it from.
+        vector<uint32_t> positionVertices;
+        positionVertices.reserve(vertices.size());
+
+        vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+        vector<uint32_t> weldedIndices;
+        weldedIndices.reserve(indices.size());
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            array<uint32_t, 3> corners;
+            bool isValid = true;
+
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t index = indices[i + corner];
+                if (index >= vertices.size())
+                {
+                    isValid = false;
+                    break;
+                }
+
+                if (remap[index] == UINT32_MAX)
+                {
+                    auto [it, inserted] = welded.try_emplace(PositionKey(vertices[index]), static_cast<uint32_t>(positionVertices.size()));
+                    if (inserted)
+                    {
+                        positionVertices.push_back(index);
+                    }
+
+                    remap[index] = it->second;
+                }
+
+                corners[corner] = remap[index];
+            }
+
+            if (isValid && corners[0] != corners[1] && corners[1] != corners[2] && corners[2] != corners[0])
+            {
+                weldedIndices.insert(weldedIndices.end(), corners.cbegin(), corners.cend());
+            }
+        }
+
+        // Then renumbered in the order the kept triangles use them, which drops those only removed triangles used.
+        vector<uint32_t> compacted(positionVertices.size(), UINT32_MAX);
+        vector<XMFLOAT3> weldedVertices;
+        weldedVertices.reserve(positionVertices.size());
+
+        for (uint32_t& index : weldedIndices)
+        {
+            if (compacted[index] == UINT32_MAX)
+            {
+                compacted[index] = static_cast<uint32_t>(weldedVertices.size());
+                weldedVertices.push_back(vertices[positionVertices[index]]);
+            }
+
+            index = compacted[index];
+        }
+
+        vertices = std::move(weldedVertices);
+        indices = std::move(weldedIndices);
+    }
+
+    void OptimizeVertexCache(uint32_t* indices, size_t indexCount)
+    {
+        const size_t triangleCount = indexCount / 3;
+        if (triangleCount < 2)
+        {
+            return;
+        }
+
+        // Vertices of the range, numbered from zero in index order.
+        vector<uint32_t> rangeVertices(indices, indices + triangleCount * 3);
+        sort(rangeVertices.begin(), rangeVertices.end());
+        rangeVertices.erase(unique(rangeVertices.begin(), rangeVertices.end()), rangeVertices.end());
+
+        vector<uint32_t> corners(triangleCount * 3);
+        for (size_t i = 0; i < corners.size(); ++i)
+        {
+            corners[i] = static_cast<uint32_t>(lower_bound(rangeVertices.cbegin(), rangeVertices.cend(), indices[i]) - rangeVertices.cbegin());
+        }
+
+        const size_t vertexCount = rangeVertices.size();
+
+        // Triangles not yet emitted per vertex, as slices of one list that shrink as triangles are emitted.
+        vector<uint32_t> remainingTriangleCounts(vertexCount, 0);
+        for (const uint32_t vertex : corners)
+        {
+            ++remainingTriangleCounts[vertex];
+        }
+
+        vector<uint32_t> vertexTriangleOffsets(vertexCount + 1, 0);
+        partial_sum(remainingTriangleCounts.cbegin(), remainingTriangleCounts.cend(), vertexTriangleOffsets.begin() + 1);
+
+        vector<uint32_t> vertexTriangles(corners.size());
+        {
+            vector<uint32_t> next(vertexTriangleOffsets.cbegin(), vertexTriangleOffsets.cend() - 1);
+            for (size_t i = 0; i < corners.size(); ++i)
+            {
+                vertexTriangles[next[corners[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        vector<int> cachePositions(vertexCount, -1);
+        vector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            vertexScores[v] = GetVertexScore(-1, remainingTriangleCounts[v]);
+        }
+
+        vector<float> triangleScores(triangleCount);
+        vector<bool> emitted(triangleCount, false);
+
+        uint32_t bestTriangle = 0;
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            triangleScores[t] = vertexScores[corners[t * 3]] + vertexScores[corners[t * 3 + 1]] + vertexScores[corners[t * 3 + 2]];
+            if (triangleScores[t] > triangleScores[bestTriangle])
+            {
+                bestTriangle = t;
+            }
+        }
+
+        vector<uint32_t> cache;
+        vector<uint32_t> nextCache;
+        cache.reserve(c_scoredCacheSize + 3);
+        nextCache.reserve(c_scoredCacheSize + 3);
+
+        vector<uint32_t> order;
+        order.reserve(triangleCount);
+
+        // Where to look for a triangle to restart from when the cache has none left.
+        uint32_t restartCursor = 0;
+
+        while (order.size() < triangleCount)
+        {
+            if (bestTriangle == c_noTriangle)
+            {
+                while (emitted[restartCursor])
+                {
+                    ++restartCursor;
+                }
+
+                bestTriangle = restartCursor;
+            }
+
+            const uint32_t* triangle = &corners[bestTriangle * 3];
+            emitted[bestTriangle] = true;
+            order.push_back(bestTriangle);
+
+            // Remove the triangle from its vertices.
+            for (size_t corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t vertex = triangle[corner];
+                const auto first = vertexTriangles.begin() + vertexTriangleOffsets[vertex];
+                const auto last = first + remainingTriangleCounts[vertex];
+
+                iter_swap(find(first, last, bestTriangle), last - 1);
+                --remainingTriangleCounts[vertex];
+            }
+
+            // Its vertices move to the front of the cache.
+            nextCache.assign(triangle, triangle + 3);
+            for (const uint32_t vertex : cache)
+            {
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                {
+                    nextCache.push_back(vertex);
+                }
+            }
+
+            for (size_t i = 0; i < nextCache.size(); ++i)
+            {
+                cachePositions[nextCache[i]] = i < c_scoredCacheSize ? static_cast<int>(i) : -1;
+            }
+
+            // Rescore the vertices in or just out of the cache, and the triangles that use them.
+            bestTriangle = c_noTriangle;
+            float bestScore = -1.0f;
+
+            for (const uint32_t vertex : nextCache)
+            {
+                vertexScores[vertex] = GetVertexScore(cachePositions[vertex], remainingTriangleCounts[vertex]);
+            }
+
+            for (const uint32_t vertex : nextCache)
+            {
+                const uint32_t first = vertexTriangleOffsets[vertex];
+                for (uint32_t i = first; i < first + remainingTriangleCounts[vertex]; ++i)
+                {
+                    const uint32_t t = vertexTriangles[i];
+                    triangleScores[t] = vertexScores[corners[t * 3]] + vertexScores[corners[t * 3 + 1]] + vertexScores[corners[t * 3 + 2]];
+
+                    if (triangleScores[t] > bestScore)
+                    {
+                        bestScore = triangleScores[t];
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            if (nextCache.size() > c_scoredCacheSize)
+            {
+                nextCache.resize(c_scoredCacheSize);
+            }
+
+            swap(cache, nextCache);
+        }
+
+        vector<uint32_t> reordered;
+        reordered.reserve(triangleCount * 3);
+        for (const uint32_t t : order)
+        {
+            reordered.insert(reordered.end(), indices + t * 3, indices + t * 3 + 3);
+        }
+
+        copy(reordered.cbegin(), reordered.cend(), indices);
+    }
+
+    float GetAverageCacheMissRatio(uint32_t const* indices, size_t indexCount, size_t primitiveVertexCount, size_t cacheSize)
+    {
+        const size_t primitiveCount = primitiveVertexCount == 0 ? 0 : indexCount / primitiveVertexCount;
+        if (primitiveCount == 0 || cacheSize == 0)
+        {
+            return 0.0f;
+        }
+
+        // Ring buffer of the vertices in the cache, oldest at the cursor.
+        vector<uint32_t> cache(cacheSize, UINT32_MAX);
+        size_t cursor = 0;
+        size_t missCount = 0;
+
+        for (size_t i = 0; i < primitiveCount * primitiveVertexCount; ++i)
+        {
+            if (find(cache.cbegin(), cache.cend(), indices[i]) == cache.cend())
+            {
+                cache[cursor] = indices[i];
+                cursor = (cursor + 1) % cacheSize;
+                ++missCount;
+            }
+        }
+
+        return static_cast<float>(missCount) / primitiveCount;
+    }
+}
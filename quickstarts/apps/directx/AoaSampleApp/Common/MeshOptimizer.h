@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Merges vertices with the same position into one, remapping the indices of a triangle list, and removes
+    // the triangles left with a repeated vertex. Vertices keep the order in which they are first used, and those
+    // no remaining triangle uses are dropped.
+    void WeldVertices(
+        std::vector<DirectX::XMFLOAT3>& vertices,
+        std::vector<uint32_t>& indices);
+
+    // Reorders the triangles of a triangle list so that they reuse the vertices of recent triangles, which the
+    // GPU keeps transformed in its post-transform cache (Forsyth, "Linear-Speed Vertex Cache Optimisation").
+    //
+    // Only the indices in the given range are considered, so ranges such as meshlets keep their triangles.
+    void OptimizeVertexCache(
+        uint32_t* indices,
+        size_t indexCount);
+
+    // Vertices transformed per primitive for a list of primitives of primitiveVertexCount vertices each, 3 for
+    // triangles and 2 for lines, with a first-in first-out post-transform cache of the given size. For triangles,
+    // it ranges from 3 for no reuse down to about 0.5 for large regular meshes.
+    float GetAverageCacheMissRatio(
+        uint32_t const* indices,
+        size_t indexCount,
+        size_t primitiveVertexCount,
+        size_t cacheSize);
+}
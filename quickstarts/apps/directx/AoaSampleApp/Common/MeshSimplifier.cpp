@@ -0,0 +1,379 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "MeshSimplifier.h"
+
+#include <queue>
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Levels of detail stop before getting this coarse.
+    constexpr size_t c_minTriangleCount = 64;
+
+    // Weight of the planes that hold boundary edges in place, relative to the area weight of triangle planes.
+    constexpr double c_boundaryWeight = 10.0;
+
+    struct Vector
+    {
+        double X, Y, Z;
+    };
+
+    Vector ToVector(XMFLOAT3 const& value)
+    {
+        return { value.x, value.y, value.z };
+    }
+
+    Vector operator-(Vector const& a, Vector const& b)
+    {
+        return { a.X - b.X, a.Y - b.Y, a.Z - b.Z };
+    }
+
+    Vector operator*(Vector const& a, double b)
+    {
+        return { a.X * b, a.Y * b, a.Z * b };
+    }
+
+    Vector Cross(Vector const& a, Vector const& b)
+    {
+        return { a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+    }
+
+    double Dot(Vector const& a, Vector const& b)
+    {
+        return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+    }
+
+    // Sum of squared distances to a set of planes, as the upper triangle of a symmetric 4x4 matrix.
+    struct Quadric
+    {
+        // aa, ab, ac, ad, bb, bc, bd, cc, cd, dd
+        array<double, 10> Values{};
+
+        // Plane a * x + b * y + c * z + d = 0 with a unit normal.
+        static Quadric FromPlane(Vector const& normal, double d, double weight)
+        {
+            const double a = normal.X;
+            const double b = normal.Y;
+            const double c = normal.Z;
+
+            Quadric quadric;
+            quadric.Values = { a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d };
+            for (auto& value : quadric.Values)
+            {
+                value *= weight;
+            }
+
+            return quadric;
+        }
+
+        Quadric& operator+=(Quadric const& other)
+        {
+            for (size_t i = 0; i < Values.size(); ++i)
+            {
+                Values[i] += other.Values[i];
+            }
+
+            return *this;
+        }
+
+        // Plane through the point, or nothing if the normal is zero.
+        static Quadric FromPoint(Vector const& normal, Vector const& point, double weight)
+        {
+            const double length = sqrt(Dot(normal, normal));
+            if (length == 0.0)
+            {
+                return {};
+            }
+
+            const Vector unitNormal = normal * (1.0 / length);
+            return FromPlane(unitNormal, -Dot(unitNormal, point), weight);
+        }
+
+        double Evaluate(Vector const& p) const
+        {
+            auto const& q = Values;
+            return
+                q[0] * p.X * p.X + 2.0 * q[1] * p.X * p.Y + 2.0 * q[2] * p.X * p.Z + 2.0 * q[3] * p.X +
+                q[4] * p.Y * p.Y + 2.0 * q[5] * p.Y * p.Z + 2.0 * q[6] * p.Y +
+                q[7] * p.Z * p.Z + 2.0 * q[8] * p.Z +
+                q[9];
+        }
+    };
+
+    // Moves a vertex onto a neighbor. Versions tell whether either vertex changed since the cost was computed.
+    struct Collapse
+    {
+        double Cost;
+        uint32_t From;
+        uint32_t To;
+        uint32_t FromVersion;
+        uint32_t ToVersion;
+
+        bool operator>(Collapse const& other) const { return Cost > other.Cost; }
+    };
+}
+
+namespace AoaSampleApp
+{
+    vector<uint32_t> SimplifyMesh(vector<XMFLOAT3> const& vertices, vector<uint32_t> const& indices, size_t targetTriangleCount)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount <= targetTriangleCount)
+        {
+            return indices;
+        }
+
+        vector<uint32_t> triangles(indices.cbegin(), indices.cbegin() + triangleCount * 3);
+        vector<bool> removedTriangles(triangleCount, false);
+        vector<vector<uint32_t>> vertexTriangles(vertices.size());
+        vector<Quadric> quadrics(vertices.size());
+
+        size_t remainingTriangleCount = 0;
+
+        const auto getEdgeKey = [](uint32_t a, uint32_t b)
+        {
+            return (static_cast<uint64_t>((min)(a, b)) << 32) | (max)(a, b);
+        };
+
+        // Number of triangles on each edge, to find the boundary.
+        unordered_map<uint64_t, uint32_t> edgeTriangleCounts;
+
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            const uint32_t* corners = &triangles[t * 3];
+            if (corners[0] >= vertices.size() || corners[1] >= vertices.size() || corners[2] >= vertices.size() ||
+                corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0])
+            {
+                removedTriangles[t] = true;
+                continue;
+            }
+
+            const Vector a = ToVector(vertices[corners[0]]);
+            const Vector normal = Cross(ToVector(vertices[corners[1]]) - a, ToVector(vertices[corners[2]]) - a);
+
+            // Planes are weighted by the triangle area, so that slivers don't hold up collapses.
+            const Quadric quadric = Quadric::FromPoint(normal, a, 0.5 * sqrt(Dot(normal, normal)));
+
+            for (size_t i = 0; i < 3; ++i)
+            {
+                quadrics[corners[i]] += quadric;
+                vertexTriangles[corners[i]].push_back(t);
+                ++edgeTriangleCounts[getEdgeKey(corners[i], corners[(i + 1) % 3])];
+            }
+
+            ++remainingTriangleCount;
+        }
+
+        // Boundary edges add a plane through the edge, perpendicular to their triangle, so that collapses don't
+        // pull the boundary inwards, where the triangle planes alone see no error on a flat mesh.
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            if (removedTriangles[t])
+            {
+                continue;
+            }
+
+            const uint32_t* corners = &triangles[t * 3];
+            const Vector a = ToVector(vertices[corners[0]]);
+            const Vector normal = Cross(ToVector(vertices[corners[1]]) - a, ToVector(vertices[corners[2]]) - a);
+
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const uint32_t from = corners[i];
+                const uint32_t to = corners[(i + 1) % 3];
+                if (edgeTriangleCounts[getEdgeKey(from, to)] != 1)
+                {
+                    continue;
+                }
+
+                const Vector start = ToVector(vertices[from]);
+                const Vector edge = ToVector(vertices[to]) - start;
+
+                // Weighted by the squared edge length, in units of area like the triangle planes.
+                const Quadric quadric = Quadric::FromPoint(Cross(edge, normal), start, c_boundaryWeight * Dot(edge, edge));
+                quadrics[from] += quadric;
+                quadrics[to] += quadric;
+            }
+        }
+
+        vector<uint32_t> versions(vertices.size(), 0);
+        vector<bool> removedVertices(vertices.size(), false);
+
+        priority_queue<Collapse, vector<Collapse>, greater<Collapse>> collapses;
+
+        // Collapse in the direction with the smaller error.
+        const auto pushCollapse = [&](uint32_t a, uint32_t b)
+        {
+            if (a == b)
+            {
+                return;
+            }
+
+            Quadric quadric = quadrics[a];
+            quadric += quadrics[b];
+
+            const double costToA = quadric.Evaluate(ToVector(vertices[a]));
+            const double costToB = quadric.Evaluate(ToVector(vertices[b]));
+
+            collapses.push(costToA <= costToB ?
+                Collapse{ costToA, b, a, versions[b], versions[a] } :
+                Collapse{ costToB, a, b, versions[a], versions[b] });
+        };
+
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            if (!removedTriangles[t])
+            {
+                pushCollapse(triangles[t * 3], triangles[t * 3 + 1]);
+                pushCollapse(triangles[t * 3 + 1], triangles[t * 3 + 2]);
+                pushCollapse(triangles[t * 3 + 2], triangles[t * 3]);
+            }
+        }
+
+        // Whether moving the vertex would turn any of its triangles over, other than the ones the collapse removes.
+        const auto flipsTriangle = [&](uint32_t from, uint32_t to)
+        {
+            for (const uint32_t t : vertexTriangles[from])
+            {
+                const uint32_t* corners = &triangles[t * 3];
+                if (removedTriangles[t] || corners[0] == to || corners[1] == to || corners[2] == to)
+                {
+                    continue;
+                }
+
+                array<Vector, 3> positions;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    positions[i] = ToVector(vertices[corners[i]]);
+                }
+
+                const Vector normal = Cross(positions[1] - positions[0], positions[2] - positions[0]);
+
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    if (corners[i] == from)
+                    {
+                        positions[i] = ToVector(vertices[to]);
+                    }
+                }
+
+                if (Dot(normal, Cross(positions[1] - positions[0], positions[2] - positions[0])) <= 0.0)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+        while (remainingTriangleCount > targetTriangleCount && !collapses.empty())
+        {
+            const Collapse collapse = collapses.top();
+            collapses.pop();
+
+            if (collapse.From == collapse.To || removedVertices[collapse.From] || removedVertices[collapse.To] ||
+                versions[collapse.From] != collapse.FromVersion || versions[collapse.To] != collapse.ToVersion)
+            {
+                continue;
+            }
+
+            if (flipsTriangle(collapse.From, collapse.To))
+            {
+                continue;
+            }
+
+            // Move the vertex onto its neighbor, removing the triangles along the edge.
+            auto& toTriangles = vertexTriangles[collapse.To];
+
+            for (const uint32_t t : vertexTriangles[collapse.From])
+            {
+                if (removedTriangles[t])
+                {
+                    continue;
+                }
+
+                uint32_t* corners = &triangles[t * 3];
+                const bool hasTo = corners[0] == collapse.To || corners[1] == collapse.To || corners[2] == collapse.To;
+
+                if (hasTo)
+                {
+                    removedTriangles[t] = true;
+                    --remainingTriangleCount;
+                    continue;
+                }
+
+                replace(corners, corners + 3, collapse.From, collapse.To);
+                toTriangles.push_back(t);
+            }
+
+            vertexTriangles[collapse.From].clear();
+            vertexTriangles[collapse.From].shrink_to_fit();
+            removedVertices[collapse.From] = true;
+
+            quadrics[collapse.To] += quadrics[collapse.From];
+            ++versions[collapse.To];
+
+            toTriangles.erase(remove_if(toTriangles.begin(), toTriangles.end(), [&](uint32_t t) { return removedTriangles[t]; }), toTriangles.end());
+
+            // Costs of the edges around the moved vertex changed.
+            for (const uint32_t t : toTriangles)
+            {
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    const uint32_t neighbor = triangles[t * 3 + i];
+                    if (neighbor != collapse.To)
+                    {
+                        pushCollapse(collapse.To, neighbor);
+                    }
+                }
+            }
+        }
+
+        vector<uint32_t> simplified;
+        simplified.reserve(remainingTriangleCount * 3);
+
+        for (uint32_t t = 0; t < triangleCount; ++t)
+        {
+            if (!removedTriangles[t])
+            {
+                simplified.insert(simplified.end(), triangles.cbegin() + t * 3, triangles.cbegin() + t * 3 + 3);
+            }
+        }
+
+        return simplified;
+    }
+
+    vector<MeshLevelOfDetail> BuildMeshLevelsOfDetail(vector<XMFLOAT3> const& vertices, vector<uint32_t>& indices, size_t levelCount)
+    {
+        vector<MeshLevelOfDetail> levels{ { 0, static_cast<uint32_t>(indices.size()) } };
+
+        // Each level is simplified from the previous one, which is cheaper than starting over from the original.
+        vector<uint32_t> previous = indices;
+        size_t targetTriangleCount = indices.size() / 3;
+
+        while (levels.size() < levelCount)
+        {
+            targetTriangleCount /= 4;
+            if (targetTriangleCount < c_minTriangleCount)
+            {
+                break;
+            }
+
+            auto simplified = SimplifyMesh(vertices, previous, targetTriangleCount);
+            if (simplified.size() >= previous.size())
+            {
+                break;
+            }
+
+            levels.push_back({ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(simplified.size()) });
+            indices.insert(indices.end(), simplified.cbegin(), simplified.cend());
+
+            previous = std::move(simplified);
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // A range of an index buffer holding one level of detail of a mesh.
+    struct MeshLevelOfDetail
+    {
+        uint32_t StartIndex;
+        uint32_t IndexCount;
+    };
+
+    // Simplifies a triangle mesh by collapsing the edges whose quadric error is the smallest (Garland and Heckbert).
+    //
+    // Each collapse moves a vertex onto one of its neighbors rather than to an optimal position, so simplified
+    // triangles index the original vertices and all levels of detail share one vertex buffer.
+    // Boundary edges are held in place by planes through them, perpendicular to their triangle. Triangles with
+    // a repeated index are dropped. Collapses that would flip a triangle are skipped, so the result may have more
+    // triangles than targeted.
+    std::vector<uint32_t> SimplifyMesh(
+        std::vector<DirectX::XMFLOAT3> const& vertices,
+        std::vector<uint32_t> const& indices,
+        size_t targetTriangleCount);
+
+    // Appends levels of detail of a triangle mesh to the indices, each with a quarter of the triangles of the
+    // previous one, until there are levelCount levels or the mesh gets too small. The original mesh is the first level.
+    std::vector<MeshLevelOfDetail> BuildMeshLevelsOfDetail(
+        std::vector<DirectX::XMFLOAT3> const& vertices,
+        std::vector<uint32_t>& indices,
+        size_t levelCount);
+}
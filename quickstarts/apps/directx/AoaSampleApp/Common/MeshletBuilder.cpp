@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "MeshletBuilder.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Normal cones with a normal at this cosine from the axis or wider, i.e. a quarter turn, can't cull.
+    constexpr float c_minConeSpread = 0.0f;
+
+    // Interleaves the low 10 bits of each coordinate.
+    uint32_t GetMortonCode(uint32_t x, uint32_t y, uint32_t z)
+    {
+        const auto spread = [](uint32_t value)
+        {
+            value &= 0x3ff;
+            value = (value | (value << 16)) & 0x030000ff;
+            value = (value | (value << 8)) & 0x0300f00f;
+            value = (value | (value << 4)) & 0x030c30c3;
+            value = (value | (value << 2)) & 0x09249249;
+            return value;
+        };
+
+        return (spread(x) << 2) | (spread(y) << 1) | spread(z);
+    }
+
+    // Unit normal of a triangle, or zero if it is degenerate.
+    XMVECTOR GetTriangleNormal(vector<XMFLOAT3> const& vertices, uint32_t const* corners)
+    {
+        const XMVECTOR a = XMLoadFloat3(&vertices[corners[0]]);
+        const XMVECTOR b = XMLoadFloat3(&vertices[corners[1]]);
+        const XMVECTOR c = XMLoadFloat3(&vertices[corners[2]]);
+
+        return XMVector3Normalize(XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a)));
+    }
+
+    void ComputeBounds(vector<XMFLOAT3> const& vertices, uint32_t const* triangles, size_t triangleCount, AoaSampleApp::Meshlet& meshlet)
+    {
+        XMVECTOR minimum = g_XMFltMax;
+        XMVECTOR maximum = XMVectorNegate(g_XMFltMax);
+        XMVECTOR normalSum = XMVectorZero();
+
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            const XMVECTOR vertex = XMLoadFloat3(&vertices[triangles[i]]);
+            minimum = XMVectorMin(minimum, vertex);
+            maximum = XMVectorMax(maximum, vertex);
+        }
+
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            normalSum = XMVectorAdd(normalSum, GetTriangleNormal(vertices, triangles + t * 3));
+        }
+
+        const XMVECTOR center = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+        XMVECTOR radiusSquared = XMVectorZero();
+
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            radiusSquared = XMVectorMax(radiusSquared, XMVector3LengthSq(XMVectorSubtract(XMLoadFloat3(&vertices[triangles[i]]), center)));
+        }
+
+        XMStoreFloat3(&meshlet.Center, center);
+        meshlet.Radius = sqrtf(XMVectorGetX(radiusSquared));
+
+        meshlet.ConeAxis = { 0.0f, 0.0f, 0.0f };
+        meshlet.ConeCutoff = 1.0f;
+
+        if (XMVectorGetX(XMVector3LengthSq(normalSum)) == 0.0f)
+        {
+            return;
+        }
+
+        const XMVECTOR axis = XMVector3Normalize(normalSum);
+        float minDot = 1.0f;
+
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            // Degenerate triangles face nowhere, so they don't widen the cone.
+            const XMVECTOR normal = GetTriangleNormal(vertices, triangles + t * 3);
+            if (XMVector3Equal(normal, XMVectorZero()))
+            {
+                continue;
+            }
+
+            const float dot = XMVectorGetX(XMVector3Dot(axis, normal));
+            if (dot < minDot)
+            {
+                minDot = dot;
+            }
+        }
+
+        if (minDot <= c_minConeSpread)
+        {
+            return;
+        }
+
+        // Sine of the cone's half angle, which bounds how far the view direction may lean towards the axis.
+        XMStoreFloat3(&meshlet.ConeAxis, axis);
+        meshlet.ConeCutoff = sqrtf(1.0f - minDot * minDot);
+    }
+
+    // The point shared by three planes, or false if they don't meet in a single point.
+    bool IntersectPlanes(XMVECTOR p1, XMVECTOR p2, XMVECTOR p3, XMVECTOR& point)
+    {
+        const XMVECTOR cross23 = XMVector3Cross(p2, p3);
+        const float denominator = XMVectorGetX(XMVector3Dot(p1, cross23));
+        if (fabsf(denominator) < 1e-12f)
+        {
+            return false;
+        }
+
+        point = XMVectorAdd(
+            XMVectorAdd(
+                XMVectorScale(cross23, XMVectorGetW(p1)),
+                XMVectorScale(XMVector3Cross(p3, p1), XMVectorGetW(p2))),
+            XMVectorScale(XMVector3Cross(p1, p2), XMVectorGetW(p3)));
+        point = XMVectorScale(point, -1.0f / denominator);
+
+        return true;
+    }
+
+    struct ViewFrustum
+    {
+        array<XMVECTOR, 6> Planes;
+        XMVECTOR Eye;
+        bool HasEye;
+    };
+
+    // Planes facing into the frustum, in object space, from the columns of the object to clip transform.
+    ViewFrustum GetViewFrustum(XMFLOAT4X4 const& objectToClip)
+    {
+        const XMMATRIX columns = XMMatrixTranspose(XMLoadFloat4x4(&objectToClip));
+
+        ViewFrustum frustum;
+        frustum.Planes =
+        { {
+            XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[0])),          // left
+            XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[0])),     // right
+            XMPlaneNormalize(XMVectorAdd(columns.r[3], columns.r[1])),          // bottom
+            XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[1])),     // top
+            XMPlaneNormalize(columns.r[2]),                                     // near
+            XMPlaneNormalize(XMVectorSubtract(columns.r[3], columns.r[2])),     // far
+        } };
+
+        // The side planes of a perspective frustum meet at the eye.
+        frustum.HasEye = IntersectPlanes(frustum.Planes[0], frustum.Planes[1], frustum.Planes[2], frustum.Eye);
+
+        return frustum;
+    }
+
+    bool IsVisible(AoaSampleApp::Meshlet const& meshlet, ViewFrustum const& frustum, bool cullBackFacing)
+    {
+        const XMVECTOR center = XMLoadFloat3(&meshlet.Center);
+
+        for (auto const& plane : frustum.Planes)
+        {
+            if (XMVectorGetX(XMPlaneDotCoord(plane, center)) < -meshlet.Radius)
+            {
+                return false;
+            }
+        }
+
+        // All triangles face away from the eye if it looks at the sphere from within the cone of their normals.
+        if (cullBackFacing && frustum.HasEye && meshlet.ConeCutoff < 1.0f)
+        {
+            const XMVECTOR toCenter = XMVectorSubtract(center, frustum.Eye);
+            const float dot = XMVectorGetX(XMVector3Dot(toCenter, XMLoadFloat3(&meshlet.ConeAxis)));
+
+            if (dot >= meshlet.ConeCutoff * XMVectorGetX(XMVector3Length(toCenter)) + meshlet.Radius)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+namespace AoaSampleApp
+{
+    vector<Meshlet> BuildMeshlets(vector<XMFLOAT3> const& vertices, vector<uint32_t>& indices, MeshLevelOfDetail const& range, size_t maxTriangleCount)
+    {
+        const size_t triangleCount = range.IndexCount / 3;
+        if (triangleCount == 0 || maxTriangleCount == 0 || range.StartIndex + range.IndexCount > indices.size())
+        {
+            return {};
+        }
+
+        uint32_t* triangles = indices.data() + range.StartIndex;
+
+        // Vertices to the triangles that use them, as offsets into one list.
+        vector<uint32_t> vertexTriangleOffsets(vertices.size() + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            ++vertexTriangleOffsets[triangles[i] + 1];
+        }
+
+        partial_sum(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end(), vertexTriangleOffsets.begin());
+
+        vector<uint32_t> vertexTriangles(triangleCount * 3);
+        {
+            vector<uint32_t> next(vertexTriangleOffsets.cbegin(), vertexTriangleOffsets.cend() - 1);
+            for (size_t i = 0; i < triangleCount * 3; ++i)
+            {
+                vertexTriangles[next[triangles[i]]++] = static_cast<uint32_t>(i / 3);
+            }
+        }
+
+        // Seeds in Morton order of the triangle centroids, within the bounds of the range.
+        XMVECTOR minimum = g_XMFltMax;
+        XMVECTOR maximum = XMVectorNegate(g_XMFltMax);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            const XMVECTOR vertex = XMLoadFloat3(&vertices[triangles[i]]);
+            minimum = XMVectorMin(minimum, vertex);
+            maximum = XMVectorMax(maximum, vertex);
+        }
+
+        const XMVECTOR scale = XMVectorDivide(
+            XMVectorReplicate(1023.0f),
+            XMVectorMax(XMVectorSubtract(maximum, minimum), XMVectorReplicate(1e-6f)));
+
+        vector<pair<uint32_t, uint32_t>> seeds(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const XMVECTOR centroid = XMVectorScale(
+                XMVectorAdd(
+                    XMLoadFloat3(&vertices[triangles[t * 3]]),
+                    XMVectorAdd(XMLoadFloat3(&vertices[triangles[t * 3 + 1]]), XMLoadFloat3(&vertices[triangles[t * 3 + 2]]))),
+                1.0f / 3.0f);
+
+            XMFLOAT3 cell;
+            XMStoreFloat3(&cell, XMVectorMultiply(XMVectorSubtract(centroid, minimum), scale));
+
+            seeds[t] = { GetMortonCode(static_cast<uint32_t>(cell.x), static_cast<uint32_t>(cell.y), static_cast<uint32_t>(cell.z)), static_cast<uint32_t>(t) };
+        }
+
+        sort(seeds.begin(), seeds.end());
+
+        // Grow each meshlet breadth first from its seed.
+        vector<bool> assigned(triangleCount, false);
+        vector<uint32_t> order;
+        order.reserve(triangleCount);
+
+        vector<uint32_t> meshletSizes;
+        vector<uint32_t> frontier;
+
+        for (auto const& [code, seed] : seeds)
+        {
+            if (assigned[seed])
+            {
+                continue;
+            }
+
+            const size_t meshletStart = order.size();
+
+            frontier.clear();
+            frontier.push_back(seed);
+
+            for (size_t next = 0; next < frontier.size() && order.size() - meshletStart < maxTriangleCount; ++next)
+            {
+                const uint32_t t = frontier[next];
+                if (assigned[t])
+                {
+                    continue;
+                }
+
+                assigned[t] = true;
+                order.push_back(t);
+
+                for (size_t corner = 0; corner < 3; ++corner)
+                {
+                    const uint32_t vertex = triangles[t * 3 + corner];
+                    for (uint32_t i = vertexTriangleOffsets[vertex]; i < vertexTriangleOffsets[vertex + 1]; ++i)
+                    {
+                        if (!assigned[vertexTriangles[i]])
+                        {
+                            frontier.push_back(vertexTriangles[i]);
+                        }
+                    }
+                }
+            }
+
+            meshletSizes.push_back(static_cast<uint32_t>(order.size() - meshletStart));
+        }
+
+        vector<uint32_t> reordered;
+        reordered.reserve(triangleCount * 3);
+        for (const uint32_t t : order)
+        {
+            reordered.insert(reordered.end(), triangles + t * 3, triangles + t * 3 + 3);
+        }
+
+        copy(reordered.cbegin(), reordered.cend(), triangles);
+
+        vector<Meshlet> meshlets;
+        meshlets.reserve(meshletSizes.size());
+
+        uint32_t startTriangle = 0;
+        for (const uint32_t size : meshletSizes)
+        {
+            Meshlet meshlet{};
+            meshlet.StartIndex = range.StartIndex + startTriangle * 3;
+            meshlet.IndexCount = size * 3;
+
+            ComputeBounds(vertices, triangles + startTriangle * 3, size, meshlet);
+            meshlets.push_back(meshlet);
+
+            startTriangle += size;
+        }
+
+        return meshlets;
+    }
+
+    void CullMeshlets(
+        Meshlet const* meshlets,
+        size_t meshletCount,
+        XMFLOAT4X4 const* objectToClip,
+        size_t viewCount,
+        bool cullBackFacing,
+        vector<MeshLevelOfDetail>& visibleRanges)
+    {
+        visibleRanges.clear();
+
+        vector<ViewFrustum> frustums;
+        frustums.reserve(viewCount);
+        for (size_t i = 0; i < viewCount; ++i)
+        {
+            frustums.push_back(GetViewFrustum(objectToClip[i]));
+        }
+
+        for (size_t i = 0; i < meshletCount; ++i)
+        {
+            auto const& meshlet = meshlets[i];
+
+            const bool visible = any_of(frustums.cbegin(), frustums.cend(), [&](ViewFrustum const& frustum)
+            {
+                return IsVisible(meshlet, frustum, cullBackFacing);
+            });
+
+            if (!visible)
+            {
+                continue;
+            }
+
+            if (!visibleRanges.empty() && visibleRanges.back().StartIndex + visibleRanges.back().IndexCount == meshlet.StartIndex)
+            {
+                visibleRanges.back().IndexCount += meshlet.IndexCount;
+            }
+            else
+            {
+                visibleRanges.push_back({ meshlet.StartIndex, meshlet.IndexCount });
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "MeshSimplifier.h"
+
+#include <DirectXMath.h>
+
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // A spatially coherent range of triangles of a mesh, with bounds to cull it by.
+    struct Meshlet
+    {
+        uint32_t StartIndex;
+        uint32_t IndexCount;
+
+        // Bounding sphere of the triangles.
+        DirectX::XMFLOAT3 Center;
+        float Radius;
+
+        // Cone containing the normals of the triangles. A cutoff of 1 means the normals are too spread out to
+        // cull the meshlet as back facing.
+        DirectX::XMFLOAT3 ConeAxis;
+        float ConeCutoff;
+    };
+
+    // Splits a range of a triangle list into meshlets of at most maxTriangleCount triangles, reordering the
+    // triangles within the range so that each meshlet is contiguous. Meshlets are returned in index order.
+    //
+    // Meshlets are grown from a seed triangle to the triangles sharing its vertices, and seeds are taken in
+    // Morton order of the triangle centroids, so that meshlets next to each other in the index buffer tend to
+    // be next to each other in space too.
+    std::vector<Meshlet> BuildMeshlets(
+        std::vector<DirectX::XMFLOAT3> const& vertices,
+        std::vector<uint32_t>& indices,
+        MeshLevelOfDetail const& range,
+        size_t maxTriangleCount);
+
+    // Sets the index ranges of the meshlets visible from any of the views, given the object to clip space
+    // transforms of the views. Adjacent visible meshlets are merged into one range.
+    //
+    // Meshlets are culled against the view frustums, and, if cullBackFacing is set, when all of their
+    // triangles face away from the views.
+    void CullMeshlets(
+        Meshlet const* meshlets,
+        size_t meshletCount,
+        DirectX::XMFLOAT4X4 const* objectToClip,
+        size_t viewCount,
+        bool cullBackFacing,
+        std::vector<MeshLevelOfDetail>& visibleRanges);
+}
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "ModelCatalog.h"
+
+using namespace std;
+
+namespace
+{
+    struct ViewDeleter
+    {
+        void operator()(void const* view) const { ::UnmapViewOfFile(view); }
+    };
+}
+
+namespace AoaSampleApp
+{
+    bool ModelCatalog::Load(wstring const& catalogPath)
+    {
+        m_entries.clear();
+        m_seenPaths.clear();
+        m_changed = false;
+
+        winrt::file_handle file{ ::CreateFile2(catalogPath.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr) };
+        if (!file)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+        // Empty files can't be mapped.
+        if (!::GetFileSizeEx(file.get(), &fileSize) || fileSize.QuadPart == 0)
+        {
+            return false;
+        }
+
+        winrt::handle mapping{ ::CreateFileMappingFromApp(file.get(), nullptr, PAGE_READONLY, 0, nullptr) };
+        if (!mapping)
+        {
+            return false;
+        }
+
+        unique_ptr<void const, ViewDeleter> view{ ::MapViewOfFileFromApp(mapping.get(), FILE_MAP_READ, 0, 0) };
+        if (!view)
+        {
+            return false;
+        }
+
+        vector<ModelCatalogEntry> entries;
+        if (!DecodeModelCatalog(static_cast<uint8_t const*>(view.get()), static_cast<size_t>(fileSize.QuadPart), entries))
+        {
+            return false;
+        }
+
+        m_entries.reserve(entries.size());
+
+        for (auto& entry : entries)
+        {
+            auto path = entry.Path;
+            m_entries.insert_or_assign(move(path), move(entry));
+        }
+
+        return true;
+    }
+
+    void ModelCatalog::SaveIfChanged(wstring const& catalogPath)
+    {
+        // Drop files that disappeared since the catalog was loaded.
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (m_seenPaths.count(it->first) == 0)
+            {
+                it = m_entries.erase(it);
+                m_changed = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (!m_changed)
+        {
+            return;
+        }
+
+        vector<ModelCatalogEntry> entries;
+        entries.reserve(m_entries.size());
+
+        for (auto const& [path, entry] : m_entries)
+        {
+            entries.emplace_back(entry);
+        }
+
+        const auto catalogData = EncodeModelCatalog(entries);
+
+        // Write to a temporary file first so that a crash never leaves a partially written catalog behind.
+        const wstring temporaryPath = catalogPath + L".tmp";
+        {
+            winrt::file_handle file{ ::CreateFile2(temporaryPath.c_str(), GENERIC_WRITE, 0, CREATE_ALWAYS, nullptr) };
+            if (!file)
+            {
+                return;
+            }
+
+            auto write = [&file](void const* data, size_t size)
+            {
+                DWORD written = 0;
+                return ::WriteFile(file.get(), data, static_cast<DWORD>(size), &written, nullptr) && written == size;
+            };
+
+            if (!write(catalogData.data(), catalogData.size()))
+            {
+                return;
+            }
+        }
+
+        if (::MoveFileExW(temporaryPath.c_str(), catalogPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+        {
+            m_changed = false;
+        }
+    }
+
+    ModelCatalogEntry const* ModelCatalog::Find(wstring const& path, uint64_t size, int64_t modifiedTime)
+    {
+        m_seenPaths.insert(path);
+
+        auto it = m_entries.find(path);
+        if (it == m_entries.cend() || it->second.Size != size || it->second.ModifiedTime != modifiedTime)
+        {
+            return nullptr;
+        }
+
+        return &it->second;
+    }
+
+    void ModelCatalog::Update(ModelCatalogEntry entry)
+    {
+        m_seenPaths.insert(entry.Path);
+
+        auto path = entry.Path;
+        m_entries.insert_or_assign(move(path), move(entry));
+        m_changed = true;
+    }
+
+    void ModelCatalog::Remove(wstring const& path)
+    {
+        m_seenPaths.erase(path);
+        m_changed |= m_entries.erase(path) > 0;
+    }
+}
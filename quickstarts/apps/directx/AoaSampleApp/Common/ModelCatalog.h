@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "ModelCatalogFormat.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace AoaSampleApp
+{
+    // Compact on-disk index of the object models found in the model folders, in the format of ModelCatalogFormat.h.
+    //
+    // The index is read with a single memory mapping at startup. An entry stays valid as long as the size
+    // and modification time of its file are unchanged, so only new or modified files have to be hashed
+    // again. Files with the same content hash hold the same model, so the app reads and parses each model
+    // only once however many copies of it the model folders hold. Entries of files that were not seen
+    // since the last load are dropped on save.
+    class ModelCatalog
+    {
+    public:
+        // Loads the index from disk. A missing, truncated or malformed index results in an empty catalog.
+        bool Load(std::wstring const& catalogPath);
+
+        // Writes the index to disk if it changed since it was loaded.
+        void SaveIfChanged(std::wstring const& catalogPath);
+
+        // Returns the entry of a file if it's up to date with the given size and modification time, nullptr otherwise.
+        ModelCatalogEntry const* Find(std::wstring const& path, uint64_t size, int64_t modifiedTime);
+
+        // Adds or replaces the entry of a file.
+        void Update(ModelCatalogEntry entry);
+
+        // Removes the entry of a file, if any.
+        void Remove(std::wstring const& path);
+
+        size_t Size() const { return m_entries.size(); }
+
+    private:
+        std::unordered_map<std::wstring, ModelCatalogEntry> m_entries;
+
+        // Files looked up or updated since the catalog was loaded.
+        std::unordered_set<std::wstring> m_seenPaths;
+
+        bool m_changed{ false };
+    };
+}
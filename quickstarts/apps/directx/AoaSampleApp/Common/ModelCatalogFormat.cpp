@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "ModelCatalogFormat.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint32_t c_catalogMagic = 0x43414f41; // 'AOAC'
+    constexpr uint32_t c_catalogVersion = 3;
+
+    // Layout of the catalog file:
+    //
+    //    CatalogHeader
+    //    CatalogRecord[RecordCount]
+    //    char16_t[StringTableLength]    paths referenced by the records, not null-terminated
+    struct CatalogHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t RecordCount;
+        uint32_t StringTableLength;
+    };
+
+    struct CatalogRecord
+    {
+        uint64_t Size;
+        int64_t ModifiedTime;
+        uint64_t ContentHash;
+        AoaSampleApp::Guid ModelId;
+        float Center[3];
+        float Extents[3];
+        float Orientation[4];
+        uint32_t PathOffset;
+        uint32_t PathLength;
+    };
+
+    static_assert(sizeof(CatalogHeader) == 16, "Catalog header layout must not change within a version.");
+    static_assert(sizeof(CatalogRecord) == 88, "Catalog record layout must not change within a version.");
+}
+
+namespace AoaSampleApp
+{
+    vector<uint8_t> EncodeModelCatalog(vector<ModelCatalogEntry> const& entries)
+    {
+        vector<CatalogRecord> records;
+        records.reserve(entries.size());
+
+        u16string strings;
+
+        for (auto const& entry : entries)
+        {
+            CatalogRecord record{};
+            record.Size = entry.Size;
+            record.ModifiedTime = entry.ModifiedTime;
+            record.ContentHash = entry.ContentHash;
+            record.ModelId = entry.ModelId;
+            memcpy(record.Center, &entry.BoundingBox.Center, sizeof(record.Center));
+            memcpy(record.Extents, &entry.BoundingBox.Extents, sizeof(record.Extents));
+            memcpy(record.Orientation, &entry.BoundingBox.Orientation, sizeof(record.Orientation));
+            record.PathOffset = static_cast<uint32_t>(strings.size());
+            record.PathLength = static_cast<uint32_t>(entry.Path.size());
+
+            for (const wchar_t character : entry.Path)
+            {
+                strings.push_back(static_cast<char16_t>(character));
+            }
+
+            records.emplace_back(record);
+        }
+
+        CatalogHeader header{};
+        header.Magic = c_catalogMagic;
+        header.Version = c_catalogVersion;
+        header.RecordCount = static_cast<uint32_t>(records.size());
+        header.StringTableLength = static_cast<uint32_t>(strings.size());
+
+        const size_t recordsSize = records.size() * sizeof(CatalogRecord);
+
+        vector<uint8_t> data(sizeof(CatalogHeader) + recordsSize + strings.size() * sizeof(char16_t));
+        memcpy(data.data(), &header, sizeof(header));
+        memcpy(data.data() + sizeof(CatalogHeader), records.data(), recordsSize);
+        memcpy(data.data() + sizeof(CatalogHeader) + recordsSize, strings.data(), strings.size() * sizeof(char16_t));
+
+        return data;
+    }
+
+    bool DecodeModelCatalog(uint8_t const* data, size_t size, vector<ModelCatalogEntry>& entries)
+    {
+        entries.clear();
+
+        //
+        // Validate the header before touching any record.
+        //
+
+        if (size < sizeof(CatalogHeader))
+        {
+            return false;
+        }
+
+        CatalogHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        const uint64_t recordsSize = uint64_t{ header.RecordCount } * sizeof(CatalogRecord);
+        const uint64_t stringTableSize = uint64_t{ header.StringTableLength } * sizeof(char16_t);
+
+        if (header.Magic != c_catalogMagic ||
+            header.Version != c_catalogVersion ||
+            sizeof(CatalogHeader) + recordsSize + stringTableSize != size)
+        {
+            return false;
+        }
+
+        uint8_t const* records = data + sizeof(CatalogHeader);
+        uint8_t const* strings = records + recordsSize;
+
+        entries.reserve(header.RecordCount);
+
+        for (uint32_t i = 0; i < header.RecordCount; ++i)
+        {
+            // The mapping of the file is only aligned for the header, so records are copied out.
+            CatalogRecord record;
+            memcpy(&record, records + i * sizeof(CatalogRecord), sizeof(record));
+
+            if (uint64_t{ record.PathOffset } + record.PathLength > header.StringTableLength)
+            {
+                entries.clear();
+                return false;
+            }
+
+            ModelCatalogEntry entry;
+            entry.Path.resize(record.PathLength);
+            for (uint32_t c = 0; c < record.PathLength; ++c)
+            {
+                char16_t character;
+                memcpy(&character, strings + (size_t{ record.PathOffset } + c) * sizeof(char16_t), sizeof(character));
+                entry.Path[c] = static_cast<wchar_t>(character);
+            }
+
+            entry.Size = record.Size;
+            entry.ModifiedTime = record.ModifiedTime;
+            entry.ContentHash = record.ContentHash;
+            entry.ModelId = record.ModelId;
+            entry.BoundingBox.Center = { record.Center[0], record.Center[1], record.Center[2] };
+            entry.BoundingBox.Extents = { record.Extents[0], record.Extents[1], record.Extents[2] };
+            entry.BoundingBox.Orientation = { record.Orientation[0], record.Orientation[1], record.Orientation[2], record.Orientation[3] };
+
+            entries.emplace_back(move(entry));
+        }
+
+        return true;
+    }
+
+    uint64_t ComputeModelContentHash(uint8_t const* data, size_t size)
+    {
+        constexpr uint64_t c_fnvOffsetBasis = 14695981039346656037ull;
+        constexpr uint64_t c_fnvPrime = 1099511628211ull;
+
+        uint64_t hash = c_fnvOffsetBasis;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= c_fnvPrime;
+        }
+
+        return hash;
+    }
+}
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "Guid.h"
+
+#include <DirectXCollision.h>
+
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Cached description of an object model file.
+    struct ModelCatalogEntry
+    {
+        std::wstring Path;
+        uint64_t Size{ 0 };
+        int64_t ModifiedTime{ 0 };      // File modification time, in 100-nanosecond ticks.
+        uint64_t ContentHash{ 0 };      // 64-bit FNV-1a hash of the file content.
+        Guid ModelId{};
+
+        // Bounding box of the model, with half width extents as DirectX uses, so that the extents of a model
+        // are known without parsing its file.
+        DirectX::BoundingOrientedBox BoundingBox{};
+    };
+
+    // Serializes entries in the format of the catalog file. Paths are stored as UTF-16, whatever the size of wchar_t.
+    std::vector<uint8_t> EncodeModelCatalog(std::vector<ModelCatalogEntry> const& entries);
+
+    // Reads the entries of a catalog file. Returns false, with no entries, if the data isn't a complete catalog
+    // of the current version.
+    bool DecodeModelCatalog(uint8_t const* data, size_t size, std::vector<ModelCatalogEntry>& entries);
+
+    uint64_t ComputeModelContentHash(uint8_t const* data, size_t size);
+}
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "ModelExtentsIndex.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Half diagonal of the largest models of size class 0.
+    constexpr float c_sizeClassBaseDiagonal = 0.25f;
+}
+
+namespace AoaSampleApp
+{
+    ModelExtentsIndex::SizeClass ModelExtentsIndex::GetSizeClass(float diagonal)
+    {
+        if (diagonal <= c_sizeClassBaseDiagonal)
+        {
+            return 0;
+        }
+
+        return static_cast<SizeClass>(ceilf(log2f(diagonal / c_sizeClassBaseDiagonal)));
+    }
+
+    float ModelExtentsIndex::GetSizeClassMaxDiagonal(SizeClass sizeClass)
+    {
+        return ldexpf(c_sizeClassBaseDiagonal, sizeClass);
+    }
+
+    void ModelExtentsIndex::Add(Guid const& modelId, XMFLOAT3 const& extents)
+    {
+        if (m_models.count(modelId) > 0)
+        {
+            return;
+        }
+
+        ModelExtents model;
+        model.Extents = extents;
+        model.MaxExtent = (max)((max)(model.Extents.x, model.Extents.y), model.Extents.z);
+        model.Diagonal = XMVectorGetX(XMVector3Length(XMLoadFloat3(&model.Extents)));
+        model.Class = GetSizeClass(model.Diagonal);
+
+        m_allModels.Add(model);
+        m_sizeClasses[model.Class].Add(model);
+
+        m_models.emplace(modelId, model);
+    }
+
+    void ModelExtentsIndex::Remove(Guid const& modelId)
+    {
+        auto it = m_models.find(modelId);
+        if (it == m_models.cend())
+        {
+            return;
+        }
+
+        auto const& model = it->second;
+
+        m_allModels.Remove(model);
+
+        auto sizeClass = m_sizeClasses.find(model.Class);
+        sizeClass->second.Remove(model);
+        if (sizeClass->second.Summary.ModelCount == 0)
+        {
+            m_sizeClasses.erase(sizeClass);
+        }
+
+        m_models.erase(it);
+    }
+
+    ModelExtentsIndex::SizeClass ModelExtentsIndex::GetSizeClass(Guid const& modelId) const
+    {
+        return m_models.at(modelId).Class;
+    }
+
+    vector<pair<ModelExtentsIndex::SizeClass, ModelExtentsSummary>> ModelExtentsIndex::GetSizeClassSummaries() const
+    {
+        vector<pair<SizeClass, ModelExtentsSummary>> summaries;
+        summaries.reserve(m_sizeClasses.size());
+
+        for (auto const& [sizeClass, extents] : m_sizeClasses)
+        {
+            summaries.emplace_back(sizeClass, extents.Summary);
+        }
+
+        return summaries;
+    }
+
+    void ModelExtentsIndex::ExtentsSet::Add(ModelExtents const& model)
+    {
+        ExtentsX.insert(model.Extents.x);
+        ExtentsY.insert(model.Extents.y);
+        ExtentsZ.insert(model.Extents.z);
+        MaxExtentsAndDiagonals.emplace(model.MaxExtent, model.Diagonal);
+
+        UpdateSummary();
+    }
+
+    void ModelExtentsIndex::ExtentsSet::Remove(ModelExtents const& model)
+    {
+        // Erase a single occurrence, other models may have the same extents.
+        ExtentsX.erase(ExtentsX.find(model.Extents.x));
+        ExtentsY.erase(ExtentsY.find(model.Extents.y));
+        ExtentsZ.erase(ExtentsZ.find(model.Extents.z));
+        MaxExtentsAndDiagonals.erase(MaxExtentsAndDiagonals.find({ model.MaxExtent, model.Diagonal }));
+
+        UpdateSummary();
+    }
+
+    void ModelExtentsIndex::ExtentsSet::UpdateSummary()
+    {
+        Summary = {};
+        Summary.ModelCount = MaxExtentsAndDiagonals.size();
+
+        if (MaxExtentsAndDiagonals.empty())
+        {
+            return;
+        }
+
+        Summary.MaxExtents = { *ExtentsX.crbegin(), *ExtentsY.crbegin(), *ExtentsZ.crbegin() };
+        Summary.MaxModelExtent = MaxExtentsAndDiagonals.crbegin()->first;
+        Summary.MaxModelDiagonal = MaxExtentsAndDiagonals.crbegin()->second;
+    }
+}
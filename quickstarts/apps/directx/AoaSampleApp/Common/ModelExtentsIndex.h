@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "Guid.h"
+
+#include <DirectXMath.h>
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Extents of a set of object models, as needed to size a search area. Extents are half widths.
+    struct ModelExtentsSummary
+    {
+        size_t ModelCount{ 0 };
+
+        // Largest extents along each axis, over all models.
+        DirectX::XMFLOAT3 MaxExtents{ 0.0f, 0.0f, 0.0f };
+
+        // Largest extent of a single model along any axis, and the half diagonal of that model.
+        float MaxModelExtent{ 0.0f };
+        float MaxModelDiagonal{ 0.0f };
+    };
+
+    // Keeps the extents summary up to date as models are added and removed, so that reading it doesn't
+    // depend on the number of models.
+    //
+    // Models are also grouped in size classes, by powers of two of their half diagonal, so that models of
+    // similar size can share a search area sized for them rather than for the largest model.
+    class ModelExtentsIndex
+    {
+    public:
+        // Size class of models whose half diagonal is at most GetSizeClassMaxDiagonal(sizeClass).
+        using SizeClass = int32_t;
+
+        static SizeClass GetSizeClass(float diagonal);
+        static float GetSizeClassMaxDiagonal(SizeClass sizeClass);
+
+        // Extents of the bounding box of the model, as half widths.
+        void Add(Guid const& modelId, DirectX::XMFLOAT3 const& extents);
+        void Remove(Guid const& modelId);
+
+        ModelExtentsSummary const& GetSummary() const { return m_allModels.Summary; }
+
+        // Size class of a model added to the index.
+        SizeClass GetSizeClass(Guid const& modelId) const;
+
+        // Summaries of the size classes with at least one model, smallest class first.
+        std::vector<std::pair<SizeClass, ModelExtentsSummary>> GetSizeClassSummaries() const;
+
+    private:
+        struct ModelExtents
+        {
+            DirectX::XMFLOAT3 Extents;
+            float MaxExtent;
+            float Diagonal;
+            SizeClass Class;
+        };
+
+        // Sorted extents of a set of models, the largest one last.
+        struct ExtentsSet
+        {
+            std::multiset<float> ExtentsX;
+            std::multiset<float> ExtentsY;
+            std::multiset<float> ExtentsZ;
+            std::multiset<std::pair<float, float>> MaxExtentsAndDiagonals;
+
+            ModelExtentsSummary Summary;
+
+            void Add(ModelExtents const& model);
+            void Remove(ModelExtents const& model);
+            void UpdateSummary();
+        };
+
+        std::unordered_map<Guid, ModelExtents> m_models;
+
+        ExtentsSet m_allModels;
+        std::map<SizeClass, ExtentsSet> m_sizeClasses;
+    };
+}
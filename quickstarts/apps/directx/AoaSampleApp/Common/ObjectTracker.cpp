@@ -2,11 +2,13 @@
 // Licensed under the MIT license.
 #include "pch.h"
 #include "ObjectTracker.h"
+#include "DirectXHelper.h"
 #include <PathCch.h>
 #include <ppl.h>
 #include <winrt/Windows.Storage.AccessCache.h>
 
 using namespace std;
+using namespace std::chrono;
 using namespace DirectX;
 using namespace winrt;
 using namespace winrt::Windows::Foundation::Numerics;
@@ -16,6 +18,38 @@ using namespace winrt::Windows::Storage;
 using namespace winrt::Microsoft::Azure::ObjectAnchors;
 using namespace winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph;
 
+namespace
+{
+    winrt::Windows::Foundation::IAsyncOperation<StorageFolder> GetDiagnosticsFolderAsync()
+    {
+        static StorageFolder diagnosticsFolder{ nullptr };
+        if (!diagnosticsFolder)
+        {
+            constexpr auto token = L"diagnosticsFolder";
+            auto futureAccessList = AccessCache::StorageApplicationPermissions::FutureAccessList();
+            if (futureAccessList.ContainsItem(token))
+            {
+                try
+                {
+                    diagnosticsFolder = co_await futureAccessList.GetFolderAsync(token);
+                }
+                catch (...)
+                {
+                    // Folder may have been deleted by the user; recreate it below.
+                }
+            }
+
+            if (!diagnosticsFolder)
+            {
+                diagnosticsFolder = co_await DownloadsFolder::CreateFolderAsync(L"Diagnostics");
+                futureAccessList.AddOrReplace(token, diagnosticsFolder);
+            }
+        }
+
+        co_return diagnosticsFolder;
+    }
+}
+
 namespace AoaSampleApp
 {
     ObjectTracker::ObjectTracker(AccountInformation const& accountInformation)
@@ -30,6 +64,17 @@ namespace AoaSampleApp
         winrt::check_bool(::SetEvent(m_stopWorker.get()));
         m_detectionWorker.join();
 
+        // The ring waits for its loop to exit, so it's released outside of the lock.
+        unique_ptr<DiagnosticsRing> diagnosticsRing;
+        {
+            lock_guard lock(m_mutex);
+            diagnosticsRing = std::move(m_diagnosticsRing);
+        }
+        diagnosticsRing.reset();
+
+        // Hands over the last segment of a stream, so it's released after the ring.
+        m_diagnosticsUploader.reset();
+
         lock_guard lock(m_mutex);
 
         m_diagnostics = nullptr;
@@ -46,6 +91,12 @@ namespace AoaSampleApp
         }
         m_models.clear();
 
+        for (auto& model : m_retiredModels)
+        {
+            model.Close();
+        }
+        m_retiredModels.clear();
+
         m_observer.Close();
         m_observer = nullptr;
     }
@@ -66,24 +117,57 @@ namespace AoaSampleApp
         m_session = ObjectAnchorsSession(accountInformation);
 
         m_observer = m_session.CreateObjectObserver();
+
+        // Resume uploading diagnostics streamed by a previous run, if any.
+        m_diagnosticsUploader = std::make_unique<DiagnosticsUploader>(
+            m_session,
+            PathJoin(ApplicationData::Current().LocalCacheFolder().Path(), L"DiagnosticsUpload"),
+            DiagnosticsUploadLimits{});
     }
 
-    winrt::Windows::Foundation::IAsyncOperation<guid> ObjectTracker::AddObjectModelAsync(winrt::Windows::Storage::StorageFile file)
+    winrt::Windows::Foundation::IAsyncAction ObjectTracker::WaitForInitializationAsync()
     {
         co_await m_initOperation;
+    }
 
+    winrt::Windows::Foundation::IAsyncOperation<guid> ObjectTracker::AddObjectModelAsync(winrt::Windows::Storage::StorageFile file)
+    {
         auto buffer = co_await winrt::Windows::Storage::FileIO::ReadBufferAsync(file);
-        auto model = co_await m_observer.LoadObjectModelAsync(
-            winrt::array_view(buffer.data(), buffer.Length()));
+
+        co_return co_await AddObjectModelAsync(winrt::array_view<uint8_t const>(buffer.data(), buffer.Length()));
+    }
+
+    // The data must stay valid until the returned operation completes.
+    winrt::Windows::Foundation::IAsyncOperation<guid> ObjectTracker::AddObjectModelAsync(winrt::array_view<uint8_t const> data)
+    {
+        co_await m_initOperation;
+
+        auto model = co_await m_observer.LoadObjectModelAsync(data);
 
         auto id = model.Id();
-        m_models.emplace(id, model);
+
+        // SpatialOrientedBox uses edge-to-edge length as extent, while DirectX uses half width as extent.
+        const auto boundingBox = model.BoundingBox();
+        const XMFLOAT3 extents{ boundingBox.Extents.x * 0.5f, boundingBox.Extents.y * 0.5f, boundingBox.Extents.z * 0.5f };
+
+        lock_guard lock(m_mutex);
+        if (m_models.emplace(id, model).second)
+        {
+            m_modelExtents.Add(id, extents);
+        }
+        else
+        {
+            // The same model was already loaded from another file.
+            model.Close();
+        }
 
         co_return id;
     }
 
     ObjectModel ObjectTracker::GetObjectModel(guid const& id) const
     {
+        lock_guard lock(m_mutex);
+
         auto it = m_models.find(id);
 
         if (it == m_models.cend())
@@ -96,7 +180,68 @@ namespace AoaSampleApp
         }
     }
 
-    winrt::Windows::Foundation::IAsyncAction ObjectTracker::DetectAsync(SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame, ObjectSearchArea const& searchArea)
+    vector<ObjectModel> ObjectTracker::GetObjectModels() const
+    {
+        lock_guard lock(m_mutex);
+
+        vector<ObjectModel> models;
+        models.reserve(m_models.size());
+
+        for (auto const& [modelId, model] : m_models)
+        {
+            models.emplace_back(model);
+        }
+
+        return models;
+    }
+
+    ModelExtentsSummary ObjectTracker::GetModelExtentsSummary() const
+    {
+        lock_guard lock(m_mutex);
+
+        return m_modelExtents.GetSummary();
+    }
+
+    vector<pair<ModelExtentsIndex::SizeClass, ModelExtentsSummary>> ObjectTracker::GetModelSizeClassSummaries() const
+    {
+        lock_guard lock(m_mutex);
+
+        return m_modelExtents.GetSizeClassSummaries();
+    }
+
+    void ObjectTracker::RemoveObjectModel(guid const& id)
+    {
+        lock_guard lock(m_mutex);
+
+        auto it = m_models.find(id);
+        if (it == m_models.cend())
+        {
+            return;
+        }
+
+        for (auto instanceIt = m_instances.begin(); instanceIt != m_instances.end();)
+        {
+            if (instanceIt->first.ModelId() == id)
+            {
+                instanceIt->first.Close();
+                instanceIt = m_instances.erase(instanceIt);
+            }
+            else
+            {
+                ++instanceIt;
+            }
+        }
+
+        // A query of the detection thread may still hold the model, so it's closed between detection passes.
+        m_retiredModels.emplace_back(std::move(it->second));
+        m_models.erase(it);
+        m_modelExtents.Remove(id);
+    }
+
+    winrt::Windows::Foundation::IAsyncAction ObjectTracker::DetectAsync(
+        SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame,
+        ObjectSearchArea const& searchArea,
+        map<ModelExtentsIndex::SizeClass, ObjectSearchArea> sizeClassSearchAreas)
     {
         co_await m_initOperation;
 
@@ -111,7 +256,8 @@ namespace AoaSampleApp
 
         lock_guard lock(m_mutex);
         m_interopReferenceFrame = interopReferenceFrame;
-        m_searchArea = searchArea;
+        ReplaceSearchAreas(searchArea, move(sizeClassSearchAreas));
+        m_targetedSearchAreas.clear();
 
         //
         // Close instances being tracked to enforce using latest detection results.
@@ -125,12 +271,124 @@ namespace AoaSampleApp
         m_instances.clear();
     }
 
+    void ObjectTracker::SetSearchArea(SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame, ObjectSearchArea const& searchArea)
+    {
+        lock_guard lock(m_mutex);
+        m_interopReferenceFrame = interopReferenceFrame;
+        ReplaceSearchAreas(searchArea, {});
+    }
+
+    void ObjectTracker::ReplaceSearchAreas(ObjectSearchArea const& searchArea, map<ModelExtentsIndex::SizeClass, ObjectSearchArea> sizeClassSearchAreas)
+    {
+        // Called with the lock held.
+        auto getArea = [](ObjectSearchArea const& area, map<ModelExtentsIndex::SizeClass, ObjectSearchArea> const& sizeClassAreas, ModelExtentsIndex::SizeClass sizeClass)
+        {
+            auto it = sizeClassAreas.find(sizeClass);
+            return it != sizeClassAreas.cend() ? it->second : area;
+        };
+
+        // Areas are compared by identity, so passing the same area again keeps the time its search started.
+        const auto now = steady_clock::now();
+        for (auto const& [modelId, model] : m_models)
+        {
+            const auto sizeClass = m_modelExtents.GetSizeClass(modelId);
+            const auto newArea = getArea(searchArea, sizeClassSearchAreas, sizeClass);
+            if (newArea == nullptr)
+            {
+                m_searchStartTimes.erase(sizeClass);
+            }
+            else if (newArea != getArea(m_searchArea, m_sizeClassSearchAreas, sizeClass) || m_searchStartTimes.count(sizeClass) == 0)
+            {
+                m_searchStartTimes.insert_or_assign(sizeClass, now);
+            }
+        }
+
+        m_searchArea = searchArea;
+        m_sizeClassSearchAreas = move(sizeClassSearchAreas);
+    }
+
+    void ObjectTracker::SetSceneLayout(SceneLayout layout)
+    {
+        lock_guard lock(m_mutex);
+        m_sceneLayout = move(layout);
+    }
+
+    void ObjectTracker::SearchNeighbors(guid const& modelId, SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame, float3 const& position, quaternion const& orientation)
+    {
+        lock_guard lock(m_mutex);
+
+        for (auto const& neighbor : m_sceneLayout.GetNeighbors(modelId))
+        {
+            // Pose of the neighbor in the coordinate system of the reference frame.
+            XMFLOAT3 neighborPosition;
+            XMFLOAT4 neighborOrientation;
+            neighbor.GetPose(ToXMFloat3(position), ToXMFloat4(orientation), neighborPosition, neighborOrientation);
+
+            AddTargetedSearchArea(neighbor.ModelId, interopReferenceFrame, ToFloat3(neighborPosition), ToQuaternion(neighborOrientation), neighbor.Tolerance);
+        }
+    }
+
+    void ObjectTracker::SearchAtExpectedPose(guid const& modelId, SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame, float3 const& position, quaternion const& orientation, float tolerance)
+    {
+        lock_guard lock(m_mutex);
+
+        AddTargetedSearchArea(modelId, interopReferenceFrame, position, orientation, tolerance);
+    }
+
+    void ObjectTracker::AddTargetedSearchArea(guid const& modelId, SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame, float3 const& position, quaternion const& orientation, float tolerance)
+    {
+        // Called with the lock held.
+
+        // Number of detection passes over the area where a model is expected.
+        constexpr uint32_t c_targetedSearchPasses = 3;
+
+        auto model = m_models.find(modelId);
+        if (model == m_models.cend())
+        {
+            return;
+        }
+
+        SpatialGraphCoordinateSystem coordinateSystem;
+        coordinateSystem.NodeId = interopReferenceFrame.NodeId();
+        coordinateSystem.CoordinateSystemToNodeTransform = interopReferenceFrame.CoordinateSystemToNodeTransform();
+
+        // Bounding box of the model at the expected pose, grown by the tolerance.
+        const auto modelBoundingBox = model->second.BoundingBox();
+
+        SpatialOrientedBox boundingBox;
+        boundingBox.Center = position + transform(modelBoundingBox.Center, orientation);
+        boundingBox.Orientation = concatenate(modelBoundingBox.Orientation, orientation);
+        boundingBox.Extents = modelBoundingBox.Extents + float3(tolerance * 2.0f);
+
+        m_targetedSearchAreas.insert_or_assign(modelId, TargetedSearchArea{
+            ObjectSearchArea::FromOrientedBox(coordinateSystem, boundingBox),
+            c_targetedSearchPasses
+        });
+
+        m_interopReferenceFrame = interopReferenceFrame;
+    }
+
     winrt::Windows::Foundation::IAsyncAction ObjectTracker::StartDiagnosticsAsync()
     {
-        if (m_diagnostics == nullptr)
+        if (!TryBeginDiagnosticsStart())
+        {
+            co_return;
+        }
+
+        try
         {
             co_await winrt::resume_background();
-            m_diagnostics = winrt::Microsoft::Azure::ObjectAnchors::Diagnostics::ObjectDiagnosticsSession(m_observer, (std::numeric_limits<uint32_t>::max)());
+            auto diagnostics = winrt::Microsoft::Azure::ObjectAnchors::Diagnostics::ObjectDiagnosticsSession(m_observer, (std::numeric_limits<uint32_t>::max)());
+
+            lock_guard lock(m_mutex);
+            m_diagnostics = std::move(diagnostics);
+            m_diagnosticsStarting = false;
+        }
+        catch (...)
+        {
+            lock_guard lock(m_mutex);
+            m_diagnosticsStarting = false;
+            throw;
         }
     }
 
@@ -138,45 +396,103 @@ namespace AoaSampleApp
     {
         hstring diagnosticsFilePath;
 
-        if (m_diagnostics != nullptr)
+        unique_ptr<DiagnosticsRing> diagnosticsRing;
+        winrt::Microsoft::Azure::ObjectAnchors::Diagnostics::ObjectDiagnosticsSession diagnostics{ nullptr };
+        {
+            lock_guard lock(m_mutex);
+            diagnosticsRing = std::move(m_diagnosticsRing);
+            std::swap(diagnostics, m_diagnostics);
+        }
+
+        if (diagnosticsRing != nullptr)
+        {
+            // Flushed captures are already in the diagnostics folder.
+            co_await diagnosticsRing->StopAsync();
+        }
+
+        if (diagnostics != nullptr)
         {
             // Create a diagnostics folder named by current time.
             auto diagnosticsFilename = StringToWideString(FormatDateTime(std::time(nullptr))) + L".zip";
 
-            static StorageFolder diagnosticsFolder{ nullptr };
-            if (!diagnosticsFolder)
-            {
-                constexpr auto token = L"diagnosticsFolder";
-                auto futureAccessList = AccessCache::StorageApplicationPermissions::FutureAccessList();
-                if (futureAccessList.ContainsItem(token))
-                {
-                    try
-                    {
-                        diagnosticsFolder = co_await futureAccessList.GetFolderAsync(token);
-                    }
-                    catch (...)
-                    {
-                        // Folder may have been deleted by the user; recreate it below.
-                    }
-                }
-
-                if (!diagnosticsFolder)
-                {
-                    diagnosticsFolder = co_await DownloadsFolder::CreateFolderAsync(L"Diagnostics");
-                    futureAccessList.AddOrReplace(token, diagnosticsFolder);
-                }
-            }
+            const auto diagnosticsFolder = co_await GetDiagnosticsFolderAsync();
 
             diagnosticsFilePath = PathJoin(diagnosticsFolder.Path(), diagnosticsFilename);
 
-            co_await m_diagnostics.CloseAsync(diagnosticsFilePath);
-
-            m_diagnostics = nullptr;
+            co_await diagnostics.CloseAsync(diagnosticsFilePath);
         }
 
         co_return diagnosticsFilePath;
     }
 
+    winrt::Windows::Foundation::IAsyncAction ObjectTracker::StartDiagnosticsRingAsync(DiagnosticsRingLimits const& limits)
+    {
+        co_await StartSegmentedDiagnosticsAsync(limits, L"DiagnosticsRing", nullptr);
+    }
+
+    winrt::Windows::Foundation::IAsyncAction ObjectTracker::StartDiagnosticsStreamAsync(DiagnosticsRingLimits const& limits)
+    {
+        co_await StartSegmentedDiagnosticsAsync(limits, L"DiagnosticsStream", [this](std::wstring const& segmentPath)
+        {
+            m_diagnosticsUploader->Enqueue(segmentPath);
+        });
+    }
+
+    winrt::Windows::Foundation::IAsyncAction ObjectTracker::StartSegmentedDiagnosticsAsync(
+        DiagnosticsRingLimits const& limits,
+        std::wstring segmentFolderName,
+        std::function<void(std::wstring const& segmentPath)> segmentSink)
+    {
+        co_await m_initOperation;
+
+        if (!TryBeginDiagnosticsStart())
+        {
+            co_return;
+        }
+
+        try
+        {
+            const auto diagnosticsFolder = co_await GetDiagnosticsFolderAsync();
+            const auto segmentFolderPath = PathJoin(ApplicationData::Current().LocalCacheFolder().Path(), segmentFolderName);
+
+            co_await winrt::resume_background();
+            auto diagnosticsRing = make_unique<DiagnosticsRing>(m_observer, limits, segmentFolderPath, std::wstring{ diagnosticsFolder.Path() }, std::move(segmentSink));
+
+            lock_guard lock(m_mutex);
+            m_diagnosticsRing = std::move(diagnosticsRing);
+            m_diagnosticsStarting = false;
+        }
+        catch (...)
+        {
+            lock_guard lock(m_mutex);
+            m_diagnosticsStarting = false;
+            throw;
+        }
+    }
+
+    bool ObjectTracker::TryBeginDiagnosticsStart()
+    {
+        lock_guard lock(m_mutex);
+
+        if (m_diagnostics != nullptr || m_diagnosticsRing != nullptr || m_diagnosticsStarting)
+        {
+            return false;
+        }
+
+        m_diagnosticsStarting = true;
+        return true;
+    }
+
+    void ObjectTracker::RequestDiagnosticsFlush(std::string reason)
+    {
+        lock_guard lock(m_mutex);
+
+        if (m_diagnosticsRing != nullptr)
+        {
+            m_diagnosticsRing->RequestFlush(std::move(reason));
+        }
+    }
+
     winrt::Windows::Foundation::IAsyncAction ObjectTracker::UploadDiagnosticsAsync(winrt::hstring const& diagnosticsFilePath)
     {
         winrt::check_bool(!diagnosticsFilePath.empty());
@@ -249,6 +565,11 @@ namespace AoaSampleApp
         {
             instance.Close();
             m_instances.erase(instance);
+
+            if (m_diagnosticsRing != nullptr)
+            {
+                m_diagnosticsRing->RequestFlush("TrackingLost");
+            }
         }
     }
 
@@ -276,26 +597,66 @@ namespace AoaSampleApp
             {
                 lock_guard lock(m_mutex);
 
+                // No detection is in flight at this point, so models removed in the meantime can be released.
+                for (auto& model : m_retiredModels)
+                {
+                    model.Close();
+                }
+                m_retiredModels.clear();
+
                 interopReferenceFrame = m_interopReferenceFrame;
-                if (m_searchArea != nullptr)
+
+                auto isTracked = [this](guid const& modelId)
                 {
-                    for (auto const& [modelId, model] : m_models)
+                    for (auto const& [instance, metadata] : m_instances)
                     {
-                        bool found = false;
-                        for (auto const& [instance, metadata] : m_instances)
+                        if (modelId == instance.ModelId())
                         {
-                            if (modelId == instance.ModelId())
-                            {
-                                found = true;
-                                break;
-                            }
+                            return true;
                         }
+                    }
+
+                    return false;
+                };
+
+                // Models with an expected pose, e.g. neighbors of detected models, are searched first in tight areas.
+                for (auto it = m_targetedSearchAreas.begin(); it != m_targetedSearchAreas.end();)
+                {
+                    auto model = m_models.find(it->first);
+                    if (model == m_models.cend() || isTracked(it->first))
+                    {
+                        it = m_targetedSearchAreas.erase(it);
+                        continue;
+                    }
+
+                    auto query = ObjectQuery(model->second);
+                    query.MaxScaleChange(m_maxScaleChange);
+                    query.SearchAreas().Append(it->second.SearchArea);
+
+                    queries.emplace_back(std::move(query));
 
-                        if (!found)
+                    if (--it->second.RemainingPasses == 0)
+                    {
+                        it = m_targetedSearchAreas.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                if (queries.empty() && m_searchArea != nullptr)
+                {
+                    for (auto const& [modelId, model] : m_models)
+                    {
+                        if (!isTracked(modelId))
                         {
                             auto query = ObjectQuery(model);
                             query.MaxScaleChange(m_maxScaleChange);
-                            query.SearchAreas().Append(m_searchArea);
+
+                            // Models of similar size share an area sized for them.
+                            auto sizeClassSearchArea = m_sizeClassSearchAreas.find(m_modelExtents.GetSizeClass(modelId));
+                            query.SearchAreas().Append(sizeClassSearchArea != m_sizeClassSearchAreas.cend() ? sizeClassSearchArea->second : m_searchArea);
 
                             queries.emplace_back(std::move(query));
                         }
@@ -314,6 +675,7 @@ namespace AoaSampleApp
             else
             {
                 auto detectedObjects = m_observer.DetectAsync(queries).get();
+                const auto detectionTime = steady_clock::now();
 
                 // Release resources held by a query.
                 queries.clear();
@@ -349,9 +711,54 @@ namespace AoaSampleApp
                 }
 
                 lock_guard lock(m_mutex);
+
+                // Drop instances of models removed while the detection was running.
+                for (auto it = newInstances.begin(); it != newInstances.end();)
+                {
+                    if (m_models.count(it->first.ModelId()) == 0)
+                    {
+                        it->first.Close();
+                        it = newInstances.erase(it);
+                    }
+                    else
+                    {
+                        RecordDetectionLatency(it->first.ModelId(), detectionTime);
+                        ++it;
+                    }
+                }
+
                 newInstances.merge(std::move(m_instances)); // splice in old instances; new instances are preserved
                 m_instances = std::move(newInstances);
             }
         }
     }
+
+    void ObjectTracker::RecordDetectionLatency(winrt::guid const& modelId, steady_clock::time_point detectionTime)
+    {
+        // Called with the lock held.
+        const auto sizeClass = m_modelExtents.GetSizeClass(modelId);
+
+        // Models found in a targeted area may not have been searched in an area of their size class yet.
+        auto startTime = m_searchStartTimes.find(sizeClass);
+        if (startTime == m_searchStartTimes.cend())
+        {
+            return;
+        }
+
+        const auto latency = detectionTime - startTime->second;
+
+        auto& stats = m_detectionLatencies[sizeClass];
+        ++stats.Count;
+        stats.Total += latency;
+        stats.Max = (max)(stats.Max, latency);
+
+        wostringstream message;
+        message << L"Detected a model of size class " << sizeClass
+            << L" (half diagonal up to " << ModelExtentsIndex::GetSizeClassMaxDiagonal(sizeClass) << L" m) after "
+            << duration_cast<milliseconds>(latency).count() << L" ms; average "
+            << duration_cast<milliseconds>(stats.Total / stats.Count).count() << L" ms, max "
+            << duration_cast<milliseconds>(stats.Max).count() << L" ms over " << stats.Count << L" detections\n";
+
+        OutputDebugStringW(message.str().c_str());
+    }
 }
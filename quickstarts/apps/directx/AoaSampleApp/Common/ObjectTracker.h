@@ -5,12 +5,20 @@
 #include <DirectXMath.h>
 #include <DirectXCollision.h>
 
+#include "DiagnosticsRing.h"
+#include "DiagnosticsUploader.h"
+#include "ModelExtentsIndex.h"
+#include "SceneLayout.h"
+
 #include <winrt/Microsoft.Azure.ObjectAnchors.h>
 #include <winrt/Microsoft.Azure.ObjectAnchors.Diagnostics.h>
 #include <winrt/Microsoft.Azure.ObjectAnchors.SpatialGraph.h>
 #include <winrt/Windows.Foundation.h>
 #include <winrt/Windows.Perception.Spatial.h>
 
+#include <chrono>
+#include <functional>
+#include <map>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -34,15 +42,66 @@ namespace AoaSampleApp
         ObjectTracker(winrt::Microsoft::Azure::ObjectAnchors::AccountInformation const& accountInformation);
         ~ObjectTracker();
 
+        // Completes once access is granted and the observer is created.
+        winrt::Windows::Foundation::IAsyncAction WaitForInitializationAsync();
+
         winrt::Windows::Foundation::IAsyncOperation<winrt::guid> AddObjectModelAsync(winrt::Windows::Storage::StorageFile file);
+        winrt::Windows::Foundation::IAsyncOperation<winrt::guid> AddObjectModelAsync(winrt::array_view<uint8_t const> data);
         winrt::Microsoft::Azure::ObjectAnchors::ObjectModel GetObjectModel(winrt::guid const& id) const;
+        std::vector<winrt::Microsoft::Azure::ObjectAnchors::ObjectModel> GetObjectModels() const;
+
+        // Extents of the models currently loaded, maintained as models are added and removed.
+        ModelExtentsSummary GetModelExtentsSummary() const;
+        std::vector<std::pair<ModelExtentsIndex::SizeClass, ModelExtentsSummary>> GetModelSizeClassSummaries() const;
+
+        // Stops detecting and tracking a model. Instances of the model are closed immediately.
+        void RemoveObjectModel(winrt::guid const& id);
 
+        // Models in a size class with an area in sizeClassSearchAreas are searched there, others in searchArea.
         winrt::Windows::Foundation::IAsyncAction DetectAsync(
+            winrt::Windows::Perception::Spatial::Preview::SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame,
+            winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea const& searchArea,
+            std::map<ModelExtentsIndex::SizeClass, winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea> sizeClassSearchAreas = {});
+
+        // Changes where models not detected yet are searched, for all size classes. Unlike DetectAsync, keeps the
+        // instances being tracked.
+        void SetSearchArea(
             winrt::Windows::Perception::Spatial::Preview::SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame,
             winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea const& searchArea);
 
+        // Relative poses of models in a fixed arrangement, used to search the neighbors of detected models.
+        void SetSceneLayout(SceneLayout layout);
+
+        // Searches the neighbors of a model, not detected yet, in tight areas where the scene layout expects
+        // them. The pose is the one of the model's origin in the coordinate system of the reference frame.
+        // These areas are searched before any other for a few detection passes.
+        void SearchNeighbors(
+            winrt::guid const& modelId,
+            winrt::Windows::Perception::Spatial::Preview::SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame,
+            winrt::Windows::Foundation::Numerics::float3 const& position,
+            winrt::Windows::Foundation::Numerics::quaternion const& orientation);
+
+        // Searches a model, not detected yet, in a tight area around the pose it's expected at, e.g. where it was
+        // last seen. Like the neighbors, it's searched before any other area for a few detection passes.
+        void SearchAtExpectedPose(
+            winrt::guid const& modelId,
+            winrt::Windows::Perception::Spatial::Preview::SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame,
+            winrt::Windows::Foundation::Numerics::float3 const& position,
+            winrt::Windows::Foundation::Numerics::quaternion const& orientation,
+            float tolerance);
+
         winrt::Windows::Foundation::IAsyncAction StartDiagnosticsAsync();
         winrt::Windows::Foundation::IAsyncOperation<winrt::hstring> StopDiagnosticsAsync();
+
+        // Captures diagnostics continuously within the given limits. The capture is only kept when a flush is
+        // requested, e.g. on tracking loss or a frame hitch; StopDiagnosticsAsync then returns no file to upload.
+        winrt::Windows::Foundation::IAsyncAction StartDiagnosticsRingAsync(DiagnosticsRingLimits const& limits);
+        void RequestDiagnosticsFlush(std::string reason);
+
+        // Captures diagnostics in short segments uploaded in the background while the capture runs, so that
+        // StopDiagnosticsAsync only closes the last segment and returns no file to upload. Segments not uploaded
+        // yet are uploaded by the next ObjectTracker.
+        winrt::Windows::Foundation::IAsyncAction StartDiagnosticsStreamAsync(DiagnosticsRingLimits const& limits);
         winrt::Windows::Foundation::IAsyncAction UploadDiagnosticsAsync(winrt::hstring const& diagnosticsFilePath);
 
         std::vector<TrackedObject> GetTrackedObjects(winrt::Windows::Perception::Spatial::SpatialCoordinateSystem coordinateSystem);
@@ -56,12 +115,35 @@ namespace AoaSampleApp
 
         winrt::Windows::Foundation::IAsyncAction InitializeAsync(winrt::Microsoft::Azure::ObjectAnchors::AccountInformation const& accountInformation);
 
+        winrt::Windows::Foundation::IAsyncAction StartSegmentedDiagnosticsAsync(
+            DiagnosticsRingLimits const& limits,
+            std::wstring segmentFolderName,
+            std::function<void(std::wstring const& segmentPath)> segmentSink);
+
+        // Claims the diagnostics slot for a new session or ring, unless one exists or is being started.
+        bool TryBeginDiagnosticsStart();
+
         void OnInstanceStateChanged(
             winrt::Windows::Foundation::IInspectable sender,
             winrt::Microsoft::Azure::ObjectAnchors::ObjectInstanceChangedEventArgs args);
 
+        void AddTargetedSearchArea(
+            winrt::guid const& modelId,
+            winrt::Windows::Perception::Spatial::Preview::SpatialGraphInteropFrameOfReferencePreview const& interopReferenceFrame,
+            winrt::Windows::Foundation::Numerics::float3 const& position,
+            winrt::Windows::Foundation::Numerics::quaternion const& orientation,
+            float tolerance);
+
         void DetectionThreadFunc();
 
+        // Replaces the search areas, restarting the search time of the size classes whose area changed.
+        void ReplaceSearchAreas(
+            winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea const& searchArea,
+            std::map<ModelExtentsIndex::SizeClass, winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea> sizeClassSearchAreas);
+
+        // Logs the time from searching a model's size class in its current area to detecting the model.
+        void RecordDetectionLatency(winrt::guid const& modelId, std::chrono::steady_clock::time_point detectionTime);
+
     private:
 
         shared_awaitable<winrt::Windows::Foundation::IAsyncAction> m_initOperation{ nullptr };
@@ -69,8 +151,17 @@ namespace AoaSampleApp
         winrt::Microsoft::Azure::ObjectAnchors::ObjectAnchorsSession m_session{ nullptr };
         winrt::Microsoft::Azure::ObjectAnchors::ObjectObserver m_observer{ nullptr };
         winrt::Microsoft::Azure::ObjectAnchors::Diagnostics::ObjectDiagnosticsSession m_diagnostics{ nullptr };
+        std::unique_ptr<DiagnosticsRing> m_diagnosticsRing;
+        std::unique_ptr<DiagnosticsUploader> m_diagnosticsUploader;
+
+        // Set while a diagnostics session or ring is being created, so that concurrent starts create only one.
+        bool m_diagnosticsStarting{ false };
 
         std::unordered_map<winrt::guid, winrt::Microsoft::Azure::ObjectAnchors::ObjectModel> m_models;
+        ModelExtentsIndex m_modelExtents;
+
+        // Removed models that may still be referenced by an in-flight detection, closed by the detection thread.
+        std::vector<winrt::Microsoft::Azure::ObjectAnchors::ObjectModel> m_retiredModels;
 
         struct ObjectInstanceMetadata
         {
@@ -90,6 +181,29 @@ namespace AoaSampleApp
 
         winrt::Windows::Perception::Spatial::Preview::SpatialGraphInteropFrameOfReferencePreview m_interopReferenceFrame{ nullptr };
         winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea m_searchArea{ nullptr };
+        std::map<ModelExtentsIndex::SizeClass, winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea> m_sizeClassSearchAreas;
+
+        // Time each size class started being searched in its current area.
+        std::map<ModelExtentsIndex::SizeClass, std::chrono::steady_clock::time_point> m_searchStartTimes;
+
+        struct DetectionLatency
+        {
+            uint32_t Count{ 0 };
+            std::chrono::steady_clock::duration Total{ 0 };
+            std::chrono::steady_clock::duration Max{ 0 };
+        };
+
+        std::map<ModelExtentsIndex::SizeClass, DetectionLatency> m_detectionLatencies;
+
+        SceneLayout m_sceneLayout;
+
+        struct TargetedSearchArea
+        {
+            winrt::Microsoft::Azure::ObjectAnchors::ObjectSearchArea SearchArea;
+            uint32_t RemainingPasses;
+        };
+
+        std::unordered_map<winrt::guid, TargetedSearchArea> m_targetedSearchAreas;
         winrt::Microsoft::Azure::ObjectAnchors::ObjectInstanceTrackingMode m_trackingMode{ winrt::Microsoft::Azure::ObjectAnchors::ObjectInstanceTrackingMode::LowLatencyCoarsePosition };
         float m_maxScaleChange{ 0.1f };
     };
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "PointCloudDownsampler.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    // Levels stop once they would keep more than this fraction of the previous level's points.
+    constexpr float c_minReduction = 0.75f;
+
+    using CellKey = uint64_t;
+
+    // 21 bits per axis, relative to the minimum of the cloud.
+    CellKey GetCellKey(uint32_t x, uint32_t y, uint32_t z)
+    {
+        constexpr uint64_t c_mask = (1ull << 21) - 1;
+        return ((x & c_mask) << 42) | ((y & c_mask) << 21) | (z & c_mask);
+    }
+
+    struct Cell
+    {
+        uint32_t Index;
+        float DistanceSquared;
+    };
+}
+
+namespace AoaSampleApp
+{
+    vector<uint32_t> DownsamplePointCloud(vector<XMFLOAT3> const& points, vector<uint32_t> const& indices, float leafSize)
+    {
+        if (indices.empty() || leafSize <= 0.0f)
+        {
+            return indices;
+        }
+
+        XMVECTOR minimum = g_XMFltMax;
+        XMVECTOR maximum = XMVectorNegate(g_XMFltMax);
+        for (const uint32_t index : indices)
+        {
+            const XMVECTOR point = XMLoadFloat3(&points[index]);
+            minimum = XMVectorMin(minimum, point);
+            maximum = XMVectorMax(maximum, point);
+        }
+
+        const XMVECTOR inverseLeafSize = XMVectorReplicate(1.0f / leafSize);
+        const XMVECTOR halfCell = XMVectorReplicate(0.5f);
+
+        // Clouds too large for the key range at this leaf size are returned as is.
+        XMFLOAT3 cellCounts;
+        XMStoreFloat3(&cellCounts, XMVectorMultiply(XMVectorSubtract(maximum, minimum), inverseLeafSize));
+        if ((max)((max)(cellCounts.x, cellCounts.y), cellCounts.z) >= static_cast<float>(1u << 21))
+        {
+            return indices;
+        }
+
+        unordered_map<CellKey, Cell> cells;
+        cells.reserve(indices.size() / 4);
+
+        for (const uint32_t index : indices)
+        {
+            // Position in cells, the cell it falls in, and its offset from the cell center.
+            const XMVECTOR position = XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&points[index]), minimum), inverseLeafSize);
+            const XMVECTOR cell = XMVectorFloor(position);
+            const XMVECTOR offset = XMVectorSubtract(position, XMVectorAdd(cell, halfCell));
+            const float distanceSquared = XMVectorGetX(XMVector3LengthSq(offset));
+
+            XMFLOAT3 cellIndex;
+            XMStoreFloat3(&cellIndex, cell);
+
+            const CellKey key = GetCellKey(static_cast<uint32_t>(cellIndex.x), static_cast<uint32_t>(cellIndex.y), static_cast<uint32_t>(cellIndex.z));
+
+            auto [it, inserted] = cells.try_emplace(key, Cell{ index, distanceSquared });
+            if (!inserted && distanceSquared < it->second.DistanceSquared)
+            {
+                it->second = { index, distanceSquared };
+            }
+        }
+
+        vector<uint32_t> downsampled;
+        downsampled.reserve(cells.size());
+
+        for (auto const& [key, cell] : cells)
+        {
+            downsampled.push_back(cell.Index);
+        }
+
+        // Keep the order of the input, which tends to be the scan order, for better vertex cache use.
+        sort(downsampled.begin(), downsampled.end());
+
+        return downsampled;
+    }
+
+    vector<MeshLevelOfDetail> BuildPointCloudLevelsOfDetail(vector<XMFLOAT3> const& points, vector<uint32_t>& indices, float leafSize, size_t levelCount)
+    {
+        vector<MeshLevelOfDetail> levels{ { 0, static_cast<uint32_t>(indices.size()) } };
+
+        // Each level is downsampled from the previous one, which has fewer points to go through.
+        vector<uint32_t> previous = indices;
+
+        while (levels.size() < levelCount)
+        {
+            auto downsampled = DownsamplePointCloud(points, previous, leafSize);
+            if (downsampled.size() > previous.size() * c_minReduction)
+            {
+                break;
+            }
+
+            levels.push_back({ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(downsampled.size()) });
+            indices.insert(indices.end(), downsampled.cbegin(), downsampled.cend());
+
+            previous = std::move(downsampled);
+            leafSize *= 2.0f;
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "MeshSimplifier.h"
+
+#include <DirectXMath.h>
+
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Downsamples a point cloud to at most one point per cell of a grid with edges of the leaf size, keeping
+    // the point closest to the cell center. Only the points of the given indices are considered, and the indices
+    // of the kept points are returned, so that downsampled clouds share the vertex buffer of the full one.
+    std::vector<uint32_t> DownsamplePointCloud(
+        std::vector<DirectX::XMFLOAT3> const& points,
+        std::vector<uint32_t> const& indices,
+        float leafSize);
+
+    // Appends preview point clouds to the indices, downsampled with the leaf size doubling at each level,
+    // until there are levelCount levels or a level no longer reduces the points. The full cloud is the first level.
+    std::vector<MeshLevelOfDetail> BuildPointCloudLevelsOfDetail(
+        std::vector<DirectX::XMFLOAT3> const& points,
+        std::vector<uint32_t>& indices,
+        float leafSize,
+        size_t levelCount);
+}
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "PositionQuantizer.h"
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+namespace AoaSampleApp
+{
+    PositionQuantizer::PositionQuantizer(XMFLOAT3 const* positions, size_t positionCount)
+    {
+        XMVECTOR minimum = g_XMFltMax;
+        XMVECTOR maximum = XMVectorNegate(g_XMFltMax);
+        for (size_t i = 0; i < positionCount; i++)
+        {
+            minimum = XMVectorMin(minimum, XMLoadFloat3(&positions[i]));
+            maximum = XMVectorMax(maximum, XMLoadFloat3(&positions[i]));
+        }
+
+        if (positionCount == 0)
+        {
+            minimum = maximum = XMVectorZero();
+        }
+
+        const XMVECTOR extents = XMVectorSubtract(maximum, minimum);
+
+        XMStoreFloat3(&m_minimum, minimum);
+        XMStoreFloat3(&m_extents, extents);
+        XMStoreFloat3(&m_inverseExtents, XMVectorSelect(XMVectorReciprocal(extents), XMVectorZero(), XMVectorEqual(extents, XMVectorZero())));
+    }
+
+    XMUSHORTN4 PositionQuantizer::Quantize(FXMVECTOR position) const
+    {
+        const XMVECTOR normalized = XMVectorMultiply(XMVectorSubtract(position, XMLoadFloat3(&m_minimum)), XMLoadFloat3(&m_inverseExtents));
+
+        XMUSHORTN4 quantized;
+        XMStoreUShortN4(&quantized, XMVectorSetW(normalized, 1.0f));
+        return quantized;
+    }
+
+    XMVECTOR PositionQuantizer::Dequantize(XMUSHORTN4 const& quantized) const
+    {
+        return XMVectorMultiplyAdd(XMLoadUShortN4(&quantized), XMLoadFloat3(&m_extents), XMLoadFloat3(&m_minimum));
+    }
+
+    XMMATRIX PositionQuantizer::GetPositionToPrimitive() const
+    {
+        return XMMatrixScalingFromVector(XMLoadFloat3(&m_extents)) * XMMatrixTranslationFromVector(XMLoadFloat3(&m_minimum));
+    }
+}
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+namespace AoaSampleApp
+{
+    // Quantizes positions to 16-bit normalized values within the bounding box of a set of positions, which
+    // halves the size of a float3 position at a step of a 65535th of the box along each axis.
+    class PositionQuantizer
+    {
+    public:
+        PositionQuantizer(DirectX::XMFLOAT3 const* positions, size_t positionCount);
+
+        DirectX::PackedVector::XMUSHORTN4 Quantize(DirectX::FXMVECTOR position) const;
+
+        // Position the quantized value maps back to through GetPositionToPrimitive.
+        DirectX::XMVECTOR Dequantize(DirectX::PackedVector::XMUSHORTN4 const& quantized) const;
+
+        // Maps normalized positions back into the space of the positions, for the model transform.
+        DirectX::XMMATRIX GetPositionToPrimitive() const;
+
+    private:
+        DirectX::XMFLOAT3 m_minimum;
+        DirectX::XMFLOAT3 m_extents;
+
+        // Zero along axes where the box is flat, which quantize to 0.
+        DirectX::XMFLOAT3 m_inverseExtents;
+    };
+}
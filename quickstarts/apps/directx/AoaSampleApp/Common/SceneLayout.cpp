@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "SceneLayout.h"
+
+using namespace std;
+using namespace DirectX;
+
+namespace AoaSampleApp
+{
+    void SceneLayoutNeighbor::GetPose(XMFLOAT3 const& modelPosition, XMFLOAT4 const& modelOrientation, XMFLOAT3& position, XMFLOAT4& orientation) const
+    {
+        const XMVECTOR modelRotation = XMLoadFloat4(&modelOrientation);
+
+        XMStoreFloat3(&position, XMVectorAdd(XMLoadFloat3(&modelPosition), XMVector3Rotate(XMLoadFloat3(&Position), modelRotation)));
+        XMStoreFloat4(&orientation, XMQuaternionMultiply(XMLoadFloat4(&Orientation), modelRotation));
+    }
+
+    void SceneLayout::AddRelation(Guid const& modelId, Guid const& neighborId, XMFLOAT3 const& position, XMFLOAT4 const& orientation, float tolerance)
+    {
+        m_neighbors[modelId].push_back({ neighborId, position, orientation, tolerance });
+
+        // Pose of the model relative to the neighbor.
+        const XMVECTOR inverseOrientation = XMQuaternionInverse(XMLoadFloat4(&orientation));
+
+        SceneLayoutNeighbor model{ modelId, {}, {}, tolerance };
+        XMStoreFloat3(&model.Position, XMVector3Rotate(XMVectorNegate(XMLoadFloat3(&position)), inverseOrientation));
+        XMStoreFloat4(&model.Orientation, inverseOrientation);
+        m_neighbors[neighborId].push_back(model);
+    }
+
+    vector<SceneLayoutNeighbor> const& SceneLayout::GetNeighbors(Guid const& modelId) const
+    {
+        static const vector<SceneLayoutNeighbor> s_noNeighbors;
+
+        auto it = m_neighbors.find(modelId);
+        return it == m_neighbors.cend() ? s_noNeighbors : it->second;
+    }
+}
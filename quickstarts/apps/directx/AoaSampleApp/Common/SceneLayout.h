@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "Guid.h"
+
+#include <DirectXMath.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Expected pose of a model relative to another one, with the distance it may be off by.
+    struct SceneLayoutNeighbor
+    {
+        Guid ModelId;
+        DirectX::XMFLOAT3 Position;
+        DirectX::XMFLOAT4 Orientation;      // Quaternion.
+        float Tolerance;
+
+        // Pose of the neighbor in the coordinate system of the model's pose.
+        void GetPose(
+            DirectX::XMFLOAT3 const& modelPosition,
+            DirectX::XMFLOAT4 const& modelOrientation,
+            DirectX::XMFLOAT3& position,
+            DirectX::XMFLOAT4& orientation) const;
+    };
+
+    // Relative poses between models that sit in a fixed arrangement, so that once one of them is detected
+    // the others can be searched in tight areas where they're expected.
+    //
+    // The layout is read from JSON by ParseSceneLayout, with the pose of each neighbor in the coordinate system
+    // of the model:
+    //
+    //    {
+    //      "Relations": [
+    //        {
+    //          "Model": "<model id>",
+    //          "Neighbor": "<model id>",
+    //          "Position": [ x, y, z ],
+    //          "Orientation": [ x, y, z, w ],
+    //          "Tolerance": 0.25
+    //        }
+    //      ]
+    //    }
+    //
+    // Relations apply both ways. Orientation and Tolerance are optional.
+    class SceneLayout
+    {
+    public:
+        void AddRelation(
+            Guid const& modelId,
+            Guid const& neighborId,
+            DirectX::XMFLOAT3 const& position,
+            DirectX::XMFLOAT4 const& orientation,
+            float tolerance);
+
+        std::vector<SceneLayoutNeighbor> const& GetNeighbors(Guid const& modelId) const;
+
+        bool Empty() const { return m_neighbors.empty(); }
+
+    private:
+        std::unordered_map<Guid, std::vector<SceneLayoutNeighbor>> m_neighbors;
+    };
+}
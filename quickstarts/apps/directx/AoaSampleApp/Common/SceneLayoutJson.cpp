@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "SceneLayoutJson.h"
+
+#include <winrt/Windows.Data.Json.h>
+
+using namespace std;
+using namespace DirectX;
+using namespace winrt::Windows::Data::Json;
+
+namespace
+{
+    constexpr float c_defaultTolerance = 0.25f;
+
+    vector<float> GetNamedNumbers(JsonObject const& json, winrt::hstring const& name, size_t count)
+    {
+        auto array = json.GetNamedArray(name);
+        if (array.Size() != count)
+        {
+            throw invalid_argument(winrt::to_string(name) + " must have " + to_string(count) + " numbers");
+        }
+
+        vector<float> numbers;
+        for (auto const& value : array)
+        {
+            numbers.push_back(static_cast<float>(value.GetNumber()));
+        }
+
+        return numbers;
+    }
+}
+
+namespace AoaSampleApp
+{
+    SceneLayout ParseSceneLayout(winrt::hstring const& json)
+    {
+        SceneLayout layout;
+
+        for (auto const& value : JsonObject::Parse(json).GetNamedArray(L"Relations"))
+        {
+            auto relation = value.GetObject();
+
+            const auto position = GetNamedNumbers(relation, L"Position", 3);
+
+            XMFLOAT4 orientation{ 0.0f, 0.0f, 0.0f, 1.0f };
+            if (relation.HasKey(L"Orientation"))
+            {
+                const auto numbers = GetNamedNumbers(relation, L"Orientation", 4);
+                XMStoreFloat4(&orientation, XMQuaternionNormalize(XMVectorSet(numbers[0], numbers[1], numbers[2], numbers[3])));
+            }
+
+            layout.AddRelation(
+                winrt::guid{ relation.GetNamedString(L"Model") },
+                winrt::guid{ relation.GetNamedString(L"Neighbor") },
+                { position[0], position[1], position[2] },
+                orientation,
+                static_cast<float>(relation.GetNamedNumber(L"Tolerance", c_defaultTolerance)));
+        }
+
+        return layout;
+    }
+}
@@ -0,0 +1,13 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "SceneLayout.h"
+
+#include <winrt/Windows.Foundation.h>
+
+namespace AoaSampleApp
+{
+    // Reads a scene layout from JSON, in the format described by SceneLayout. Throws if the JSON is malformed.
+    SceneLayout ParseSceneLayout(winrt::hstring const& json);
+}
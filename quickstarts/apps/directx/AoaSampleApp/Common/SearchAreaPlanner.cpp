@@ -0,0 +1,254 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "SearchAreaPlanner.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace DirectX;
+
+namespace
+{
+    constexpr float c_pi = 3.1415926f;
+    constexpr float c_degreesToRadians = c_pi / 180.0f;
+
+    // Same relaxation as the areas placed by air-tap, so that a model at any orientation fits.
+    constexpr float c_relaxScale = 1.50f;
+
+    constexpr float c_yawStepInDegrees = 15.0f;
+    constexpr float c_lowerPitchOffsetInDegrees = -20.0f;
+
+    float GetYaw(FXMVECTOR direction)
+    {
+        return atan2f(XMVectorGetX(direction), XMVectorGetZ(direction));
+    }
+
+    XMVECTOR GetDirection(float yaw, float pitch)
+    {
+        return XMVectorSet(sinf(yaw) * cosf(pitch), sinf(pitch), cosf(yaw) * cosf(pitch), 0.0f);
+    }
+
+    // Rotation about the vertical axis, as the areas are kept upright.
+    XMFLOAT4 GetYawOrientation(float yaw)
+    {
+        XMFLOAT4 orientation;
+        XMStoreFloat4(&orientation, XMQuaternionRotationAxis(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), yaw));
+        return orientation;
+    }
+}
+
+namespace AoaSampleApp
+{
+    SearchAreaPlanner::SearchAreaPlanner(SearchAreaPlannerSettings const& settings)
+        : m_settings(settings)
+    {
+    }
+
+    template <typename Func>
+    void SearchAreaPlanner::ForEachVoxel(SearchAreaProposal const& area, Func&& func) const
+    {
+        const XMVECTOR halfExtents = XMVectorScale(XMLoadFloat3(&area.Extents), 0.5f);
+        const XMVECTOR orientation = XMLoadFloat4(&area.Orientation);
+
+        // Axes of the area, and its axis aligned bounds.
+        const XMVECTOR axisX = XMVector3Rotate(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), orientation);
+        const XMVECTOR axisY = XMVector3Rotate(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), orientation);
+        const XMVECTOR axisZ = XMVector3Rotate(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), orientation);
+
+        const XMVECTOR boundsHalfExtents = XMVectorAdd(XMVectorAdd(
+            XMVectorMultiply(XMVectorAbs(axisX), XMVectorSplatX(halfExtents)),
+            XMVectorMultiply(XMVectorAbs(axisY), XMVectorSplatY(halfExtents))),
+            XMVectorMultiply(XMVectorAbs(axisZ), XMVectorSplatZ(halfExtents)));
+
+        const XMVECTOR center = XMLoadFloat3(&area.Center);
+
+        XMFLOAT3 minimum;
+        XMFLOAT3 maximum;
+        XMStoreFloat3(&minimum, XMVectorScale(XMVectorSubtract(center, boundsHalfExtents), 1.0f / m_settings.VoxelSize));
+        XMStoreFloat3(&maximum, XMVectorScale(XMVectorAdd(center, boundsHalfExtents), 1.0f / m_settings.VoxelSize));
+
+        // Test the centers of the voxels within the bounds against the area in batches.
+        m_voxelCenters.Clear();
+        m_voxelKeys.clear();
+
+        for (int32_t z = static_cast<int32_t>(floorf(minimum.z)); z <= static_cast<int32_t>(floorf(maximum.z)); ++z)
+        {
+            for (int32_t y = static_cast<int32_t>(floorf(minimum.y)); y <= static_cast<int32_t>(floorf(maximum.y)); ++y)
+            {
+                for (int32_t x = static_cast<int32_t>(floorf(minimum.x)); x <= static_cast<int32_t>(floorf(maximum.x)); ++x)
+                {
+                    m_voxelCenters.Add({ (x + 0.5f) * m_settings.VoxelSize, (y + 0.5f) * m_settings.VoxelSize, (z + 0.5f) * m_settings.VoxelSize });
+                    m_voxelKeys.push_back(GetVoxelKey(x, y, z));
+                }
+            }
+        }
+
+        BoundingOrientedBox box;
+        box.Center = area.Center;
+        XMStoreFloat3(&box.Extents, halfExtents);
+        box.Orientation = area.Orientation;
+
+        IntersectBatch(box, m_voxelCenters, m_voxelInside);
+
+        for (size_t i = 0; i < m_voxelKeys.size(); ++i)
+        {
+            if (m_voxelInside[i] != 0)
+            {
+                func(m_voxelKeys[i]);
+            }
+        }
+    }
+
+    SearchAreaPlanner::VoxelKey SearchAreaPlanner::GetVoxelKey(int32_t x, int32_t y, int32_t z) const
+    {
+        // 21 bits per axis covers over 250 km at the default voxel size.
+        constexpr int32_t c_bias = 1 << 20;
+        constexpr uint64_t c_mask = (1ull << 21) - 1;
+
+        return ((static_cast<uint64_t>(x + c_bias) & c_mask) << 42) |
+            ((static_cast<uint64_t>(y + c_bias) & c_mask) << 21) |
+            (static_cast<uint64_t>(z + c_bias) & c_mask);
+    }
+
+    uint32_t SearchAreaPlanner::CountUnsearchedVoxels(SearchAreaProposal const& area, steady_clock::time_point now) const
+    {
+        uint32_t unsearchedCount = 0;
+        ForEachVoxel(area, [&](VoxelKey key)
+        {
+            auto it = m_searchedVoxels.find(key);
+            if (it == m_searchedVoxels.cend() || now - it->second > m_settings.CoverageLifetime)
+            {
+                ++unsearchedCount;
+            }
+        });
+
+        return unsearchedCount;
+    }
+
+    optional<SearchAreaProposal> SearchAreaPlanner::Propose(
+        PredictedHeadPose const& headPose,
+        ModelExtentsSummary const& models,
+        vector<XMFLOAT3> const& priorLocations,
+        steady_clock::time_point now) const
+    {
+        if (models.ModelCount == 0)
+        {
+            return nullopt;
+        }
+
+        const XMVECTOR predictedPosition = XMLoadFloat3(&headPose.Position);
+        const float predictedYaw = GetYaw(XMLoadFloat3(&headPose.ForwardDirection));
+        const float pitch = asinf(std::clamp(headPose.ForwardDirection.y, -1.0f, 1.0f));
+
+        //
+        // Size candidate areas to cover the largest models.
+        //
+
+        const float requiredScale = models.MaxModelExtent > 0.0f ? models.MaxModelDiagonal * c_relaxScale / models.MaxModelExtent : 1.0f;
+
+        XMFLOAT3 extents;
+        extents.x = (max)(models.MaxExtents.x * requiredScale * 2.0f, m_settings.MinAreaSize);
+        extents.y = (max)(models.MaxExtents.y * requiredScale * 2.0f, m_settings.MinAreaSize);
+        extents.z = (max)(models.MaxExtents.z * requiredScale * 2.0f, m_settings.MinAreaSize);
+
+        const float maxEdge = (max)((max)(extents.x, extents.y), extents.z);
+        const float nearDistance = 0.5f * maxEdge + 0.5f;
+        const array<float, 2> distances{ nearDistance, nearDistance + maxEdge };
+        const array<float, 2> pitches{ pitch, pitch + c_lowerPitchOffsetInDegrees * c_degreesToRadians };
+
+        const XMVECTOR predictedGaze = GetDirection(predictedYaw, pitch);
+
+        //
+        // Search where models were seen before first, once they're about to be in view.
+        //
+
+        for (auto const& priorLocation : priorLocations)
+        {
+            const XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&priorLocation), predictedPosition);
+            const float distance = XMVectorGetX(XMVector3Length(offset));
+            if (distance > m_settings.MaxPriorDistance || (distance > 0.0f && XMVectorGetX(XMVector3Dot(offset, predictedGaze)) <= 0.0f))
+            {
+                continue;
+            }
+
+            SearchAreaProposal area;
+            area.Center = priorLocation;
+            area.Orientation = GetYawOrientation(GetYaw(offset));
+            area.Extents = extents;
+
+            if (CountUnsearchedVoxels(area, now) > 0)
+            {
+                return area;
+            }
+        }
+
+        //
+        // Pick the candidate expected to cover the most unsearched space.
+        //
+
+        optional<SearchAreaProposal> bestArea;
+        float bestScore = 0.0f;
+
+        for (float yawOffset = -m_settings.MaxYawOffsetInDegrees; yawOffset <= m_settings.MaxYawOffsetInDegrees; yawOffset += c_yawStepInDegrees)
+        {
+            const float yaw = predictedYaw + yawOffset * c_degreesToRadians;
+
+            for (const float candidatePitch : pitches)
+            {
+                const XMVECTOR direction = GetDirection(yaw, candidatePitch);
+
+                // Areas away from the gaze are only searched once the user turns towards them.
+                const float viewWeight = XMVectorGetX(XMVector3Dot(direction, predictedGaze));
+                if (viewWeight <= 0.0f)
+                {
+                    continue;
+                }
+
+                for (const float distance : distances)
+                {
+                    SearchAreaProposal area;
+                    XMStoreFloat3(&area.Center, XMVectorMultiplyAdd(direction, XMVectorReplicate(distance), predictedPosition));
+                    area.Orientation = GetYawOrientation(yaw);
+                    area.Extents = extents;
+
+                    const uint32_t unsearchedCount = CountUnsearchedVoxels(area, now);
+
+                    // Closer areas are observed in more detail.
+                    const float score = unsearchedCount * viewWeight / distance;
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestArea = area;
+                    }
+                }
+            }
+        }
+
+        return bestArea;
+    }
+
+    void SearchAreaPlanner::MarkSearched(SearchAreaProposal const& area, steady_clock::time_point now)
+    {
+        for (auto it = m_searchedVoxels.begin(); it != m_searchedVoxels.end();)
+        {
+            if (now - it->second > m_settings.CoverageLifetime)
+            {
+                it = m_searchedVoxels.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        ForEachVoxel(area, [&](VoxelKey key)
+        {
+            m_searchedVoxels.insert_or_assign(key, now);
+        });
+    }
+
+    void SearchAreaPlanner::ResetCoverage()
+    {
+        m_searchedVoxels.clear();
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "BoundingVolumeBatch.h"
+#include "HeadPosePredictor.h"
+#include "ModelExtentsIndex.h"
+
+#include <DirectXMath.h>
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    struct SearchAreaPlannerSettings
+    {
+        // Edge length of the cells of the coverage map.
+        float VoxelSize{ 0.25f };
+
+        // Searched space becomes worth searching again after this long, as the user may have moved objects
+        // or the device may have observed more of the environment.
+        std::chrono::seconds CoverageLifetime{ 60 };
+
+        // Candidate areas are spread around the predicted gaze direction within this angle.
+        float MaxYawOffsetInDegrees{ 60.0f };
+
+        // Smallest edge length of a proposed area, so that small models don't lead to tiny areas.
+        float MinAreaSize{ 1.0f };
+
+        // Locations where models were seen before are only proposed within this distance of the user.
+        float MaxPriorDistance{ 10.0f };
+    };
+
+    // An oriented box to search, with edge-to-edge extents as in SpatialOrientedBox.
+    struct SearchAreaProposal
+    {
+        DirectX::XMFLOAT3 Center;
+        DirectX::XMFLOAT4 Orientation;     // Quaternion.
+        DirectX::XMFLOAT3 Extents;
+    };
+
+    // Proposes search areas without user input, so that space around the user gets searched as they look around.
+    //
+    // Space already searched is recorded in a sparse voxel map. Candidate boxes, sized for the models, are placed
+    // around the predicted head pose, and the one covering the most unsearched space is proposed,
+    // weighted by how directly it will be in view since detection relies on what the device observes.
+    // Locations where models were seen before are proposed first, as long as they weren't searched recently.
+    class SearchAreaPlanner
+    {
+    public:
+        SearchAreaPlanner(SearchAreaPlannerSettings const& settings = {});
+
+        // Returns nothing if all candidate areas were searched recently.
+        // Prior locations are ordered by decreasing likelihood of finding a model there.
+        std::optional<SearchAreaProposal> Propose(
+            PredictedHeadPose const& headPose,
+            ModelExtentsSummary const& models,
+            std::vector<DirectX::XMFLOAT3> const& priorLocations,
+            std::chrono::steady_clock::time_point now) const;
+
+        void MarkSearched(SearchAreaProposal const& area, std::chrono::steady_clock::time_point now);
+
+        // Forgets the searched space, e.g. when the models changed.
+        void ResetCoverage();
+
+    private:
+        using VoxelKey = uint64_t;
+
+        // Calls the function with the key of each voxel whose center is inside the area.
+        template <typename Func>
+        void ForEachVoxel(SearchAreaProposal const& area, Func&& func) const;
+
+        VoxelKey GetVoxelKey(int32_t x, int32_t y, int32_t z) const;
+
+        uint32_t CountUnsearchedVoxels(SearchAreaProposal const& area, std::chrono::steady_clock::time_point now) const;
+
+        SearchAreaPlannerSettings m_settings;
+
+        // Time each voxel was last searched.
+        std::unordered_map<VoxelKey, std::chrono::steady_clock::time_point> m_searchedVoxels;
+
+        // Voxels tested by ForEachVoxel, kept across calls to reuse their storage.
+        mutable SphereBatch m_voxelCenters;
+        mutable std::vector<VoxelKey> m_voxelKeys;
+        mutable std::vector<uint8_t> m_voxelInside;
+    };
+}
@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "SightingIndex.h"
+#include "DirectFileRead.h"
+
+#ifndef _WIN32
+#include <filesystem>
+#include <fstream>
+#endif
+
+using namespace std;
+using namespace DirectX;
+
+namespace
+{
+    constexpr uint32_t c_indexMagic = 0x53414f41; // 'AOAS'
+    constexpr uint32_t c_indexVersion = 1;
+
+    // Layout of the index file:
+    //
+    //    IndexHeader
+    //    IndexRecord[RecordCount]      one record per cell
+    struct IndexHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t RecordCount;
+        uint32_t Reserved;
+    };
+
+    struct IndexRecord
+    {
+        AoaSampleApp::Guid ModelId;
+        float Position[3];              // Mean position of the sightings in the cell.
+        uint32_t SightingCount;
+    };
+
+    static_assert(sizeof(IndexHeader) == 16, "Index header layout must not change within a version.");
+    static_assert(sizeof(IndexRecord) == 32, "Index record layout must not change within a version.");
+
+    // Writes to a temporary file first so that a crash never leaves a partially written file behind.
+    bool WriteFileAtomically(wstring const& path, vector<uint8_t> const& data)
+    {
+        const wstring temporaryPath = path + L".tmp";
+
+#ifdef _WIN32
+        {
+            winrt::file_handle file{ ::CreateFile2(temporaryPath.c_str(), GENERIC_WRITE, 0, CREATE_ALWAYS, nullptr) };
+            if (!file)
+            {
+                return false;
+            }
+
+            DWORD written = 0;
+            if (!::WriteFile(file.get(), data.data(), static_cast<DWORD>(data.size()), &written, nullptr) || written != data.size())
+            {
+                return false;
+            }
+        }
+
+        return ::MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+        {
+            ofstream file(filesystem::path(temporaryPath), ios::binary | ios::trunc);
+            if (!file.write(reinterpret_cast<char const*>(data.data()), data.size()))
+            {
+                return false;
+            }
+        }
+
+        error_code error;
+        filesystem::rename(temporaryPath, path, error);
+        return !error;
+#endif
+    }
+}
+
+namespace AoaSampleApp
+{
+    SightingIndex::SightingIndex(float cellSize)
+        : m_cellSize(cellSize)
+    {
+    }
+
+    bool SightingIndex::Load(wstring const& indexPath)
+    {
+        vector<uint8_t> data;
+        if (!TryReadFileDirect(indexPath, data))
+        {
+            Clear();
+            m_changed = false;
+            return false;
+        }
+
+        return Decode(data.data(), data.size());
+    }
+
+    void SightingIndex::SaveIfChanged(wstring const& indexPath)
+    {
+        if (m_changed && WriteFileAtomically(indexPath, Encode()))
+        {
+            m_changed = false;
+        }
+    }
+
+    vector<uint8_t> SightingIndex::Encode() const
+    {
+        size_t recordCount = 0;
+        for (auto const& [modelId, cells] : m_models)
+        {
+            recordCount += cells.size();
+        }
+
+        IndexHeader header{};
+        header.Magic = c_indexMagic;
+        header.Version = c_indexVersion;
+        header.RecordCount = static_cast<uint32_t>(recordCount);
+
+        vector<uint8_t> data(sizeof(IndexHeader) + recordCount * sizeof(IndexRecord));
+        memcpy(data.data(), &header, sizeof(header));
+
+        size_t offset = sizeof(IndexHeader);
+        for (auto const& [modelId, cells] : m_models)
+        {
+            for (auto const& [key, cell] : cells)
+            {
+                const float scale = 1.0f / static_cast<float>(cell.SightingCount);
+
+                IndexRecord record{};
+                record.ModelId = modelId;
+                record.Position[0] = cell.PositionSum.x * scale;
+                record.Position[1] = cell.PositionSum.y * scale;
+                record.Position[2] = cell.PositionSum.z * scale;
+                record.SightingCount = cell.SightingCount;
+
+                memcpy(data.data() + offset, &record, sizeof(record));
+                offset += sizeof(record);
+            }
+        }
+
+        return data;
+    }
+
+    bool SightingIndex::Decode(uint8_t const* data, size_t size)
+    {
+        m_models.clear();
+        m_sightingCount = 0;
+        m_changed = false;
+
+        IndexHeader header{};
+        if (size < sizeof(IndexHeader))
+        {
+            return false;
+        }
+
+        memcpy(&header, data, sizeof(header));
+        if (header.Magic != c_indexMagic ||
+            header.Version != c_indexVersion ||
+            sizeof(IndexHeader) + uint64_t{ header.RecordCount } * sizeof(IndexRecord) != size)
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < header.RecordCount; ++i)
+        {
+            IndexRecord record;
+            memcpy(&record, data + sizeof(IndexHeader) + i * sizeof(IndexRecord), sizeof(record));
+
+            AddToCell(record.ModelId, { record.Position[0], record.Position[1], record.Position[2] }, record.SightingCount);
+        }
+
+        return true;
+    }
+
+    void SightingIndex::Add(Guid const& modelId, XMFLOAT3 const& position)
+    {
+        AddToCell(modelId, position, 1);
+        m_changed = true;
+    }
+
+    void SightingIndex::Clear()
+    {
+        m_changed |= !m_models.empty();
+
+        m_models.clear();
+        m_sightingCount = 0;
+    }
+
+    vector<PriorLocation> SightingIndex::GetPriorLocations(vector<Guid> const& modelIds, size_t maxCount) const
+    {
+        vector<PriorLocation> locations;
+
+        for (auto const& modelId : modelIds)
+        {
+            auto it = m_models.find(modelId);
+            if (it == m_models.cend())
+            {
+                continue;
+            }
+
+            for (auto const& [key, cell] : it->second)
+            {
+                const float scale = 1.0f / static_cast<float>(cell.SightingCount);
+                locations.push_back({ modelId, { cell.PositionSum.x * scale, cell.PositionSum.y * scale, cell.PositionSum.z * scale }, cell.SightingCount });
+            }
+        }
+
+        // Only the most sighted cells are sorted, the index may hold many more.
+        const size_t count = (min)(maxCount, locations.size());
+        partial_sort(locations.begin(), locations.begin() + count, locations.end(), [](auto const& lhs, auto const& rhs)
+        {
+            return lhs.SightingCount > rhs.SightingCount;
+        });
+
+        locations.resize(count);
+        return locations;
+    }
+
+    SightingIndex::CellKey SightingIndex::GetCellKey(XMFLOAT3 const& position) const
+    {
+        // 21 bits per axis, as in the search area planner's coverage map.
+        constexpr int32_t c_bias = 1 << 20;
+        constexpr uint64_t c_mask = (1ull << 21) - 1;
+
+        const int32_t x = static_cast<int32_t>(floorf(position.x / m_cellSize));
+        const int32_t y = static_cast<int32_t>(floorf(position.y / m_cellSize));
+        const int32_t z = static_cast<int32_t>(floorf(position.z / m_cellSize));
+
+        return ((static_cast<uint64_t>(x + c_bias) & c_mask) << 42) |
+            ((static_cast<uint64_t>(y + c_bias) & c_mask) << 21) |
+            (static_cast<uint64_t>(z + c_bias) & c_mask);
+    }
+
+    void SightingIndex::AddToCell(Guid const& modelId, XMFLOAT3 const& position, uint32_t sightingCount)
+    {
+        // Loaded cells hold the mean position of their sightings, weighted back by their count.
+        const float weight = static_cast<float>(sightingCount);
+
+        auto& cell = m_models[modelId][GetCellKey(position)];
+        cell.PositionSum.x += position.x * weight;
+        cell.PositionSum.y += position.y * weight;
+        cell.PositionSum.z += position.z * weight;
+        cell.SightingCount += sightingCount;
+
+        m_sightingCount += sightingCount;
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "Guid.h"
+
+#include <DirectXMath.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // A location where models were seen before, with the number of sightings it accounts for.
+    struct PriorLocation
+    {
+        Guid ModelId;
+        DirectX::XMFLOAT3 Position;
+        uint32_t SightingCount;
+    };
+
+    // Spatial index of the locations where each model was seen, so that a model can be searched where it's
+    // likely to be rather than only where the user looks.
+    //
+    // Sightings are binned in a sparse grid per model. A cell keeps the number and mean position of its
+    // sightings, so memory and query time depend on the space covered rather than on the number of sightings.
+    // Positions are in whatever coordinate system the caller uses consistently, e.g. one of a persisted anchor.
+    class SightingIndex
+    {
+    public:
+        SightingIndex(float cellSize = 0.5f);
+
+        // Loads the index from disk. A missing, truncated or malformed index results in an empty index.
+        bool Load(std::wstring const& indexPath);
+
+        // Writes the index to disk if it changed since it was loaded.
+        void SaveIfChanged(std::wstring const& indexPath);
+
+        // The index as saved to disk, and back. Decoding fails on a truncated or malformed index, leaving it empty.
+        std::vector<uint8_t> Encode() const;
+        bool Decode(uint8_t const* data, size_t size);
+
+        void Add(Guid const& modelId, DirectX::XMFLOAT3 const& position);
+
+        void Clear();
+
+        // Returns up to maxCount locations of the given models, the most sighted first.
+        std::vector<PriorLocation> GetPriorLocations(std::vector<Guid> const& modelIds, size_t maxCount) const;
+
+        size_t Size() const { return m_sightingCount; }
+
+    private:
+        using CellKey = uint64_t;
+
+        struct Cell
+        {
+            DirectX::XMFLOAT3 PositionSum;
+            uint32_t SightingCount;
+        };
+
+        CellKey GetCellKey(DirectX::XMFLOAT3 const& position) const;
+
+        void AddToCell(Guid const& modelId, DirectX::XMFLOAT3 const& position, uint32_t sightingCount);
+
+        float m_cellSize;
+
+        std::unordered_map<Guid, std::unordered_map<CellKey, Cell>> m_models;
+        size_t m_sightingCount{ 0 };
+
+        bool m_changed{ false };
+    };
+}
@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "StartupTrace.h"
+
+#include <fstream>
+
+using namespace std;
+
+namespace
+{
+    string EscapeJson(string const& value)
+    {
+        string escaped;
+        escaped.reserve(value.size());
+
+        for (const char c : value)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+                escaped += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[8];
+                sprintf_s(code, "\\u%04x", c);
+                escaped += code;
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+
+        return escaped;
+    }
+
+    string FormatMilliseconds(int64_t microseconds)
+    {
+        ostringstream oss;
+        oss << fixed << setprecision(1) << microseconds / 1000.0 << " ms";
+        return oss.str();
+    }
+}
+
+namespace AoaSampleApp
+{
+    StartupTrace::Span::Span(Span&& other) noexcept
+        : m_trace(std::exchange(other.m_trace, nullptr))
+        , m_id(std::exchange(other.m_id, c_noSpan))
+    {
+    }
+
+    StartupTrace::Span& StartupTrace::Span::operator=(Span&& other) noexcept
+    {
+        if (this != &other)
+        {
+            End();
+            m_trace = std::exchange(other.m_trace, nullptr);
+            m_id = std::exchange(other.m_id, c_noSpan);
+        }
+
+        return *this;
+    }
+
+    StartupTrace::Span::~Span()
+    {
+        End();
+    }
+
+    void StartupTrace::Span::End()
+    {
+        if (m_trace)
+        {
+            m_trace->EndSpan(m_id);
+            m_trace = nullptr;
+        }
+    }
+
+    StartupTrace::StartupTrace()
+    {
+        LARGE_INTEGER value;
+        ::QueryPerformanceFrequency(&value);
+        m_qpcFrequency = value.QuadPart;
+        ::QueryPerformanceCounter(&value);
+        m_qpcStart = value.QuadPart;
+    }
+
+    StartupTrace::Span StartupTrace::BeginSpan(string name, SpanId parent)
+    {
+        SpanRecord record;
+        record.Name = move(name);
+        record.Parent = parent;
+        record.ThreadId = ::GetCurrentThreadId();
+        record.StartCpuMicroseconds = ProcessCpuMicroseconds();
+        record.StartMicroseconds = NowMicroseconds();
+
+        lock_guard lock(m_mutex);
+        m_spans.emplace_back(move(record));
+
+        return Span(this, static_cast<SpanId>(m_spans.size()));
+    }
+
+    void StartupTrace::EndSpan(SpanId id)
+    {
+        const int64_t endMicroseconds = NowMicroseconds();
+        const int64_t endCpuMicroseconds = ProcessCpuMicroseconds();
+
+        lock_guard lock(m_mutex);
+
+        auto& record = m_spans.at(id - 1);
+        record.EndMicroseconds = endMicroseconds;
+        record.EndCpuMicroseconds = endCpuMicroseconds;
+    }
+
+    void StartupTrace::Mark(string name)
+    {
+        MarkRecord record{ move(name), ::GetCurrentThreadId(), NowMicroseconds() };
+
+        lock_guard lock(m_mutex);
+        m_marks.emplace_back(move(record));
+    }
+
+    void StartupTrace::WriteChromeTrace(wstring const& path) const
+    {
+        lock_guard lock(m_mutex);
+
+        ofstream file(path, ios::out | ios::trunc);
+        if (!file)
+        {
+            return;
+        }
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        for (auto const& span : m_spans)
+        {
+            if (span.EndMicroseconds < 0)
+            {
+                // Still running.
+                continue;
+            }
+
+            file << (first ? "\n" : ",\n");
+            file << "{\"name\":\"" << EscapeJson(span.Name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.ThreadId
+                << ",\"ts\":" << span.StartMicroseconds << ",\"dur\":" << span.EndMicroseconds - span.StartMicroseconds
+                << ",\"args\":{\"cpu_us\":" << span.EndCpuMicroseconds - span.StartCpuMicroseconds << "}}";
+            first = false;
+        }
+
+        for (auto const& mark : m_marks)
+        {
+            file << (first ? "\n" : ",\n");
+            file << "{\"name\":\"" << EscapeJson(mark.Name) << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << mark.ThreadId
+                << ",\"ts\":" << mark.TimeMicroseconds << "}";
+            first = false;
+        }
+
+        file << "\n]}\n";
+    }
+
+    string StartupTrace::Summarize() const
+    {
+        lock_guard lock(m_mutex);
+
+        auto isEnded = [this](SpanId id) { return m_spans[id - 1].EndMicroseconds >= 0; };
+        auto wallTime = [this](SpanId id) { return m_spans[id - 1].EndMicroseconds - m_spans[id - 1].StartMicroseconds; };
+        auto cpuTime = [this](SpanId id) { return m_spans[id - 1].EndCpuMicroseconds - m_spans[id - 1].StartCpuMicroseconds; };
+
+        vector<vector<SpanId>> children(m_spans.size() + 1);
+        for (SpanId id = 1; id <= m_spans.size(); ++id)
+        {
+            if (isEnded(id))
+            {
+                children[m_spans[id - 1].Parent].push_back(id);
+            }
+        }
+
+        ostringstream oss;
+
+        if (children[c_noSpan].empty())
+        {
+            oss << "Startup trace: no completed span.\n";
+            return oss.str();
+        }
+
+        const SpanId root = children[c_noSpan].front();
+        oss << "Startup trace: " << m_spans[root - 1].Name << " took " << FormatMilliseconds(wallTime(root))
+            << " (CPU " << FormatMilliseconds(cpuTime(root)) << ").\n";
+
+        for (auto const& mark : m_marks)
+        {
+            oss << "  " << mark.Name << " at " << FormatMilliseconds(mark.TimeMicroseconds) << ".\n";
+        }
+
+        // A span can't complete before its last child does, so the critical path follows the child that ended last.
+        oss << "Critical path:\n";
+
+        int depth = 0;
+        for (SpanId id = root; id != c_noSpan; ++depth)
+        {
+            oss << string(2 + depth * 2, ' ') << m_spans[id - 1].Name << ": " << FormatMilliseconds(wallTime(id))
+                << " wall, " << FormatMilliseconds(cpuTime(id)) << " CPU";
+
+            auto const& spanChildren = children[id];
+            if (spanChildren.size() > 1)
+            {
+                // Sibling spans run one after another today; if they were independent, the longest one would bound the parent.
+                int64_t totalTime = 0;
+                int64_t longestTime = 0;
+                for (const SpanId child : spanChildren)
+                {
+                    totalTime += wallTime(child);
+                    longestTime = (max)(longestTime, wallTime(child));
+                }
+
+                oss << ", " << spanChildren.size() << " children taking " << FormatMilliseconds(totalTime)
+                    << ", up to " << fixed << setprecision(2) << (longestTime > 0 ? double(totalTime) / longestTime : 1.0)
+                    << "x parallelism available";
+            }
+
+            oss << "\n";
+
+            SpanId next = c_noSpan;
+            for (const SpanId child : spanChildren)
+            {
+                if (next == c_noSpan || m_spans[child - 1].EndMicroseconds > m_spans[next - 1].EndMicroseconds)
+                {
+                    next = child;
+                }
+            }
+
+            id = next;
+        }
+
+        return oss.str();
+    }
+
+    int64_t StartupTrace::NowMicroseconds() const
+    {
+        LARGE_INTEGER now;
+        ::QueryPerformanceCounter(&now);
+
+        return (now.QuadPart - m_qpcStart) * 1'000'000 / m_qpcFrequency;
+    }
+
+    int64_t StartupTrace::ProcessCpuMicroseconds()
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        {
+            return 0;
+        }
+
+        auto toTicks = [](FILETIME const& time)
+        {
+            return (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+
+        // FILETIME is in 100-nanosecond units.
+        return (toTicks(kernelTime) + toTicks(userTime)) / 10;
+    }
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Records nested spans of the application startup with their wall and CPU time, and writes them in the
+    // Chrome trace event format (open with chrome://tracing or https://ui.perfetto.dev).
+    //
+    // Parents are passed explicitly rather than tracked per thread, since coroutines resume on arbitrary threads.
+    // CPU time is the CPU time of the whole process while a span is open.
+    class StartupTrace
+    {
+    public:
+        using SpanId = uint32_t;
+        static constexpr SpanId c_noSpan = 0;
+
+        // Ends the span when destroyed.
+        class Span
+        {
+        public:
+            Span() = default;
+            Span(Span&& other) noexcept;
+            Span& operator=(Span&& other) noexcept;
+            ~Span();
+
+            SpanId Id() const { return m_id; }
+            void End();
+
+        private:
+            friend class StartupTrace;
+            Span(StartupTrace* trace, SpanId id) : m_trace(trace), m_id(id) {}
+
+            StartupTrace* m_trace{ nullptr };
+            SpanId m_id{ c_noSpan };
+        };
+
+        StartupTrace();
+
+        Span BeginSpan(std::string name, SpanId parent = c_noSpan);
+
+        // Records an instant event, such as the first detection.
+        void Mark(std::string name);
+
+        void WriteChromeTrace(std::wstring const& path) const;
+
+        // Describes the critical path of the first top-level span, and how much of the work along it could
+        // overlap if sibling spans were independent.
+        std::string Summarize() const;
+
+    private:
+        struct SpanRecord
+        {
+            std::string Name;
+            SpanId Parent{ c_noSpan };
+            uint32_t ThreadId{ 0 };
+            int64_t StartMicroseconds{ 0 };
+            int64_t EndMicroseconds{ -1 };
+            int64_t StartCpuMicroseconds{ 0 };
+            int64_t EndCpuMicroseconds{ 0 };
+        };
+
+        struct MarkRecord
+        {
+            std::string Name;
+            uint32_t ThreadId{ 0 };
+            int64_t TimeMicroseconds{ 0 };
+        };
+
+        void EndSpan(SpanId id);
+
+        int64_t NowMicroseconds() const;
+        static int64_t ProcessCpuMicroseconds();
+
+        int64_t m_qpcFrequency{ 0 };
+        int64_t m_qpcStart{ 0 };
+
+        mutable std::mutex m_mutex;
+        std::vector<SpanRecord> m_spans;    // Indexed by span id - 1.
+        std::vector<MarkRecord> m_marks;
+    };
+}
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "WarmStartState.h"
+#include "DirectXHelper.h"
+
+#include <winrt/Windows.Data.Json.h>
+
+using namespace std;
+using namespace winrt::Microsoft::Azure::ObjectAnchors;
+using namespace winrt::Windows::Data::Json;
+using namespace winrt::Windows::Foundation::Numerics;
+
+namespace
+{
+    JsonArray ToJson(float3 const& value)
+    {
+        JsonArray json;
+        json.Append(JsonValue::CreateNumberValue(value.x));
+        json.Append(JsonValue::CreateNumberValue(value.y));
+        json.Append(JsonValue::CreateNumberValue(value.z));
+        return json;
+    }
+
+    JsonArray ToJson(quaternion const& value)
+    {
+        JsonArray json;
+        json.Append(JsonValue::CreateNumberValue(value.x));
+        json.Append(JsonValue::CreateNumberValue(value.y));
+        json.Append(JsonValue::CreateNumberValue(value.z));
+        json.Append(JsonValue::CreateNumberValue(value.w));
+        return json;
+    }
+
+    float3 GetNamedFloat3(JsonObject const& json, winrt::hstring const& name)
+    {
+        auto array = json.GetNamedArray(name);
+        return { static_cast<float>(array.GetNumberAt(0)), static_cast<float>(array.GetNumberAt(1)), static_cast<float>(array.GetNumberAt(2)) };
+    }
+
+    quaternion GetNamedQuaternion(JsonObject const& json, winrt::hstring const& name)
+    {
+        auto array = json.GetNamedArray(name);
+        return normalize(quaternion(
+            static_cast<float>(array.GetNumberAt(0)),
+            static_cast<float>(array.GetNumberAt(1)),
+            static_cast<float>(array.GetNumberAt(2)),
+            static_cast<float>(array.GetNumberAt(3))));
+    }
+
+    // Model ids are written without the braces of to_hstring(guid), as in the scene layout.
+    winrt::hstring ToString(winrt::guid const& value)
+    {
+        const winrt::hstring text = winrt::to_hstring(value);
+        return winrt::hstring{ wstring_view(text).substr(1, text.size() - 2) };
+    }
+}
+
+namespace AoaSampleApp
+{
+    optional<WarmStartState> WarmStartState::Load(wstring const& path) try
+    {
+        winrt::file_handle file{ ::CreateFile2(path.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr) };
+        if (!file)
+        {
+            return nullopt;
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!::GetFileSizeEx(file.get(), &fileSize) || fileSize.QuadPart > (numeric_limits<DWORD>::max)())
+        {
+            return nullopt;
+        }
+
+        string text(static_cast<size_t>(fileSize.QuadPart), '\0');
+        DWORD bytesRead = 0;
+        if (!::ReadFile(file.get(), text.data(), static_cast<DWORD>(text.size()), &bytesRead, nullptr) || bytesRead != text.size())
+        {
+            return nullopt;
+        }
+
+        auto json = JsonObject::Parse(winrt::to_hstring(text));
+
+        WarmStartState state;
+        state.TrackingMode = static_cast<ObjectInstanceTrackingMode>(static_cast<int32_t>(json.GetNamedNumber(L"TrackingMode")));
+
+        for (auto const& value : json.GetNamedArray(L"Placements"))
+        {
+            auto placement = value.GetObject();
+            state.Placements.push_back({
+                winrt::guid{ placement.GetNamedString(L"ModelId") },
+                GetNamedFloat3(placement, L"Position"),
+                GetNamedQuaternion(placement, L"Orientation")
+            });
+        }
+
+        if (json.HasKey(L"SearchArea"))
+        {
+            auto searchArea = json.GetNamedObject(L"SearchArea");
+            state.SearchArea = SearchAreaProposal{
+                ToXMFloat3(GetNamedFloat3(searchArea, L"Center")),
+                ToXMFloat4(GetNamedQuaternion(searchArea, L"Orientation")),
+                ToXMFloat3(GetNamedFloat3(searchArea, L"Extents"))
+            };
+        }
+
+        return state;
+    }
+    catch (...) { return nullopt; }
+
+    void WarmStartState::Save(wstring const& path) const
+    {
+        JsonObject json;
+        json.SetNamedValue(L"TrackingMode", JsonValue::CreateNumberValue(static_cast<int32_t>(TrackingMode)));
+
+        JsonArray placements;
+        for (auto const& placement : Placements)
+        {
+            JsonObject placementJson;
+            placementJson.SetNamedValue(L"ModelId", JsonValue::CreateStringValue(ToString(placement.ModelId)));
+            placementJson.SetNamedValue(L"Position", ToJson(placement.Position));
+            placementJson.SetNamedValue(L"Orientation", ToJson(placement.Orientation));
+            placements.Append(placementJson);
+        }
+        json.SetNamedValue(L"Placements", placements);
+
+        if (SearchArea)
+        {
+            JsonObject searchArea;
+            searchArea.SetNamedValue(L"Center", ToJson(ToFloat3(SearchArea->Center)));
+            searchArea.SetNamedValue(L"Orientation", ToJson(ToQuaternion(SearchArea->Orientation)));
+            searchArea.SetNamedValue(L"Extents", ToJson(ToFloat3(SearchArea->Extents)));
+            json.SetNamedValue(L"SearchArea", searchArea);
+        }
+
+        const string text = winrt::to_string(json.Stringify());
+
+        // Write to a temporary file first so that a crash never leaves a partially written state behind.
+        const wstring temporaryPath = path + L".tmp";
+        {
+            winrt::file_handle file{ ::CreateFile2(temporaryPath.c_str(), GENERIC_WRITE, 0, CREATE_ALWAYS, nullptr) };
+            if (!file)
+            {
+                return;
+            }
+
+            DWORD written = 0;
+            if (!::WriteFile(file.get(), text.data(), static_cast<DWORD>(text.size()), &written, nullptr) || written != text.size())
+            {
+                return;
+            }
+        }
+
+        ::MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+    }
+}
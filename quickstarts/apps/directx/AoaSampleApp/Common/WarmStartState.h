@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "SearchAreaPlanner.h"
+
+#include <winrt/Microsoft.Azure.ObjectAnchors.h>
+#include <winrt/Windows.Foundation.h>
+#include <winrt/Windows.Foundation.Numerics.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // Pose of a model's origin when it was last tracked.
+    struct WarmStartPlacement
+    {
+        winrt::guid ModelId;
+        winrt::Windows::Foundation::Numerics::float3 Position;
+        winrt::Windows::Foundation::Numerics::quaternion Orientation;
+    };
+
+    // Tracker state saved on suspend, so that the next session can search where the models were rather than
+    // wait for the user to place a search area. Poses are relative to an anchor persisted with the state.
+    struct WarmStartState
+    {
+        winrt::Microsoft::Azure::ObjectAnchors::ObjectInstanceTrackingMode TrackingMode{ winrt::Microsoft::Azure::ObjectAnchors::ObjectInstanceTrackingMode::LowLatencyCoarsePosition };
+        std::vector<WarmStartPlacement> Placements;
+        std::optional<SearchAreaProposal> SearchArea;
+
+        // Loads the state from disk. A missing or malformed file results in nothing.
+        static std::optional<WarmStartState> Load(std::wstring const& path);
+
+        void Save(std::wstring const& path) const;
+    };
+}
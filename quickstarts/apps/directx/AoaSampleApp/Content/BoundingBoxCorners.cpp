@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "BoundingBoxCorners.h"
+
+#include "PrimitiveTables.h"
+
+using namespace DirectX;
+using namespace std;
+
+// Get the corners of a batch of boxes, four boxes at a time.
+void AoaSampleApp::GetBoundingBoxCorners(OrientedBoxBatch const& boxes, XMFLOAT3* corners)
+{
+    constexpr size_t c_width = 4;
+    constexpr size_t c_cornerCount = PrimitiveTables::c_boxVertices.size();
+
+    const auto load = [](vector<float> const& values, size_t index)
+    {
+        return XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values.data() + index));
+    };
+
+    for (size_t i = 0; i < boxes.Size(); i += c_width)
+    {
+        const XMVECTOR centerX = load(boxes.CenterX, i);
+        const XMVECTOR centerY = load(boxes.CenterY, i);
+        const XMVECTOR centerZ = load(boxes.CenterZ, i);
+
+        // Axes scaled to the half widths of the boxes.
+        const XMVECTOR halfExtentX = load(boxes.HalfExtentX, i);
+        const XMVECTOR halfExtentY = load(boxes.HalfExtentY, i);
+        const XMVECTOR halfExtentZ = load(boxes.HalfExtentZ, i);
+
+        const XMVECTOR axisXX = XMVectorMultiply(load(boxes.AxisXX, i), halfExtentX);
+        const XMVECTOR axisXY = XMVectorMultiply(load(boxes.AxisXY, i), halfExtentX);
+        const XMVECTOR axisXZ = XMVectorMultiply(load(boxes.AxisXZ, i), halfExtentX);
+        const XMVECTOR axisYX = XMVectorMultiply(load(boxes.AxisYX, i), halfExtentY);
+        const XMVECTOR axisYY = XMVectorMultiply(load(boxes.AxisYY, i), halfExtentY);
+        const XMVECTOR axisYZ = XMVectorMultiply(load(boxes.AxisYZ, i), halfExtentY);
+        const XMVECTOR axisZX = XMVectorMultiply(load(boxes.AxisZX, i), halfExtentZ);
+        const XMVECTOR axisZY = XMVectorMultiply(load(boxes.AxisZY, i), halfExtentZ);
+        const XMVECTOR axisZZ = XMVectorMultiply(load(boxes.AxisZZ, i), halfExtentZ);
+
+        const size_t laneCount = (min)(c_width, boxes.Size() - i);
+
+        for (size_t corner = 0; corner < c_cornerCount; ++corner)
+        {
+            // Unit box corners are at +/-0.5 along each axis.
+            const XMVECTOR signX = XMVectorReplicate(PrimitiveTables::c_boxVertices[corner].x * 2.0f);
+            const XMVECTOR signY = XMVectorReplicate(PrimitiveTables::c_boxVertices[corner].y * 2.0f);
+            const XMVECTOR signZ = XMVectorReplicate(PrimitiveTables::c_boxVertices[corner].z * 2.0f);
+
+            XMFLOAT4 x, y, z;
+            XMStoreFloat4(&x, XMVectorMultiplyAdd(signZ, axisZX, XMVectorMultiplyAdd(signY, axisYX, XMVectorMultiplyAdd(signX, axisXX, centerX))));
+            XMStoreFloat4(&y, XMVectorMultiplyAdd(signZ, axisZY, XMVectorMultiplyAdd(signY, axisYY, XMVectorMultiplyAdd(signX, axisXY, centerY))));
+            XMStoreFloat4(&z, XMVectorMultiplyAdd(signZ, axisZZ, XMVectorMultiplyAdd(signY, axisYZ, XMVectorMultiplyAdd(signX, axisXZ, centerZ))));
+
+            const float lanesX[c_width] = { x.x, x.y, x.z, x.w };
+            const float lanesY[c_width] = { y.x, y.y, y.z, y.w };
+            const float lanesZ[c_width] = { z.x, z.y, z.z, z.w };
+
+            for (size_t lane = 0; lane < laneCount; ++lane)
+            {
+                corners[(i + lane) * c_cornerCount + corner] = { lanesX[lane], lanesY[lane], lanesZ[lane] };
+            }
+        }
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include "../Common/BoundingVolumeBatch.h"
+
+namespace AoaSampleApp
+{
+    // Get the 8 corners of each box, in the order of PrimitiveTables::c_boxVertices, so that the i-th box is
+    // outlined by PrimitiveTables::c_boxIndices offset by 8 * i. Corners must hold 8 * boxes.Size() elements.
+    void GetBoundingBoxCorners(OrientedBoxBatch const& boxes, DirectX::XMFLOAT3* corners);
+}
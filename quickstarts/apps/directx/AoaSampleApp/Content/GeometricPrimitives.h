@@ -5,9 +5,15 @@
 #include <DirectXCollision.h>
 #include <DirectXColors.h>
 #include <DirectXMath.h>
+#include <array>
 #include <vector>
 
 #include <winrt/Microsoft.Azure.ObjectAnchors.h>
+#include <winrt/Microsoft.Azure.ObjectAnchors.SpatialGraph.h>
+#include <winrt/Windows.Foundation.Numerics.h>
+
+#include "BoundingBoxCorners.h"
+#include "PrimitiveTables.h"
 
 namespace AoaSampleApp
 {
@@ -34,12 +40,41 @@ namespace AoaSampleApp
     static const DirectX::XMFLOAT4 c_SemiTransparentGray{ 0.5f, 0.5f, 0.5f, 0.5f };
     static const DirectX::XMFLOAT4 c_SemiTransparentCyan{ 0.0f, 0.5f, 0.5f, 0.5f };
 
-    // Get vertices and triangle indices of a sphere.
-    void GetSphereVerticesAndIndices(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialSphere const& sphere, unsigned short tessellation, bool shouldDrawVerticalSegments, std::vector<DirectX::XMFLOAT3>& vertices, std::vector<uint32_t>& indices);
+    // Vertices and line list indices of a wireframe, in static storage.
+    struct LineMesh
+    {
+        DirectX::XMFLOAT3 const* Vertices{ nullptr };
+        uint32_t VertexCount{ 0 };
+        uint32_t const* Indices{ nullptr };
+        uint32_t IndexCount{ 0 };
+    };
 
-    // Get vertices and triangle indices of a bounding box.
-    void GetBoundingBoxVerticesAndIndices(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialOrientedBox const& box, std::vector<DirectX::XMFLOAT3>& vertices, std::vector<uint32_t>& indices);
+    template <size_t VertexCount, size_t IndexCount>
+    constexpr LineMesh MakeLineMesh(std::array<DirectX::XMFLOAT3, VertexCount> const& vertices, std::array<uint32_t, IndexCount> const& indices)
+    {
+        return { vertices.data(), static_cast<uint32_t>(VertexCount), indices.data(), static_cast<uint32_t>(IndexCount) };
+    }
+
+    // Unit wireframes, generated at compile time, so that a volume is drawn by setting the transform returned
+    // for it below rather than by building and uploading geometry. See PrimitiveTables for their layout.
+    template <uint32_t Tessellation>
+    LineMesh GetUnitSphereLineMesh()
+    {
+        using Layout = PrimitiveTables::SphereLayout<Tessellation>;
 
-    // Get vertices and triangle indices of a field of view.
-    void GetFieldOfViewVerticesAndIndices(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialFieldOfView const& fieldOfView, std::vector<DirectX::XMFLOAT3>& vertices, std::vector<uint32_t>& indices);
-}
+        static_assert(PrimitiveTables::Detail::AreIndicesBelow(PrimitiveTables::c_sphereIndices<Tessellation>, Layout::VertexCount));
+        static_assert(PrimitiveTables::Detail::AreLinesProper(PrimitiveTables::c_sphereIndices<Tessellation>));
+
+        return MakeLineMesh(PrimitiveTables::c_sphereVertices<Tessellation>, PrimitiveTables::c_sphereIndices<Tessellation>);
+    }
+
+    LineMesh GetUnitBoxLineMesh();
+    LineMesh GetUnitFieldOfViewLineMesh();
+
+    winrt::Windows::Foundation::Numerics::float4x4 GetUnitSphereTransform(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialSphere const& sphere);
+    winrt::Windows::Foundation::Numerics::float4x4 GetUnitBoxTransform(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialOrientedBox const& box);
+    winrt::Windows::Foundation::Numerics::float4x4 GetUnitFieldOfViewTransform(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialFieldOfView const& fieldOfView);
+
+    // Get vertices and line list indices of a bounding box.
+    void GetBoundingBoxVerticesAndIndices(winrt::Microsoft::Azure::ObjectAnchors::SpatialGraph::SpatialOrientedBox const& box, std::vector<DirectX::XMFLOAT3>& vertices, std::vector<uint32_t>& indices);
+}
\ No newline at end of file
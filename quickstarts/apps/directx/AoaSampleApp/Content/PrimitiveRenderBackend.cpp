@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "PrimitiveRenderBackend.h"
+
+namespace AoaSampleApp
+{
+    void DrawPrimitive(IPrimitiveRenderBackend& backend, PrimitiveDraw const& draw)
+    {
+        // Point clouds aren't split in meshlets, and are drawn with all of their offsets in one draw.
+        const bool drawsVisibleIndices = !draw.IsPointList && draw.VisibleIndices != nullptr;
+        const uint32_t instanceCount = draw.IsPointList ? 2 * draw.PointOffsetCount : 2;
+
+        const auto hasIndices = [](MeshLevelOfDetail const& range) { return range.IndexCount > 0; };
+        const bool hasDraws = drawsVisibleIndices
+            ? std::any_of(draw.VisibleIndices->cbegin(), draw.VisibleIndices->cend(), hasIndices)
+            : hasIndices(draw.DrawnIndices);
+
+        if (!hasDraws || instanceCount == 0)
+        {
+            return;
+        }
+
+        backend.BindPipeline(draw.IsPointList, draw.IsPointList ? 0 : draw.PointOffsetCount - 1);
+        backend.UpdateModelConstantBuffer(*draw.ModelConstants);
+
+        if (!drawsVisibleIndices)
+        {
+            backend.DrawIndexedInstanced(draw.DrawnIndices.IndexCount, instanceCount, draw.DrawnIndices.StartIndex);
+            return;
+        }
+
+        for (auto const& range : *draw.VisibleIndices)
+        {
+            if (hasIndices(range))
+            {
+                backend.DrawIndexedInstanced(range.IndexCount, instanceCount, range.StartIndex);
+            }
+        }
+    }
+}
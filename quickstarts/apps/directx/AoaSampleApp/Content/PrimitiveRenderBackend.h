@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "../Common/MeshSimplifier.h"
+#include "ShaderStructures.h"
+
+#include <vector>
+
+namespace AoaSampleApp
+{
+    // The device context calls PrimitiveRenderer makes to draw, so that what it draws can be checked without a device.
+    class IPrimitiveRenderBackend
+    {
+    public:
+        virtual ~IPrimitiveRenderBackend() = default;
+
+        // Binds the renderer's shaders, states, input layout, vertex and index buffers, with the per-instance
+        // point offsets starting at the given one.
+        virtual void BindPipeline(bool isPointList, uint32_t firstPointOffset) = 0;
+
+        virtual void UpdateModelConstantBuffer(ModelConstantBuffer const& data) = 0;
+
+        // Draws the indices with instanceCount instances, two per point offset, one for each eye.
+        virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex) = 0;
+    };
+
+    // What a primitive renderer draws in one frame.
+    struct PrimitiveDraw
+    {
+        bool IsPointList;
+
+        // Point clouds are drawn once per offset, each offset an instance pair for the two eyes. Other primitives
+        // are drawn without offset, from the last one, which is zero. There is at least one.
+        uint32_t PointOffsetCount;
+
+        // Indices of the selected level of detail, and, if the geometry has meshlets, the ranges of them found
+        // visible, which are drawn instead. Null without meshlets.
+        MeshLevelOfDetail DrawnIndices;
+        std::vector<MeshLevelOfDetail> const* VisibleIndices;
+
+        ModelConstantBuffer const* ModelConstants;
+    };
+
+    // Binds the pipeline and updates the model constant buffer once, then issues one draw per range of indices.
+    // Nothing is bound or updated when there is nothing to draw.
+    void DrawPrimitive(
+        IPrimitiveRenderBackend& backend,
+        PrimitiveDraw const& draw);
+}
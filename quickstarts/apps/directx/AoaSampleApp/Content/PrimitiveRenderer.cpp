@@ -2,17 +2,40 @@
 // Licensed under the MIT license.
 #include "pch.h"
 #include "PrimitiveRenderer.h"
+#include "PrimitiveRenderBackend.h"
 #include "Common/DirectXHelper.h"
+#include "Common/FileReader.h"
+#include "Common/PositionQuantizer.h"
 
 using namespace AoaSampleApp;
 using namespace DirectX;
 using namespace winrt::Windows::Foundation::Numerics;
 using namespace winrt::Windows::UI::Input::Spatial;
 
+namespace
+{
+    // Model meshes are drawn as wireframes without culling, so their back faces are visible.
+    constexpr bool c_cullBackFacingMeshlets = false;
+
+    // Point clouds are drawn with small shifts to "scale" the point size, the last one being none.
+    constexpr float c_pointOffset = 0.001f;
+    constexpr std::array<XMFLOAT3, 5> c_pointOffsets =
+    { {
+        { -c_pointOffset, -c_pointOffset, -c_pointOffset },
+        {  c_pointOffset,  c_pointOffset, -c_pointOffset },
+        {  c_pointOffset, -c_pointOffset,  c_pointOffset },
+        { -c_pointOffset,  c_pointOffset,  c_pointOffset },
+        {  0.0f,           0.0f,           0.0f          },
+    } };
+}
+
 // Loads vertex and pixel shaders from files and instantiates the cube geometry.
-PrimitiveRenderer::PrimitiveRenderer(std::shared_ptr<DeviceResources> const& deviceResources) 
+PrimitiveRenderer::PrimitiveRenderer(std::shared_ptr<DeviceResources> const& deviceResources, PositionFormat positionFormat)
     : m_deviceResources(deviceResources)
+    , m_positionFormat(positionFormat)
 {
+    XMStoreFloat4x4(&m_positionToPrimitive, XMMatrixIdentity());
+
     CreateDeviceDependentResources();
 }
 
@@ -23,15 +46,25 @@ void PrimitiveRenderer::SetVerticesAndIndices(
     uint32_t indexCount,
     D3D11_PRIMITIVE_TOPOLOGY topology)
 {
+    m_lineMesh = {};
+
+    // Any index of up to 65536 vertices fits in 16 bits.
+    m_indexFormat = vertexCount <= 0x10000 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    const UINT indexBufferSize = indexCount * GetIndexSize();
+
     // If we need more memory to store the updated geometry, recreate the buffers
     // Otherwise we just reuse and update the previous buffers.
-    if (vertexCount > m_volumeVertices.size() || indexCount > m_volumeIndices.size())
+    if (vertexCount > m_vertexCapacity || indexBufferSize > m_indexBufferCapacity)
     {
-        RecreateVertexAndIndexBuffers(vertexCount, indexCount);
+        RecreateVertexAndIndexBuffers(vertexCount, indexBufferSize);
     }
 
     m_vertexCount = vertexCount;
     m_indexCount = indexCount;
+    m_levelsOfDetail.clear();
+    m_drawnIndices = { 0, indexCount };
+    m_meshlets.clear();
+    m_visibleIndices.clear();
 
     // If there is no geometry, we're done.
     if (m_vertexCount == 0 || m_indexCount == 0)
@@ -40,26 +73,127 @@ void PrimitiveRenderer::SetVerticesAndIndices(
         return;
     }
 
-    // copy the callers vertices into our local storage. This isn't strictly necessary with just a list of positions
-    // but if we add other parameters to the vertex, it will be again.
-    for (uint32_t i = 0; i < m_vertexCount; i++)
-    {
-        m_volumeVertices[i] = (VertexPosition{ vertices[i] });
-    }
-
     // Update our buffers with the updated geometry
     D3D11_MAPPED_SUBRESOURCE resource;
     m_deviceResources->GetD3DDeviceContext()->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
-    memcpy(resource.pData, m_volumeVertices.data(), sizeof(VertexPosition) * m_vertexCount);
+
+    if (m_positionFormat == PositionFormat::UNorm16)
+    {
+        // Positions are normalized to the bounding box of the vertices, which the model transform maps back.
+        const PositionQuantizer quantizer(vertices, m_vertexCount);
+
+        auto* quantized = static_cast<VertexPositionUNorm16*>(resource.pData);
+        XMVECTOR maxErrorSquared = XMVectorZero();
+
+        for (uint32_t i = 0; i < m_vertexCount; i++)
+        {
+            const XMVECTOR position = XMLoadFloat3(&vertices[i]);
+            quantized[i].pos = quantizer.Quantize(position);
+
+            maxErrorSquared = XMVectorMax(maxErrorSquared, XMVector3LengthSq(XMVectorSubtract(quantizer.Dequantize(quantized[i].pos), position)));
+        }
+
+        XMStoreFloat4x4(&m_positionToPrimitive, quantizer.GetPositionToPrimitive());
+        m_maxPositionError = XMVectorGetX(XMVectorSqrt(maxErrorSquared));
+    }
+    else
+    {
+        auto* positions = static_cast<VertexPosition*>(resource.pData);
+        for (uint32_t i = 0; i < m_vertexCount; i++)
+        {
+            positions[i] = VertexPosition{ vertices[i] };
+        }
+
+        XMStoreFloat4x4(&m_positionToPrimitive, XMMatrixIdentity());
+        m_maxPositionError = 0.0f;
+    }
+
     m_deviceResources->GetD3DDeviceContext()->Unmap(m_vertexBuffer.Get(), 0);
 
     m_deviceResources->GetD3DDeviceContext()->Map(m_indexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &resource);
-    memcpy(resource.pData, indices, sizeof(uint32_t) * indexCount);
+
+    if (m_indexFormat == DXGI_FORMAT_R16_UINT)
+    {
+        std::transform(indices, indices + indexCount, static_cast<uint16_t*>(resource.pData), [](uint32_t index) { return static_cast<uint16_t>(index); });
+    }
+    else
+    {
+        memcpy(resource.pData, indices, sizeof(uint32_t) * indexCount);
+    }
+
     m_deviceResources->GetD3DDeviceContext()->Unmap(m_indexBuffer.Get(), 0);
 
     m_primitiveTopology = topology;
 }
 
+void PrimitiveRenderer::SetLineMesh(LineMesh const& mesh)
+{
+    if (mesh.Vertices == m_lineMesh.Vertices && mesh.Indices == m_lineMesh.Indices)
+    {
+        return;
+    }
+
+    SetVerticesAndIndices(mesh.Vertices, mesh.VertexCount, mesh.Indices, mesh.IndexCount, D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+
+    m_lineMesh = mesh;
+}
+
+void PrimitiveRenderer::SetLevelsOfDetail(std::vector<MeshLevelOfDetail> levels)
+{
+    m_levelsOfDetail = std::move(levels);
+    SelectLevelOfDetail(0);
+}
+
+void PrimitiveRenderer::SelectLevelOfDetail(size_t level)
+{
+    if (level >= m_levelsOfDetail.size())
+    {
+        return;
+    }
+
+    auto const& selected = m_levelsOfDetail[level];
+    if (selected.StartIndex + selected.IndexCount <= m_indexCount)
+    {
+        m_drawnIndices = selected;
+    }
+}
+
+void PrimitiveRenderer::SetMeshlets(std::vector<Meshlet> meshlets)
+{
+    m_meshlets = std::move(meshlets);
+    m_visibleIndices.clear();
+}
+
+void PrimitiveRenderer::CullMeshlets(ViewProjectionConstantBuffer const& viewProjection)
+{
+    if (m_meshlets.empty() || !m_isActive)
+    {
+        return;
+    }
+
+    // Meshlets of the drawn level of detail.
+    const auto byStartIndex = [](Meshlet const& meshlet, uint32_t index) { return meshlet.StartIndex < index; };
+    const auto first = std::lower_bound(m_meshlets.cbegin(), m_meshlets.cend(), m_drawnIndices.StartIndex, byStartIndex);
+    const auto last = std::lower_bound(first, m_meshlets.cend(), m_drawnIndices.StartIndex + m_drawnIndices.IndexCount, byStartIndex);
+
+    // The constant buffer holds transposed matrices for the shaders.
+    const XMMATRIX primitiveToFrameOfReference = XMLoadFloat4x4(&m_primitiveToFrameOfReference);
+
+    std::array<XMFLOAT4X4, 2> objectToClip;
+    for (size_t i = 0; i < objectToClip.size(); ++i)
+    {
+        XMStoreFloat4x4(&objectToClip[i], primitiveToFrameOfReference * XMMatrixTranspose(XMLoadFloat4x4(&viewProjection.viewProjection[i])));
+    }
+
+    AoaSampleApp::CullMeshlets(
+        m_meshlets.data() + (first - m_meshlets.cbegin()),
+        last - first,
+        objectToClip.data(),
+        objectToClip.size(),
+        c_cullBackFacingMeshlets,
+        m_visibleIndices);
+}
+
 void AoaSampleApp::PrimitiveRenderer::SetColor(DirectX::XMFLOAT4 const& color)
 {
     m_modelColor = color;
@@ -77,154 +211,137 @@ float3 PrimitiveRenderer::GetPosition() const
     return transform(float3::zero(), m_primitiveToFrameOfReference);
 }
 
-// Renders one frame using the vertex and pixel shaders.
-// On devices that do not support the D3D11_FEATURE_D3D11_OPTIONS3::
-// VPAndRTArrayIndexFromAnyShaderFeedingRasterizer optional feature,
-// a pass-through geometry shader is also used to set the render 
-// target array index.
-void PrimitiveRenderer::Render()
+// Draws with the renderer's Direct3D resources on the immediate context.
+class PrimitiveRenderer::Direct3DRenderBackend : public IPrimitiveRenderBackend
 {
-    // Loading is asynchronous. Resources must be created before drawing can occur.
-    if (!m_loadingComplete || !m_isActive)
+public:
+    explicit Direct3DRenderBackend(PrimitiveRenderer const& renderer)
+        : m_renderer(renderer)
+        , m_context(renderer.m_deviceResources->GetD3DDeviceContext())
     {
-        return;
     }
 
-    const auto context = m_deviceResources->GetD3DDeviceContext();
-
-    // Each vertex is one instance of the VertexPositionColor struct.
-    const UINT stride = sizeof(VertexPosition);
-    const UINT offset = 0;
-
-    // Attach the vertex shader.
-    context->VSSetShader(
-        m_vertexShader.Get(),
-        nullptr,
-        0
-    );
-
-    // Apply the model constant buffer to the vertex shader.
-    context->VSSetConstantBuffers(
-        0,
-        1,
-        m_modelConstantBuffer.GetAddressOf()
-    );
-
-    if (!m_usingVprtShaders)
+    void BindPipeline(bool isPointList, uint32_t firstPointOffset) override
     {
-        // On devices that do not support the D3D11_FEATURE_D3D11_OPTIONS3::
-        // VPAndRTArrayIndexFromAnyShaderFeedingRasterizer optional feature,
-        // a pass-through geometry shader is used to set the render target 
-        // array index.
-        context->GSSetShader(
-            m_geometryShader.Get(),
+        // Attach the vertex shader.
+        m_context->VSSetShader(
+            m_renderer.m_vertexShader.Get(),
             nullptr,
             0
         );
-    }
 
-    // Attach the pixel shader.
-    context->PSSetShader(
-        m_pixelShader.Get(),
-        nullptr,
-        0
-    );
-
-    // Draw bounding box.
-    if(m_vertexBuffer)
-    {
-        // Set vertex and index buffer to render bounding box.
-        context->IASetVertexBuffers(
+        // Apply the model constant buffer to the vertex shader.
+        m_context->VSSetConstantBuffers(
             0,
             1,
-            m_vertexBuffer.GetAddressOf(),
-            &stride,
-            &offset
+            m_renderer.m_modelConstantBuffer.GetAddressOf()
         );
-       
-        context->IASetPrimitiveTopology(m_primitiveTopology);
-        context->IASetInputLayout(m_inputLayout.Get());
 
-        if (m_primitiveTopology == D3D11_PRIMITIVE_TOPOLOGY_POINTLIST)
+        if (!m_renderer.m_usingVprtShaders)
         {
-            // Render point cloud 5 passes with a small shift to "scale" the point size.
-            constexpr float c_offset = 0.001f;
-            constexpr std::array<XMFLOAT3, 5> c_directions =
-            { {
-                { -1.0f, -1.0f, -1.0f },
-                {  1.0f,  1.0f, -1.0f },
-                {  1.0f, -1.0f,  1.0f },
-                { -1.0f,  1.0f,  1.0f },
-                {  0.0f,  0.0f,  0.0f },
-            } };
-
-            for (auto const& dir : c_directions)
-            {
-                XMMATRIX pointCloundToReference =
-                    XMMatrixTranslationFromVector(XMLoadFloat3(&dir) * c_offset) *
-                    XMLoadFloat4x4(&m_primitiveToFrameOfReference);
-
-                // The view and projection matrices are provided by the system; they are associated
-                // with holographic cameras, and updated on a per-camera basis.
-                // Here, we provide the model transform for the sample hologram. The model transform
-                // matrix is transposed to prepare it for the shader.
-                XMStoreFloat4x4(&m_modelConstantBufferData.model, XMMatrixTranspose(pointCloundToReference));
-
-                // Update the model transform buffer for the hologram.
-                context->UpdateSubresource(
-                    m_modelConstantBuffer.Get(),
-                    0,
-                    nullptr,
-                    &m_modelConstantBufferData,
-                    0,
-                    0
-                );
-
-                // Draw the objects.
-                context->DrawInstanced(
-                    m_vertexCount,      // Point count
-                    2,                  // Instance count.
-                    0,                  // Start index location.
-                    0                   // Start instance location.
-                );
-            }
-        }
-        else
-        {
-            // The view and projection matrices are provided by the system; they are associated
-            // with holographic cameras, and updated on a per-camera basis.
-            // Here, we provide the model transform for the sample hologram. The model transform
-            // matrix is transposed to prepare it for the shader.
-            XMStoreFloat4x4(&m_modelConstantBufferData.model, XMMatrixTranspose(XMLoadFloat4x4(&m_primitiveToFrameOfReference)));
-
-            // Update the model transform buffer for the hologram.
-            context->UpdateSubresource(
-                m_modelConstantBuffer.Get(),
-                0,
+            // On devices that do not support the D3D11_FEATURE_D3D11_OPTIONS3::
+            // VPAndRTArrayIndexFromAnyShaderFeedingRasterizer optional feature,
+            // a pass-through geometry shader is used to set the render target 
+            // array index.
+            m_context->GSSetShader(
+                m_renderer.m_geometryShader.Get(),
                 nullptr,
-                &m_modelConstantBufferData,
-                0,
                 0
             );
+        }
 
-            context->IASetIndexBuffer(
-                m_indexBuffer.Get(),
-                DXGI_FORMAT_R32_UINT, // Each index is one 32-bit unsigned integer.
-                0
-            );
+        // Attach the pixel shader.
+        m_context->PSSetShader(
+            m_renderer.m_pixelShader.Get(),
+            nullptr,
+            0
+        );
 
-            context->RSSetState(m_rasterizerState.Get());
+        // Each vertex is one instance of the vertex struct of the position format.
+        const std::array<ID3D11Buffer*, 2> vertexBuffers = { m_renderer.m_vertexBuffer.Get(), m_renderer.m_instanceOffsetBuffer.Get() };
+        const std::array<UINT, 2> strides = { m_renderer.GetVertexStride(), sizeof(XMFLOAT3) };
+        const std::array<UINT, 2> offsets = { 0, static_cast<UINT>(sizeof(XMFLOAT3) * firstPointOffset) };
 
-            // Draw the objects.
-            context->DrawIndexedInstanced(
-                m_indexCount,           // Index count per instance.
-                2,                      // Instance count.
-                0,                      // Start index location.
-                0,                      // Base vertex location.
-                0                       // Start instance location.
-            );
+        m_context->IASetVertexBuffers(
+            0,
+            static_cast<UINT>(vertexBuffers.size()),
+            vertexBuffers.data(),
+            strides.data(),
+            offsets.data()
+        );
+
+        m_context->IASetPrimitiveTopology(m_renderer.m_primitiveTopology);
+        m_context->IASetInputLayout(m_renderer.m_inputLayout.Get());
+
+        m_context->IASetIndexBuffer(
+            m_renderer.m_indexBuffer.Get(),
+            m_renderer.m_indexFormat, // Each index is one 16-bit or 32-bit unsigned integer.
+            0
+        );
+
+        if (!isPointList)
+        {
+            m_context->RSSetState(m_renderer.m_rasterizerState.Get());
         }
     }
+
+    void UpdateModelConstantBuffer(ModelConstantBuffer const& data) override
+    {
+        m_context->UpdateSubresource(
+            m_renderer.m_modelConstantBuffer.Get(),
+            0,
+            nullptr,
+            &data,
+            0,
+            0
+        );
+    }
+
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex) override
+    {
+        m_context->DrawIndexedInstanced(
+            indexCount,     // Index count per instance.
+            instanceCount,  // Instance count.
+            startIndex,     // Start index location.
+            0,              // Base vertex location.
+            0               // Start instance location.
+        );
+    }
+
+private:
+    PrimitiveRenderer const& m_renderer;
+    ID3D11DeviceContext* m_context;
+};
+
+// Renders one frame using the vertex and pixel shaders.
+// On devices that do not support the D3D11_FEATURE_D3D11_OPTIONS3::
+// VPAndRTArrayIndexFromAnyShaderFeedingRasterizer optional feature,
+// a pass-through geometry shader is also used to set the render 
+// target array index.
+void PrimitiveRenderer::Render()
+{
+    // Loading is asynchronous. Resources must be created before drawing can occur.
+    if (!m_loadingComplete || !m_isActive || !m_vertexBuffer)
+    {
+        return;
+    }
+
+    // The view and projection matrices are provided by the system; they are associated
+    // with holographic cameras, and updated on a per-camera basis.
+    // Here, we provide the model transform for the sample hologram. The model transform
+    // matrix is transposed to prepare it for the shader.
+    const XMMATRIX positionToFrameOfReference = XMLoadFloat4x4(&m_positionToPrimitive) * XMLoadFloat4x4(&m_primitiveToFrameOfReference);
+    XMStoreFloat4x4(&m_modelConstantBufferData.model, XMMatrixTranspose(positionToFrameOfReference));
+
+    PrimitiveDraw draw{};
+    draw.IsPointList = m_primitiveTopology == D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
+    draw.PointOffsetCount = static_cast<uint32_t>(c_pointOffsets.size());
+    draw.DrawnIndices = m_drawnIndices;
+    draw.VisibleIndices = m_meshlets.empty() ? nullptr : &m_visibleIndices;
+    draw.ModelConstants = &m_modelConstantBufferData;
+
+    Direct3DRenderBackend backend(*this);
+    DrawPrimitive(backend, draw);
 }
 
 void PrimitiveRenderer::SetActive(bool isActive)
@@ -241,12 +358,30 @@ std::future<void> PrimitiveRenderer::CreateDeviceDependentResources()
     // we can avoid using a pass-through geometry shader to set the render
     // target array index, thus avoiding any overhead that would be 
     // incurred by setting the geometry shader stage.
-    std::wstring vertexShaderFileName = m_usingVprtShaders ? L"ms-appx:///VprtVertexShader.cso" : L"ms-appx:///VertexShader.cso";
+    std::wstring vertexShaderFileName = m_usingVprtShaders ? L"VprtVertexShader.cso" : L"VertexShader.cso";
+
+    // Shaders will be loaded asynchronously, all files in one batch.
+    std::vector<uint8_t> vertexShaderFileData;
+    std::vector<uint8_t> pixelShaderFileData;
+    std::vector<uint8_t> geometryShaderFileData;
 
-    // Shaders will be loaded asynchronously.
+    std::array<FileReadRequest, 3> shaderFileRequests =
+    { {
+        { GetPackageFilePath(vertexShaderFileName), nullptr, &vertexShaderFileData },
+        { GetPackageFilePath(L"PixelShader.cso"), nullptr, &pixelShaderFileData },
+        { GetPackageFilePath(L"GeometryShader.cso"), nullptr, &geometryShaderFileData },
+    } };
+
+    // The pass-through geometry shader is only needed without VPRT support.
+    const size_t shaderFileCount = m_usingVprtShaders ? 2 : 3;
+    co_await GetFileReader().ReadAsync(winrt::array_view<FileReadRequest>(shaderFileRequests.data(), static_cast<uint32_t>(shaderFileCount)));
+
+    for (size_t i = 0; i < shaderFileCount; ++i)
+    {
+        winrt::check_hresult(shaderFileRequests[i].Result);
+    }
 
     // After the vertex shader file is loaded, create the shader and input layout.
-    std::vector<byte> vertexShaderFileData = co_await ReadDataAsync(vertexShaderFileName);
     winrt::check_hresult(
         m_deviceResources->GetD3DDevice()->CreateVertexShader(
             vertexShaderFileData.data(),
@@ -255,9 +390,14 @@ std::future<void> PrimitiveRenderer::CreateDeviceDependentResources()
             &m_vertexShader
         ));
 
-    constexpr std::array<D3D11_INPUT_ELEMENT_DESC, 1> vertexDesc =
+    // Normalized positions reach the shader as floats in [0, 1], so both formats share the shaders.
+    const DXGI_FORMAT positionFormat = m_positionFormat == PositionFormat::UNorm16 ? DXGI_FORMAT_R16G16B16A16_UNORM : DXGI_FORMAT_R32G32B32_FLOAT;
+
+    // Offsets advance every other instance, since each pair of instances is drawn to both eyes.
+    const std::array<D3D11_INPUT_ELEMENT_DESC, 2> vertexDesc =
         { {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,  0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            { "POSITION", 0, positionFormat,              0,  0, D3D11_INPUT_PER_VERTEX_DATA,   0 },
+            { "OFFSET",   0, DXGI_FORMAT_R32G32B32_FLOAT, 1,  0, D3D11_INPUT_PER_INSTANCE_DATA, 2 },
         } };
 
     winrt::check_hresult(
@@ -270,7 +410,6 @@ std::future<void> PrimitiveRenderer::CreateDeviceDependentResources()
         ));
 
     // After the pixel shader file is loaded, create the shader and constant buffer.
-    std::vector<byte> pixelShaderFileData = co_await ReadDataAsync(L"ms-appx:///PixelShader.cso");
     winrt::check_hresult(
         m_deviceResources->GetD3DDevice()->CreatePixelShader(
             pixelShaderFileData.data(),
@@ -287,12 +426,19 @@ std::future<void> PrimitiveRenderer::CreateDeviceDependentResources()
             &m_modelConstantBuffer
         ));
 
+    D3D11_SUBRESOURCE_DATA instanceOffsetData = { 0 };
+    instanceOffsetData.pSysMem = c_pointOffsets.data();
+    const CD3D11_BUFFER_DESC instanceOffsetBufferDesc(sizeof(c_pointOffsets), D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_IMMUTABLE);
+    winrt::check_hresult(
+        m_deviceResources->GetD3DDevice()->CreateBuffer(
+            &instanceOffsetBufferDesc,
+            &instanceOffsetData,
+            &m_instanceOffsetBuffer
+        ));
+
 
     if (!m_usingVprtShaders)
     {
-        // Load the pass-through geometry shader.
-        std::vector<byte> geometryShaderFileData = co_await ReadDataAsync(L"ms-appx:///GeometryShader.cso");
-
         // After the pass-through geometry shader file is loaded, create the shader.
         winrt::check_hresult(
             m_deviceResources->GetD3DDevice()->CreateGeometryShader(
@@ -315,49 +461,48 @@ std::future<void> PrimitiveRenderer::CreateDeviceDependentResources()
     m_loadingComplete = true;
 };
 
-void AoaSampleApp::PrimitiveRenderer::RecreateVertexAndIndexBuffers(uint32_t vertexCount, uint32_t indexCount)
+void AoaSampleApp::PrimitiveRenderer::RecreateVertexAndIndexBuffers(uint32_t vertexCount, UINT indexBufferSize)
 {
     m_vertexBuffer.Reset();
     m_indexBuffer.Reset();
+    m_vertexCapacity = 0;
+    m_indexBufferCapacity = 0;
     
-    if (vertexCount == 0 || indexCount == 0)
+    if (vertexCount == 0 || indexBufferSize == 0)
     {
         return;
     }
-    
-    // Allocate our CPU side data that represents the intial buffer data.
-    m_volumeVertices.resize(vertexCount);
-    m_volumeIndices.resize(indexCount);
 
     // Create the buffers for storing the geometry. Let D3D know that we may wish to write updated information into the buffers.
-    D3D11_SUBRESOURCE_DATA vertexBufferData = { 0 };
-    vertexBufferData.pSysMem = m_volumeVertices.data();
-    vertexBufferData.SysMemPitch = 0;
-    vertexBufferData.SysMemSlicePitch = 0;
-    CD3D11_BUFFER_DESC vertexBufferDesc(sizeof(VertexPosition) * vertexCount, D3D11_BIND_VERTEX_BUFFER);
+    // Dynamic buffers don't need initial data, since geometry is written into them right after.
+    CD3D11_BUFFER_DESC vertexBufferDesc(GetVertexStride() * vertexCount, D3D11_BIND_VERTEX_BUFFER);
     vertexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
     vertexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
     winrt::check_hresult(
         m_deviceResources->GetD3DDevice()->CreateBuffer(
             &vertexBufferDesc,
-            &vertexBufferData,
+            nullptr,
             &m_vertexBuffer
         ));
 
-    D3D11_SUBRESOURCE_DATA indexBufferData = { 0 };
-    indexBufferData.pSysMem = m_volumeIndices.data();
-    indexBufferData.SysMemPitch = 0;
-    indexBufferData.SysMemSlicePitch = 0;
-    CD3D11_BUFFER_DESC indexBufferDesc(sizeof(uint32_t) * indexCount, D3D11_BIND_INDEX_BUFFER);
+    CD3D11_BUFFER_DESC indexBufferDesc(indexBufferSize, D3D11_BIND_INDEX_BUFFER);
     indexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
     indexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
     
     winrt::check_hresult(
         m_deviceResources->GetD3DDevice()->CreateBuffer(
             &indexBufferDesc,
-            &indexBufferData,
+            nullptr,
             &m_indexBuffer
         ));
+
+    m_vertexCapacity = vertexCount;
+    m_indexBufferCapacity = indexBufferSize;
+}
+
+UINT PrimitiveRenderer::GetVertexStride() const
+{
+    return m_positionFormat == PositionFormat::UNorm16 ? sizeof(VertexPositionUNorm16) : sizeof(VertexPosition);
 }
 
 void PrimitiveRenderer::ReleaseDeviceDependentResources()
@@ -366,12 +511,20 @@ void PrimitiveRenderer::ReleaseDeviceDependentResources()
     m_usingVprtShaders = false;
     m_vertexCount = 0;
     m_indexCount = 0;
+    m_levelsOfDetail.clear();
+    m_drawnIndices = { 0, 0 };
     m_vertexShader.Reset();
     m_inputLayout.Reset();
     m_pixelShader.Reset();
     m_geometryShader.Reset();
     m_modelConstantBuffer.Reset();
+    m_instanceOffsetBuffer.Reset();
     m_vertexBuffer.Reset();
     m_indexBuffer.Reset();
     m_rasterizerState.Reset();
+
+    // Geometry has to be set again to recreate the buffers.
+    m_vertexCapacity = 0;
+    m_indexBufferCapacity = 0;
+    m_lineMesh = {};
 }
@@ -3,16 +3,26 @@
 #pragma once
 
 #include "../Common/DeviceResources.h"
+#include "../Common/MeshletBuilder.h"
+#include "../Common/MeshSimplifier.h"
 #include "../Common/StepTimer.h"
+#include "GeometricPrimitives.h"
 #include "ShaderStructures.h"
 
 namespace AoaSampleApp
 {
+    // Formats of vertex positions in the vertex buffer.
+    enum class PositionFormat
+    {
+        Float32,
+        UNorm16,    // Quantized to the bounding box of the geometry, for half the memory.
+    };
+
     // This sample renderer instantiates a basic rendering pipeline.
     class PrimitiveRenderer
     {
     public:
-        PrimitiveRenderer(std::shared_ptr<DeviceResources> const& deviceResources);
+        PrimitiveRenderer(std::shared_ptr<DeviceResources> const& deviceResources, PositionFormat positionFormat = PositionFormat::Float32);
 
         std::future<void> CreateDeviceDependentResources();
         void ReleaseDeviceDependentResources();
@@ -24,6 +34,21 @@ namespace AoaSampleApp
             uint32_t indexCount,
             D3D11_PRIMITIVE_TOPOLOGY topology);
 
+        // Draws a mesh in static storage, e.g. a unit mesh placed with SetTransform.
+        // The mesh is only uploaded when it differs from the last one set.
+        void SetLineMesh(LineMesh const& mesh);
+
+        // Levels of detail of the geometry as ranges of its indices, most detailed first. The first one is
+        // selected. Setting geometry again clears them.
+        void SetLevelsOfDetail(std::vector<MeshLevelOfDetail> levels);
+        void SelectLevelOfDetail(size_t level);
+        size_t GetLevelOfDetailCount() const { return (std::max)(m_levelsOfDetail.size(), size_t{ 1 }); }
+
+        // Meshlets of the geometry, covering all its levels of detail. When set, only the meshlets of the selected
+        // level that the last call to CullMeshlets found visible are drawn. Setting geometry again clears them.
+        void SetMeshlets(std::vector<Meshlet> meshlets);
+        void CullMeshlets(ViewProjectionConstantBuffer const& viewProjection);
+
         void SetColor(DirectX::XMFLOAT4 const& color);
 
         void SetTransform(winrt::Windows::Foundation::Numerics::float4x4 const& primitiveToFrameOfReference);
@@ -34,10 +59,23 @@ namespace AoaSampleApp
         bool IsActive() const { return m_isActive; }
         winrt::Windows::Foundation::Numerics::float3 GetPosition() const;
 
+        // Bytes of buffer memory the geometry takes, and the largest distance between a vertex and where it is drawn.
+        uint32_t GetVertexCount() const { return m_vertexCount; }
+        uint32_t GetIndexCount() const { return m_indexCount; }
+        size_t GetVertexBufferSize() const { return size_t{ m_vertexCount } * GetVertexStride(); }
+        size_t GetIndexBufferSize() const { return size_t{ m_indexCount } * GetIndexSize(); }
+        float GetMaxPositionError() const { return m_maxPositionError; }
+
     private:
+        // Issues the draws of Render on the device context.
+        class Direct3DRenderBackend;
+
        void RecreateVertexAndIndexBuffers(
             uint32_t vertexCount,
-            uint32_t indexCount);
+            UINT indexBufferSize);
+
+        UINT GetVertexStride() const;
+        UINT GetIndexSize() const { return m_indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t); }
 
         // Cached pointer to device resources.
         std::shared_ptr<DeviceResources>                m_deviceResources;
@@ -46,22 +84,40 @@ namespace AoaSampleApp
         Microsoft::WRL::ComPtr<ID3D11InputLayout>       m_inputLayout;
         Microsoft::WRL::ComPtr<ID3D11Buffer>            m_vertexBuffer;
         Microsoft::WRL::ComPtr<ID3D11Buffer>            m_indexBuffer;
+        Microsoft::WRL::ComPtr<ID3D11Buffer>            m_instanceOffsetBuffer;
         Microsoft::WRL::ComPtr<ID3D11VertexShader>      m_vertexShader;
         Microsoft::WRL::ComPtr<ID3D11GeometryShader>    m_geometryShader;
         Microsoft::WRL::ComPtr<ID3D11PixelShader>       m_pixelShader;
         Microsoft::WRL::ComPtr<ID3D11Buffer>            m_modelConstantBuffer;
         Microsoft::WRL::ComPtr<ID3D11RasterizerState>   m_rasterizerState;
 
-        // CPU Resources for geometry
-        std::vector<VertexPosition>                     m_volumeVertices;
-        std::vector<uint32_t>                           m_volumeIndices;
-        
+        // Vertices and index bytes the buffers have room for. Geometry is written straight into them, without a CPU copy.
+        uint32_t                                        m_vertexCapacity{ 0 };
+        UINT                                            m_indexBufferCapacity{ 0 };
+
+        // Indices are 16-bit when the vertices allow, for half the memory and index fetch bandwidth.
+        DXGI_FORMAT                                     m_indexFormat{ DXGI_FORMAT_R32_UINT };
+
+        // Format of the vertex positions, and the transform from them to model space.
+        PositionFormat                                  m_positionFormat;
+        DirectX::XMFLOAT4X4                             m_positionToPrimitive;
+        float                                           m_maxPositionError{ 0.0f };
+
         // System resources for cube geometry.
         ModelConstantBuffer                             m_modelConstantBufferData;
 
         // Description about the primitive.
         uint32_t                                        m_vertexCount{ 0 };
         uint32_t                                        m_indexCount{ 0 };
+        LineMesh                                        m_lineMesh;
+
+        // Range of indices drawn, out of the levels of detail if any.
+        std::vector<MeshLevelOfDetail>                  m_levelsOfDetail;
+        MeshLevelOfDetail                               m_drawnIndices{ 0, 0 };
+
+        // Meshlets in index order, and the ranges of the drawn level visible from the current camera.
+        std::vector<Meshlet>                            m_meshlets;
+        std::vector<MeshLevelOfDetail>                  m_visibleIndices;
         D3D11_PRIMITIVE_TOPOLOGY                        m_primitiveTopology{ D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED };
 
         // Transform from model to view.
@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Vertex and line list index tables of unit wireframes, generated at compile time.
+namespace AoaSampleApp::PrimitiveTables
+{
+    namespace Detail
+    {
+        constexpr double c_pi = 3.14159265358979323846;
+
+        // Sine from its Taylor series after reducing the angle to [-pi, pi], accurate to float precision.
+        constexpr double Sin(double angle)
+        {
+            while (angle > c_pi)
+            {
+                angle -= 2.0 * c_pi;
+            }
+            while (angle < -c_pi)
+            {
+                angle += 2.0 * c_pi;
+            }
+
+            double term = angle;
+            double sum = angle;
+            for (int n = 1; n < 12; ++n)
+            {
+                term *= -angle * angle / ((2.0 * n) * (2.0 * n + 1.0));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        constexpr double Cos(double angle)
+        {
+            return Sin(angle + 0.5 * c_pi);
+        }
+
+        template <size_t IndexCount>
+        constexpr bool AreIndicesBelow(std::array<uint32_t, IndexCount> const& indices, size_t vertexCount)
+        {
+            for (const uint32_t index : indices)
+            {
+                if (index >= vertexCount)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template <size_t IndexCount>
+        constexpr bool AreLinesProper(std::array<uint32_t, IndexCount> const& indices)
+        {
+            if (IndexCount % 2 != 0)
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < IndexCount; i += 2)
+            {
+                if (indices[i] == indices[i + 1])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    // Cube with unit edges centered at the origin.
+    //
+    //     Far     Near
+    //    0----1  4----5
+    //    |    |  |    |
+    //    |    |  |    |
+    //    3----2  7----6
+
+    constexpr std::array<DirectX::XMFLOAT3, 8> c_boxVertices =
+    {
+        {
+            { -0.5f,  0.5f, -0.5f }, {  0.5f,  0.5f, -0.5f }, {  0.5f, -0.5f, -0.5f }, { -0.5f, -0.5f, -0.5f },
+            { -0.5f,  0.5f,  0.5f }, {  0.5f,  0.5f,  0.5f }, {  0.5f, -0.5f,  0.5f }, { -0.5f, -0.5f,  0.5f },
+        }
+    };
+
+    // Also matches the corner order of BoundingOrientedBox::GetCorners, which loops around each face the same way.
+    constexpr std::array<uint32_t, 24> c_boxIndices =
+    {
+        {
+            0, 1, 1, 2, 2, 3, 3, 0,     // far plane
+            4, 5, 5, 6, 6, 7, 7, 4,     // near plane
+            0, 4, 1, 5, 2, 6, 3, 7,     // far to near
+        }
+    };
+
+    static_assert(Detail::AreIndicesBelow(c_boxIndices, c_boxVertices.size()));
+    static_assert(Detail::AreLinesProper(c_boxIndices));
+
+    // Pyramid with its apex at the origin, looking towards -Z, with its base spanning [-1, 1] at z = -1.
+    //
+    //    1----2
+    //    |    |
+    //    |    |
+    //    4----3
+
+    constexpr std::array<DirectX::XMFLOAT3, 5> c_fieldOfViewVertices =
+    {
+        {
+            {  0.0f,  0.0f,  0.0f },
+            { -1.0f,  1.0f, -1.0f }, {  1.0f,  1.0f, -1.0f }, {  1.0f, -1.0f, -1.0f }, { -1.0f, -1.0f, -1.0f },
+        }
+    };
+
+    constexpr std::array<uint32_t, 16> c_fieldOfViewIndices =
+    {
+        {
+            1, 2, 2, 3, 3, 4, 4, 1,     // far plane
+            0, 1, 0, 2, 0, 3, 0, 4,     // apex to far
+        }
+    };
+
+    static_assert(Detail::AreIndicesBelow(c_fieldOfViewIndices, c_fieldOfViewVertices.size()));
+    static_assert(Detail::AreLinesProper(c_fieldOfViewIndices));
+
+    // Sphere of radius 1 centered at the origin, with rings of constant latitude and meridians from pole to pole.
+    //
+    // Vertices are the south and north poles, then the rings from south to north.
+    template <uint32_t Tessellation>
+    struct SphereLayout
+    {
+        static_assert(Tessellation >= 3, "A sphere needs at least 3 vertical segments");
+
+        static constexpr uint32_t VerticalSegments = Tessellation;
+        static constexpr uint32_t HorizontalSegments = Tessellation * 2;
+        static constexpr uint32_t RingCount = VerticalSegments - 1;
+
+        static constexpr uint32_t VertexCount = 2 + RingCount * HorizontalSegments;
+        static constexpr uint32_t IndexCount = 2 * (RingCount * HorizontalSegments + VerticalSegments * HorizontalSegments);
+
+        static constexpr uint32_t RingVertex(uint32_t ring, uint32_t segment)
+        {
+            return 2 + ring * HorizontalSegments + segment % HorizontalSegments;
+        }
+    };
+
+    template <uint32_t Tessellation>
+    constexpr auto MakeSphereVertices()
+    {
+        using Layout = SphereLayout<Tessellation>;
+
+        std::array<DirectX::XMFLOAT3, Layout::VertexCount> vertices{};
+        vertices[0] = { 0.0f, -1.0f, 0.0f };
+        vertices[1] = { 0.0f, 1.0f, 0.0f };
+
+        for (uint32_t i = 0; i < Layout::RingCount; i++)
+        {
+            const double latitude = ((i + 1) * Detail::c_pi / Layout::VerticalSegments) - 0.5 * Detail::c_pi;
+            const double dy = Detail::Sin(latitude);
+            const double dxz = Detail::Cos(latitude);
+
+            for (uint32_t j = 0; j < Layout::HorizontalSegments; j++)
+            {
+                const double longitude = j * 2.0 * Detail::c_pi / Layout::HorizontalSegments;
+
+                vertices[Layout::RingVertex(i, j)] =
+                {
+                    static_cast<float>(Detail::Sin(longitude) * dxz),
+                    static_cast<float>(dy),
+                    static_cast<float>(Detail::Cos(longitude) * dxz),
+                };
+            }
+        }
+
+        return vertices;
+    }
+
+    template <uint32_t Tessellation>
+    constexpr auto MakeSphereIndices()
+    {
+        using Layout = SphereLayout<Tessellation>;
+
+        std::array<uint32_t, Layout::IndexCount> indices{};
+        size_t count = 0;
+
+        // Lines along each ring.
+        for (uint32_t i = 0; i < Layout::RingCount; i++)
+        {
+            for (uint32_t j = 0; j < Layout::HorizontalSegments; j++)
+            {
+                indices[count++] = Layout::RingVertex(i, j);
+                indices[count++] = Layout::RingVertex(i, j + 1);
+            }
+        }
+
+        // Lines along each meridian, from pole to pole.
+        for (uint32_t j = 0; j < Layout::HorizontalSegments; j++)
+        {
+            indices[count++] = 0;
+            indices[count++] = Layout::RingVertex(0, j);
+
+            for (uint32_t i = 0; i + 1 < Layout::RingCount; i++)
+            {
+                indices[count++] = Layout::RingVertex(i, j);
+                indices[count++] = Layout::RingVertex(i + 1, j);
+            }
+
+            indices[count++] = Layout::RingVertex(Layout::RingCount - 1, j);
+            indices[count++] = 1;
+        }
+
+        return indices;
+    }
+
+    template <uint32_t Tessellation>
+    constexpr auto c_sphereVertices = MakeSphereVertices<Tessellation>();
+
+    template <uint32_t Tessellation>
+    constexpr auto c_sphereIndices = MakeSphereIndices<Tessellation>();
+}
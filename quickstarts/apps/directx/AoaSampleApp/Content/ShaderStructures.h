@@ -19,4 +19,11 @@ namespace AoaSampleApp
     {
         DirectX::XMFLOAT3 pos;
     };
+
+    // Used to send per-vertex data to the vertex shader, with positions as 16-bit normalized values within
+    // the bounding box of the geometry. The model transform maps them back.
+    struct VertexPositionUNorm16
+    {
+        DirectX::PackedVector::XMUSHORTN4 pos;
+    };
 }
\ No newline at end of file
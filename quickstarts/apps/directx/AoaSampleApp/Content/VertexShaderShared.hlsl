@@ -14,10 +14,12 @@ cbuffer ViewProjectionConstantBuffer : register(b1)
     float4x4 viewProjection[2];
 };
 
-// Per-vertex data used as input to the vertex shader.
+// Per-vertex data used as input to the vertex shader. Positions are read at full precision, since 16-bit
+// floats would round quantized positions to a coarser step than their own.
 struct VertexShaderInput
 {
-    min16float3 pos     : POSITION;
+    float3      pos     : POSITION;
+    float3      offset  : OFFSET;
     uint        instId  : SV_InstanceID;
 };
 
@@ -33,8 +35,9 @@ VertexShaderOutput main(VertexShaderInput input)
     // instance would be drawn, one for left and one for right.
     int idx = input.instId % 2;
 
-    // Transform the vertex position into world space.
+    // Transform the vertex position into world space, shifted by the instance's offset.
     pos = mul(pos, model);
+    pos.xyz += input.offset;
 
     // Correct for perspective and project the vertex position onto the screen.
     pos = mul(pos, viewProjection[idx]);
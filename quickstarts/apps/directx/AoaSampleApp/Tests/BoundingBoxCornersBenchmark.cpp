@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Content/BoundingBoxCorners.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+int main()
+{
+    for (const size_t boxCount : { 10, 100, 1000, 10000, 100000 })
+    {
+        vector<BoundingOrientedBox> boxes(boxCount);
+        OrientedBoxBatch batch;
+        batch.Reserve(boxCount);
+        for (auto& box : boxes)
+        {
+            XMFLOAT4 orientation;
+            XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI)));
+
+            box = BoundingOrientedBox(
+                { RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f) },
+                { RandomFloat(0.01f, 3.0f), RandomFloat(0.01f, 3.0f), RandomFloat(0.01f, 3.0f) },
+                orientation);
+            batch.Add(box);
+        }
+
+        vector<XMFLOAT3> corners(boxCount * BoundingOrientedBox::CORNER_COUNT);
+
+        // Small counts are repeated so that the timer resolution doesn't dominate.
+        const size_t repeatCount = (max<size_t>)(1, 1000000 / boxCount);
+
+        const double batchedSeconds = MeasureSeconds([&]
+        {
+            for (size_t repeat = 0; repeat < repeatCount; ++repeat)
+            {
+                GetBoundingBoxCorners(batch, corners.data());
+            }
+        });
+
+        const double scalarSeconds = MeasureSeconds([&]
+        {
+            for (size_t repeat = 0; repeat < repeatCount; ++repeat)
+            {
+                for (size_t i = 0; i < boxCount; ++i)
+                {
+                    boxes[i].GetCorners(corners.data() + i * BoundingOrientedBox::CORNER_COUNT);
+                }
+            }
+        });
+
+        const double total = double(boxCount) * repeatCount;
+        printf("%7zu boxes: GetBoundingBoxCorners %7.2f M boxes/s, BoundingOrientedBox::GetCorners %7.2f M boxes/s, %.1fx\n",
+            boxCount, total / batchedSeconds * 1e-6, total / scalarSeconds * 1e-6, scalarSeconds / batchedSeconds);
+    }
+
+    return 0;
+}
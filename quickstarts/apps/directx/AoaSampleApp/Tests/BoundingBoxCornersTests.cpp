@@ -0,0 +1,137 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Content/BoundingBoxCorners.h"
+#include "../Content/PrimitiveTables.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr float c_tolerance = 1e-4f;
+    constexpr size_t c_cornerCount = PrimitiveTables::c_boxVertices.size();
+
+    BoundingOrientedBox RandomBox()
+    {
+        XMFLOAT4 orientation;
+        XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI)));
+
+        return BoundingOrientedBox(
+            { RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f) },
+            { RandomFloat(0.01f, 3.0f), RandomFloat(0.01f, 3.0f), RandomFloat(0.01f, 3.0f) },
+            orientation);
+    }
+
+    bool NearEqual(XMFLOAT3 const& a, XMFLOAT3 const& b)
+    {
+        return XMVector3NearEqual(XMLoadFloat3(&a), XMLoadFloat3(&b), XMVectorReplicate(c_tolerance));
+    }
+
+    // Index of the corner of BoundingOrientedBox::GetCorners at the same position as each corner of c_boxVertices,
+    // found from the corners of a unit box.
+    array<size_t, c_cornerCount> GetCornerMapping()
+    {
+        array<XMFLOAT3, BoundingOrientedBox::CORNER_COUNT> unitCorners;
+        BoundingOrientedBox({ 0.0f, 0.0f, 0.0f }, { 0.5f, 0.5f, 0.5f }, { 0.0f, 0.0f, 0.0f, 1.0f }).GetCorners(unitCorners.data());
+
+        array<size_t, c_cornerCount> mapping{};
+        for (size_t corner = 0; corner < c_cornerCount; ++corner)
+        {
+            const auto it = find_if(unitCorners.cbegin(), unitCorners.cend(), [&](XMFLOAT3 const& unitCorner)
+            {
+                return NearEqual(unitCorner, PrimitiveTables::c_boxVertices[corner]);
+            });
+
+            CHECK(it != unitCorners.cend());
+            mapping[corner] = it - unitCorners.cbegin();
+        }
+
+        return mapping;
+    }
+
+    void TestCorners(size_t boxCount)
+    {
+        const auto mapping = GetCornerMapping();
+
+        vector<BoundingOrientedBox> boxes(boxCount);
+        OrientedBoxBatch batch;
+        for (auto& box : boxes)
+        {
+            box = RandomBox();
+            batch.Add(box);
+        }
+
+        // One element past the corners is checked to stay untouched by the padding lanes.
+        const XMFLOAT3 sentinel{ 1234.0f, 1234.0f, 1234.0f };
+        vector<XMFLOAT3> corners(boxCount * c_cornerCount + 1, sentinel);
+        GetBoundingBoxCorners(batch, corners.data());
+        CHECK(NearEqual(corners.back(), sentinel));
+
+        size_t mismatchCount = 0;
+        for (size_t i = 0; i < boxCount; ++i)
+        {
+            array<XMFLOAT3, BoundingOrientedBox::CORNER_COUNT> expected;
+            boxes[i].GetCorners(expected.data());
+
+            for (size_t corner = 0; corner < c_cornerCount; ++corner)
+            {
+                mismatchCount += NearEqual(corners[i * c_cornerCount + corner], expected[mapping[corner]]) ? 0 : 1;
+            }
+        }
+
+        if (!CHECK(mismatchCount == 0))
+        {
+            fprintf(stderr, "  %zu boxes: %zu corners differ from BoundingOrientedBox::GetCorners\n", boxCount, mismatchCount);
+        }
+    }
+
+    void TestOutline()
+    {
+        // The box outline used to be drawn with c_boxIndices over the corners of GetCorners, so both orders must
+        // give the same edges.
+        const BoundingOrientedBox box = RandomBox();
+
+        OrientedBoxBatch batch;
+        batch.Add(box);
+
+        array<XMFLOAT3, c_cornerCount> corners;
+        GetBoundingBoxCorners(batch, corners.data());
+
+        array<XMFLOAT3, BoundingOrientedBox::CORNER_COUNT> expected;
+        box.GetCorners(expected.data());
+
+        auto const& indices = PrimitiveTables::c_boxIndices;
+        for (size_t i = 0; i < indices.size(); i += 2)
+        {
+            XMFLOAT3 const& a = corners[indices[i]];
+            XMFLOAT3 const& b = corners[indices[i + 1]];
+
+            bool found = false;
+            for (size_t j = 0; j < indices.size() && !found; j += 2)
+            {
+                XMFLOAT3 const& expectedA = expected[indices[j]];
+                XMFLOAT3 const& expectedB = expected[indices[j + 1]];
+                found = (NearEqual(a, expectedA) && NearEqual(b, expectedB)) || (NearEqual(a, expectedB) && NearEqual(b, expectedA));
+            }
+
+            CHECK(found);
+        }
+    }
+}
+
+int main()
+{
+    // Counts that fill the last group of four partially, and not at all.
+    for (const size_t boxCount : { 0, 1, 3, 4, 5, 7, 8, 1001 })
+    {
+        TestCorners(boxCount);
+    }
+
+    TestOutline();
+
+    return FailureCount();
+}
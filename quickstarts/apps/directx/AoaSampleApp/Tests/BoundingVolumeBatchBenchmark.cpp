@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/BoundingVolumeBatch.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    XMFLOAT3 RandomPoint(float range)
+    {
+        return { RandomFloat(-range, range), RandomFloat(-range, range), RandomFloat(-range, range) };
+    }
+
+    XMFLOAT4 RandomOrientation()
+    {
+        XMFLOAT4 orientation;
+        XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI)));
+        return orientation;
+    }
+
+    // Prints the rate of the batched test and of DirectXCollision's scalar test over the same elements.
+    template <typename Batched, typename Scalar>
+    void Report(char const* name, size_t count, Batched&& batched, Scalar&& scalar)
+    {
+        const double batchedSeconds = MeasureSeconds(batched);
+        const double scalarSeconds = MeasureSeconds(scalar);
+
+        printf("%-24s %8zu elements: batched %8.1f M/s, scalar %8.1f M/s, %.1fx\n",
+            name, count, count / batchedSeconds * 1e-6, count / scalarSeconds * 1e-6, scalarSeconds / batchedSeconds);
+    }
+
+    template <typename Volume>
+    void Benchmark(char const* volumeName, Volume const& volume, size_t count)
+    {
+        vector<BoundingSphere> spheres(count);
+        SphereBatch sphereBatch;
+        sphereBatch.Reserve(count);
+        for (auto& sphere : spheres)
+        {
+            sphere = BoundingSphere(RandomPoint(4.0f), RandomFloat(0.0f, 0.5f));
+            sphereBatch.Add(sphere.Center, sphere.Radius);
+        }
+
+        vector<BoundingOrientedBox> boxes(count);
+        OrientedBoxBatch boxBatch;
+        boxBatch.Reserve(count);
+        for (auto& box : boxes)
+        {
+            box = BoundingOrientedBox(RandomPoint(4.0f), { RandomFloat(0.01f, 0.5f), RandomFloat(0.01f, 0.5f), RandomFloat(0.01f, 0.5f) }, RandomOrientation());
+            boxBatch.Add(box);
+        }
+
+        vector<uint8_t> results;
+        vector<uint8_t> scalarResults(count);
+
+        string name = string("spheres in ") + volumeName;
+        Report(name.c_str(), count,
+            [&] { IntersectBatch(volume, sphereBatch, results); },
+            [&] { for (size_t i = 0; i < count; ++i) { scalarResults[i] = volume.Intersects(spheres[i]) ? 1 : 0; } });
+
+        name = string("boxes in ") + volumeName;
+        Report(name.c_str(), count,
+            [&] { IntersectBatch(volume, boxBatch, results); },
+            [&] { for (size_t i = 0; i < count; ++i) { scalarResults[i] = volume.Intersects(boxes[i]) ? 1 : 0; } });
+    }
+}
+
+int main()
+{
+    const BoundingSphere sphere({ 0.0f, 0.0f, 0.0f }, 2.0f);
+    const BoundingOrientedBox box({ 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 1.5f }, RandomOrientation());
+    const BoundingFrustum frustum({ 0.0f, 0.0f, 0.0f }, RandomOrientation(), 1.0f, -1.0f, 0.6f, -0.6f, 0.0f, 4.0f);
+
+    for (const size_t count : { 1000, 100000, 1000000 })
+    {
+        Benchmark("sphere", sphere, count);
+        Benchmark("box", box, count);
+        Benchmark("frustum", frustum, count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/BoundingVolumeBatch.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // Not a multiple of the batch width, so that the padding lanes are covered.
+    constexpr size_t c_elementCount = 4099;
+    constexpr size_t c_volumeCount = 20;
+
+    // Elements this close to a volume's boundary may go either way due to rounding, so the reference tests
+    // use the volume shrunk or grown by this much.
+    constexpr float c_margin = 1e-3f;
+
+    XMFLOAT3 RandomPoint(float range)
+    {
+        return { RandomFloat(-range, range), RandomFloat(-range, range), RandomFloat(-range, range) };
+    }
+
+    XMFLOAT4 RandomOrientation()
+    {
+        XMFLOAT4 orientation;
+        XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI)));
+        return orientation;
+    }
+
+    BoundingOrientedBox RandomBox(float range, float maxExtent)
+    {
+        return BoundingOrientedBox(
+            RandomPoint(range),
+            { RandomFloat(0.01f, maxExtent), RandomFloat(0.01f, maxExtent), RandomFloat(0.01f, maxExtent) },
+            RandomOrientation());
+    }
+
+    BoundingFrustum RandomFrustum()
+    {
+        return BoundingFrustum(
+            RandomPoint(1.0f),
+            RandomOrientation(),
+            RandomFloat(0.2f, 2.0f), -RandomFloat(0.2f, 2.0f), RandomFloat(0.2f, 2.0f), -RandomFloat(0.2f, 2.0f),
+            RandomFloat(0.0f, 0.5f), RandomFloat(1.0f, 4.0f));
+    }
+
+    // Grows the volume by the margin, or shrinks it for a negative margin.
+    BoundingSphere Grow(BoundingSphere volume, float margin)
+    {
+        volume.Radius += margin;
+        return volume;
+    }
+
+    BoundingOrientedBox Grow(BoundingOrientedBox volume, float margin)
+    {
+        volume.Extents = { volume.Extents.x + margin, volume.Extents.y + margin, volume.Extents.z + margin };
+        return volume;
+    }
+
+    BoundingFrustum Grow(BoundingFrustum volume, float margin)
+    {
+        volume.RightSlope += margin;
+        volume.LeftSlope -= margin;
+        volume.TopSlope += margin;
+        volume.BottomSlope -= margin;
+        volume.Near = (max)(volume.Near - margin, 0.0f);
+        volume.Far += margin;
+        return volume;
+    }
+
+    // Checks the batch results against the reference test, which is given the volume shrunk and grown by the margin.
+    // Elements the reference finds intersecting the shrunk volume must be reported. For exact tests, elements the
+    // reference finds disjoint from the grown volume must not be reported either.
+    template <typename Volume, typename Reference>
+    void CheckResults(char const* name, Volume const& volume, vector<uint8_t> const& results, size_t size, bool exact, Reference&& intersects)
+    {
+        CHECK(results.size() == size);
+
+        const Volume shrunk = Grow(volume, -c_margin);
+        const Volume grown = Grow(volume, c_margin);
+
+        size_t missed = 0;
+        size_t extra = 0;
+        size_t intersecting = 0;
+        for (size_t i = 0; i < (min)(results.size(), size); ++i)
+        {
+            if (results[i] == 0 && intersects(shrunk, i))
+            {
+                ++missed;
+            }
+            else if (results[i] != 0 && exact && !intersects(grown, i))
+            {
+                ++extra;
+            }
+
+            intersecting += results[i];
+        }
+
+        if (!CHECK(missed == 0 && extra == 0))
+        {
+            fprintf(stderr, "  %s: %zu missed, %zu reported but disjoint\n", name, missed, extra);
+        }
+
+        // Volumes are placed so that some but not all elements intersect, otherwise the test proves little.
+        CHECK(intersecting > 0 && intersecting < size);
+    }
+
+    template <typename Volume>
+    void TestVolume(char const* name, Volume const& volume)
+    {
+        constexpr bool isSphere = is_same_v<Volume, BoundingSphere>;
+
+        vector<uint8_t> results;
+
+        // Points are tested exactly against all volumes.
+        vector<XMFLOAT3> points(c_elementCount);
+        SphereBatch pointBatch;
+        for (auto& point : points)
+        {
+            point = RandomPoint(4.0f);
+            pointBatch.Add(point);
+        }
+
+        IntersectBatch(volume, pointBatch, results);
+        CheckResults(name, volume, results, points.size(), true, [&](Volume const& reference, size_t i)
+        {
+            return reference.Contains(XMLoadFloat3(&points[i])) != DISJOINT;
+        });
+
+        vector<BoundingSphere> spheres(c_elementCount);
+        SphereBatch sphereBatch;
+        for (auto& sphere : spheres)
+        {
+            sphere = BoundingSphere(RandomPoint(4.0f), RandomFloat(0.0f, 0.5f));
+            sphereBatch.Add(sphere.Center, sphere.Radius);
+        }
+
+        IntersectBatch(volume, sphereBatch, results);
+        CheckResults(name, volume, results, spheres.size(), isSphere, [&](Volume const& reference, size_t i)
+        {
+            return reference.Intersects(spheres[i]);
+        });
+
+        vector<BoundingOrientedBox> boxes(c_elementCount);
+        OrientedBoxBatch boxBatch;
+        for (auto& box : boxes)
+        {
+            box = RandomBox(4.0f, 0.5f);
+            boxBatch.Add(box);
+        }
+
+        IntersectBatch(volume, boxBatch, results);
+        CheckResults(name, volume, results, boxes.size(), isSphere, [&](Volume const& reference, size_t i)
+        {
+            return reference.Intersects(boxes[i]);
+        });
+    }
+
+    void TestEmptyBatch()
+    {
+        vector<uint8_t> results(3, 1);
+        IntersectBatch(BoundingSphere({ 0.0f, 0.0f, 0.0f }, 1.0f), SphereBatch{}, results);
+        CHECK(results.empty());
+
+        SphereBatch batch;
+        batch.Add({ 0.0f, 0.0f, 0.0f });
+        batch.Clear();
+        CHECK(batch.Size() == 0 && batch.CenterX.empty());
+    }
+}
+
+int main()
+{
+    for (size_t i = 0; i < c_volumeCount; ++i)
+    {
+        TestVolume("sphere", BoundingSphere(RandomPoint(1.0f), RandomFloat(0.5f, 2.0f)));
+        TestVolume("box", RandomBox(1.0f, 2.0f));
+        TestVolume("frustum", RandomFrustum());
+    }
+
+    TestEmptyBatch();
+
+    return FailureCount();
+}
@@ -0,0 +1,208 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/DiagnosticsUploadQueue.h"
+#include "TestUtilities.h"
+
+#include <functional>
+#include <set>
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+    // Stands in for the Object Anchors service and the queue folder.
+    class FakeUploadTransport : public IDiagnosticsUploadTransport
+    {
+    public:
+        bool Upload(wstring const& path) override
+        {
+            Uploads.push_back(path);
+
+            if (DuringUpload)
+            {
+                DuringUpload(path);
+            }
+
+            return RejectedPaths.count(path) == 0 && !IsOffline;
+        }
+
+        void Delete(wstring const& path) override
+        {
+            Deletes.push_back(path);
+        }
+
+        set<wstring> RejectedPaths;
+        bool IsOffline{ false };
+        function<void(wstring const&)> DuringUpload;
+
+        vector<wstring> Uploads;
+        vector<wstring> Deletes;
+    };
+
+    DiagnosticsUploadLimits CreateLimits()
+    {
+        DiagnosticsUploadLimits limits;
+        limits.MaxBytesPerSecond = 1000;
+        limits.InitialRetryDelay = seconds(5);
+        limits.MaxRetryDelay = seconds(30);
+        limits.MaxQueueBytes = 100;
+        return limits;
+    }
+
+    void TestUploadsInOrder()
+    {
+        FakeUploadTransport transport;
+        DiagnosticsUploadQueue queue(transport, CreateLimits());
+
+        CHECK(!queue.UploadNext());
+
+        queue.Add(L"a", 10);
+        queue.Add(L"b", 10);
+        queue.Add(L"c", 10);
+
+        while (queue.UploadNext())
+        {
+        }
+
+        CHECK(transport.Uploads == vector<wstring>({ L"a", L"b", L"c" }));
+        CHECK(transport.Deletes == vector<wstring>({ L"a", L"b", L"c" }));
+        CHECK(queue.GetPaths().empty());
+        CHECK(queue.GetQueuedBytes() == 0);
+    }
+
+    // A file the service keeps rejecting goes behind the newer files rather than holding them back.
+    void TestRejectedFileDoesNotBlockTheQueue()
+    {
+        FakeUploadTransport transport;
+        transport.RejectedPaths = { L"a" };
+
+        DiagnosticsUploadQueue queue(transport, CreateLimits());
+        queue.Add(L"a", 10);
+        queue.Add(L"b", 10);
+
+        queue.UploadNext();
+        CHECK(queue.GetPaths() == vector<wstring>({ L"b", L"a" }));
+
+        queue.Add(L"c", 10);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            queue.UploadNext();
+        }
+
+        // c was queued after a went behind b, so a is retried before it.
+        CHECK(transport.Uploads == vector<wstring>({ L"a", L"b", L"a", L"c", L"a" }));
+        CHECK(transport.Deletes == vector<wstring>({ L"b", L"c" }));
+
+        // Kept for later, since it may be the device that's offline rather than the file that's rejected.
+        CHECK(queue.GetPaths() == vector<wstring>({ L"a" }));
+        CHECK(queue.GetQueuedBytes() == 10);
+    }
+
+    // Consecutive failures back off up to the maximum delay, and a success starts over.
+    void TestRetryDelays()
+    {
+        FakeUploadTransport transport;
+        transport.IsOffline = true;
+
+        DiagnosticsUploadQueue queue(transport, CreateLimits());
+        queue.Add(L"a", 10);
+        queue.Add(L"b", 10);
+
+        vector<steady_clock::duration> delays;
+        for (int i = 0; i < 5; ++i)
+        {
+            delays.push_back(*queue.UploadNext());
+        }
+
+        CHECK(delays == vector<steady_clock::duration>({ seconds(5), seconds(10), seconds(20), seconds(30), seconds(30) }));
+        CHECK(transport.Deletes.empty());
+        CHECK(queue.GetPaths().size() == 2);
+
+        transport.IsOffline = false;
+        queue.UploadNext();
+        queue.Add(L"c", 10);
+        transport.IsOffline = true;
+
+        CHECK(*queue.UploadNext() == seconds(5));
+    }
+
+    // Uploads pause long enough for the average rate to stay under the limit.
+    void TestRateLimit()
+    {
+        FakeUploadTransport transport;
+        DiagnosticsUploadQueue queue(transport, CreateLimits());
+        queue.Add(L"a", 50);
+
+        // 50 bytes at 1000 bytes/s, minus the time the upload took.
+        const auto delay = *queue.UploadNext();
+        CHECK(delay <= milliseconds(50));
+        CHECK(delay > milliseconds(40));
+    }
+
+    // Files queued past the budget drop the oldest ones, but never the one uploading.
+    void TestTrimKeepsUploadingFile()
+    {
+        FakeUploadTransport transport;
+        DiagnosticsUploadQueue queue(transport, CreateLimits());
+
+        queue.Add(L"a", 40);
+        queue.Add(L"b", 40);
+        queue.Add(L"c", 40);
+
+        CHECK(transport.Deletes == vector<wstring>({ L"a" }));
+        CHECK(queue.GetPaths() == vector<wstring>({ L"b", L"c" }));
+        CHECK(queue.GetQueuedBytes() == 80);
+
+        transport.Deletes.clear();
+        transport.DuringUpload = [&](wstring const& path)
+        {
+            if (path == L"b")
+            {
+                queue.Add(L"d", 40);
+                queue.Add(L"e", 40);
+            }
+        };
+
+        queue.UploadNext();
+
+        // c and d were dropped to make room for e while b uploaded, then b was uploaded and deleted.
+        CHECK(transport.Deletes == vector<wstring>({ L"c", L"d", L"b" }));
+        CHECK(queue.GetPaths() == vector<wstring>({ L"e" }));
+        CHECK(queue.GetQueuedBytes() == 40);
+    }
+
+    // A file queued during an upload is kept over the budget, and a failed upload is then dropped before it.
+    void TestTrimAfterFailedUpload()
+    {
+        FakeUploadTransport transport;
+        transport.IsOffline = true;
+
+        DiagnosticsUploadQueue queue(transport, CreateLimits());
+        queue.Add(L"a", 60);
+
+        transport.DuringUpload = [&](wstring const&) { queue.Add(L"b", 60); };
+        queue.UploadNext();
+
+        // a went behind b, but it's still the oldest file.
+        CHECK(transport.Deletes == vector<wstring>({ L"a" }));
+        CHECK(queue.GetPaths() == vector<wstring>({ L"b" }));
+        CHECK(queue.GetQueuedBytes() == 60);
+    }
+}
+
+int main()
+{
+    TestUploadsInOrder();
+    TestRejectedFileDoesNotBlockTheQueue();
+    TestRetryDelays();
+    TestRateLimit();
+    TestTrimKeepsUploadingFile();
+    TestTrimAfterFailedUpload();
+
+    return FailureCount();
+}
@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/EdgeExtractor.h"
+#include "../Common/MeshOptimizer.h"
+#include "../Common/MeshletBuilder.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+#include <thread>
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // Same meshlet size and feature angle as the app.
+    constexpr size_t c_maxMeshletTriangleCount = 512;
+    constexpr float c_featureAngle = 0.0175f;
+
+    constexpr size_t c_modelCount = 8;
+
+    struct Mesh
+    {
+        string Name;
+        vector<XMFLOAT3> Vertices;
+        vector<uint32_t> Indices;
+    };
+
+    // A sphere curved everywhere, whose edges are nearly all kept, and a box with flat subdivided faces, whose
+    // interior edges are all dropped by the feature angle. Both are welded as the app welds model meshes.
+    Mesh CreateSphere(uint32_t ringCount)
+    {
+        Mesh mesh;
+        mesh.Name = "sphere";
+        CreateBumpySphere(ringCount * 2, ringCount, 0.1f, mesh.Vertices, mesh.Indices);
+        WeldVertices(mesh.Vertices, mesh.Indices);
+        return mesh;
+    }
+
+    Mesh CreateBox(uint32_t divisionCount)
+    {
+        // Face normals with two axes along the face, whose cross product is the normal.
+        constexpr XMFLOAT3 c_faces[][3] =
+        {
+            { {  1.0f,  0.0f,  0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+            { { -1.0f,  0.0f,  0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f } },
+            { {  0.0f,  1.0f,  0.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f } },
+            { {  0.0f, -1.0f,  0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+            { {  0.0f,  0.0f,  1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } },
+            { {  0.0f,  0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } },
+        };
+
+        Mesh mesh;
+        mesh.Name = "box";
+
+        for (auto const& [normal, u, v] : c_faces)
+        {
+            const uint32_t first = static_cast<uint32_t>(mesh.Vertices.size());
+            for (uint32_t j = 0; j <= divisionCount; ++j)
+            {
+                for (uint32_t i = 0; i <= divisionCount; ++i)
+                {
+                    // Grid positions from integers, so that vertices on the edges of faces weld exactly.
+                    const float s = static_cast<float>(i) / divisionCount - 0.5f;
+                    const float t = static_cast<float>(j) / divisionCount - 0.5f;
+                    mesh.Vertices.push_back({
+                        normal.x * 0.5f + u.x * s + v.x * t,
+                        normal.y * 0.5f + u.y * s + v.y * t,
+                        normal.z * 0.5f + u.z * s + v.z * t });
+                }
+            }
+
+            for (uint32_t j = 0; j < divisionCount; ++j)
+            {
+                for (uint32_t i = 0; i < divisionCount; ++i)
+                {
+                    const uint32_t a = first + j * (divisionCount + 1) + i;
+                    const uint32_t b = a + 1;
+                    const uint32_t c = a + divisionCount + 1;
+                    const uint32_t d = c + 1;
+                    mesh.Indices.insert(mesh.Indices.end(), { a, b, d, a, d, c });
+                }
+            }
+        }
+
+        WeldVertices(mesh.Vertices, mesh.Indices);
+        return mesh;
+    }
+
+    // Meshlet ranges of the whole mesh, as the app extracts edges from.
+    vector<MeshLevelOfDetail> GetMeshletRanges(Mesh& mesh)
+    {
+        vector<MeshLevelOfDetail> ranges;
+        for (auto const& meshlet : BuildMeshlets(mesh.Vertices, mesh.Indices, { 0, static_cast<uint32_t>(mesh.Indices.size()) }, c_maxMeshletTriangleCount))
+        {
+            ranges.push_back({ meshlet.StartIndex, meshlet.IndexCount });
+        }
+
+        return ranges;
+    }
+
+    // Lines drawn, and how long extracting them takes.
+    size_t Extract(Mesh const& mesh, vector<MeshLevelOfDetail> const& ranges, float featureAngle, double& seconds)
+    {
+        size_t lineCount = 0;
+        seconds = MeasureSeconds([&]
+        {
+            auto extractedRanges = ranges;
+            lineCount = ExtractEdges(mesh.Vertices, mesh.Indices, extractedRanges, featureAngle).size() / 2;
+        }, 3);
+
+        return lineCount;
+    }
+}
+
+// Compares the lines drawn for a mesh as wireframe triangles, where each edge is drawn once per triangle sharing
+// it, with the edges extracted once per range and those left after dropping edges between coplanar triangles.
+int main()
+{
+    vector<Mesh> meshes;
+    for (const uint32_t ringCount : { 64u, 256u, 512u })
+    {
+        meshes.push_back(CreateSphere(ringCount));
+    }
+    for (const uint32_t divisionCount : { 16u, 64u, 256u })
+    {
+        meshes.push_back(CreateBox(divisionCount));
+    }
+
+    for (auto& mesh : meshes)
+    {
+        const size_t triangleCount = mesh.Indices.size() / 3;
+        const vector<MeshLevelOfDetail> wholeMesh{ { 0, static_cast<uint32_t>(mesh.Indices.size()) } };
+        const auto meshletRanges = GetMeshletRanges(mesh);
+
+        double uniqueSeconds;
+        double meshletSeconds;
+        double featureSeconds;
+        const size_t uniqueLineCount = Extract(mesh, wholeMesh, 0.0f, uniqueSeconds);
+        const size_t meshletLineCount = Extract(mesh, meshletRanges, 0.0f, meshletSeconds);
+        const size_t featureLineCount = Extract(mesh, meshletRanges, c_featureAngle, featureSeconds);
+
+        auto report = [&](char const* name, size_t lineCount, double seconds)
+        {
+            printf("    %-28s %8zu lines, %5.1f%% of wireframe, %7.2f ms, %5.2f M triangles/s\n",
+                name, lineCount, 100.0 * lineCount / (triangleCount * 3), seconds * 1e3, triangleCount / seconds * 1e-6);
+        };
+
+        printf("%s, %zu triangles, %zu meshlets, %zu lines as wireframe triangles:\n", mesh.Name.c_str(), triangleCount, meshletRanges.size(), triangleCount * 3);
+        report("unique edges", uniqueLineCount, uniqueSeconds);
+        report("unique edges per meshlet", meshletLineCount, meshletSeconds);
+        report("feature edges per meshlet", featureLineCount, featureSeconds);
+    }
+
+    //
+    // Models extracted one after the other, then on a thread each as the app builds them.
+    //
+
+    vector<Mesh> models(c_modelCount, meshes[1]);
+    vector<vector<MeshLevelOfDetail>> modelRanges;
+    for (auto& model : models)
+    {
+        modelRanges.push_back(GetMeshletRanges(model));
+    }
+
+    auto extractModel = [&](size_t i)
+    {
+        auto ranges = modelRanges[i];
+        ExtractEdges(models[i].Vertices, models[i].Indices, ranges, c_featureAngle);
+    };
+
+    const double sequentialSeconds = MeasureSeconds([&]
+    {
+        for (size_t i = 0; i < models.size(); ++i)
+        {
+            extractModel(i);
+        }
+    }, 3);
+
+    const double parallelSeconds = MeasureSeconds([&]
+    {
+        vector<thread> threads;
+        for (size_t i = 0; i < models.size(); ++i)
+        {
+            threads.emplace_back(extractModel, i);
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }, 3);
+
+    printf("%zu models of %zu triangles on %u hardware threads: one after the other %7.2f ms, a thread each %7.2f ms, %.1fx\n",
+        models.size(), models[0].Indices.size() / 3, thread::hardware_concurrency(), sequentialSeconds * 1e3, parallelSeconds * 1e3, sequentialSeconds / parallelSeconds);
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/EdgeExtractor.h"
+#include "../Common/MeshOptimizer.h"
+#include "../Common/MeshletBuilder.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    using Edge = pair<uint32_t, uint32_t>;
+
+    Edge MakeEdge(uint32_t a, uint32_t b)
+    {
+        return { (min)(a, b), (max)(a, b) };
+    }
+
+    vector<Edge> GetTriangleEdges(vector<uint32_t> const& indices, MeshLevelOfDetail const& range)
+    {
+        vector<Edge> edges;
+        for (uint32_t i = range.StartIndex; i < range.StartIndex + range.IndexCount; i += 3)
+        {
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                edges.push_back(MakeEdge(indices[i + corner], indices[i + (corner + 1) % 3]));
+            }
+        }
+
+        sort(edges.begin(), edges.end());
+        edges.erase(unique(edges.begin(), edges.end()), edges.end());
+        return edges;
+    }
+
+    vector<Edge> GetLines(vector<uint32_t> const& lines, MeshLevelOfDetail const& range)
+    {
+        vector<Edge> edges;
+        for (uint32_t i = range.StartIndex; i < range.StartIndex + range.IndexCount; i += 2)
+        {
+            edges.push_back(MakeEdge(lines[i], lines[i + 1]));
+        }
+
+        sort(edges.begin(), edges.end());
+        return edges;
+    }
+
+    // Each meshlet's lines are the edges of its own triangles, once each, including those it shares with other
+    // meshlets, so that its lines are drawn whenever its bounds are visible.
+    void TestMeshletsKeepTheirEdges()
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(64, 32, 0.1f, vertices, indices);
+        WeldVertices(vertices, indices);
+
+        const auto meshlets = BuildMeshlets(vertices, indices, { 0, static_cast<uint32_t>(indices.size()) }, 64);
+
+        vector<MeshLevelOfDetail> ranges;
+        for (auto const& meshlet : meshlets)
+        {
+            ranges.push_back({ meshlet.StartIndex, meshlet.IndexCount });
+        }
+
+        const auto lines = ExtractEdges(vertices, indices, ranges, 0.0f);
+        CHECK(ranges.size() == meshlets.size());
+
+        size_t mismatchCount = 0;
+        uint32_t nextIndex = 0;
+        for (size_t i = 0; i < meshlets.size() && i < ranges.size(); ++i)
+        {
+            mismatchCount += GetLines(lines, ranges[i]) != GetTriangleEdges(indices, { meshlets[i].StartIndex, meshlets[i].IndexCount });
+
+            CHECK(ranges[i].StartIndex == nextIndex);
+            nextIndex += ranges[i].IndexCount;
+        }
+
+        CHECK(mismatchCount == 0);
+        CHECK(nextIndex == lines.size());
+
+        // Edges are shared within meshlets, so there are fewer lines than triangle edges.
+        CHECK(lines.size() / 2 < indices.size());
+    }
+
+    // Edges within flat areas are dropped, but not those on the boundary of the mesh, and folds shared by two
+    // ranges are drawn by both.
+    void TestFlatEdgesAreDropped()
+    {
+        // A square of 2 by 2 quads folded by a right angle along its middle column of vertices.
+        const vector<XMFLOAT3> vertices
+        {
+            { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 1.0f },
+            { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f },
+            { 0.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 1.0f },
+        };
+
+        // One range per column of quads, on either side of the fold.
+        vector<uint32_t> indices;
+        for (uint32_t x = 0; x < 2; ++x)
+        {
+            for (uint32_t y = 0; y < 2; ++y)
+            {
+                const uint32_t corner = y * 3 + x;
+                indices.insert(indices.end(), { corner, corner + 1, corner + 4, corner, corner + 4, corner + 3 });
+            }
+        }
+
+        vector<MeshLevelOfDetail> ranges{ { 0, 12 }, { 12, 12 } };
+        const auto lines = ExtractEdges(vertices, indices, ranges, 0.1f);
+
+        // The quad diagonals and the edges between the quads of a column are flat.
+        const vector<Edge> flatColumn{ { 0, 1 }, { 0, 3 }, { 1, 4 }, { 3, 6 }, { 4, 7 }, { 6, 7 } };
+        const vector<Edge> foldedColumn{ { 1, 2 }, { 1, 4 }, { 2, 5 }, { 4, 7 }, { 5, 8 }, { 7, 8 } };
+
+        CHECK(GetLines(lines, ranges[0]) == flatColumn);
+        CHECK(GetLines(lines, ranges[1]) == foldedColumn);
+    }
+}
+
+int main()
+{
+    TestMeshletsKeepTheirEdges();
+    TestFlatEdgesAreDropped();
+
+    return FailureCount();
+}
@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/DirectFileRead.h"
+#include "TestUtilities.h"
+
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace std;
+
+namespace
+{
+    // Same batch size as the model reads of the app.
+    constexpr size_t c_modelReadBatchSize = 8;
+
+    // Stands in for the thread pool ThreadPoolFileReader resumes its reads on.
+    class ThreadPool
+    {
+    public:
+        ThreadPool()
+        {
+            for (unsigned i = 0; i < (max)(4u, thread::hardware_concurrency()); ++i)
+            {
+                m_threads.emplace_back([this] { Run(); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                lock_guard lock(m_mutex);
+                m_stopping = true;
+            }
+
+            m_workAvailable.notify_all();
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        void Submit(function<void()> work)
+        {
+            {
+                lock_guard lock(m_mutex);
+                m_work.push(move(work));
+            }
+
+            m_workAvailable.notify_one();
+        }
+
+    private:
+        void Run()
+        {
+            for (;;)
+            {
+                function<void()> work;
+                {
+                    unique_lock lock(m_mutex);
+                    m_workAvailable.wait(lock, [this] { return m_stopping || !m_work.empty(); });
+                    if (m_work.empty())
+                    {
+                        return;
+                    }
+
+                    work = move(m_work.front());
+                    m_work.pop();
+                }
+
+                work();
+            }
+        }
+
+        mutex m_mutex;
+        condition_variable m_workAvailable;
+        queue<function<void()>> m_work;
+        bool m_stopping{ false };
+        vector<thread> m_threads;
+    };
+
+    // Reads files one after the other into a new buffer each, as reading them with the storage APIs did.
+    size_t ReadSequentially(vector<wstring> const& paths)
+    {
+        size_t byteCount = 0;
+        for (auto const& path : paths)
+        {
+            vector<uint8_t> data;
+            if (TryReadFileDirect(path, data))
+            {
+                byteCount += data.size();
+            }
+        }
+
+        return byteCount;
+    }
+
+    // Reads files as ThreadPoolFileReader::ReadAsync does: one work item per file, all of a batch submitted
+    // before waiting for any, into buffers reused across batches.
+    size_t ReadInBatches(ThreadPool& pool, vector<wstring> const& paths, size_t batchSize, vector<vector<uint8_t>>& buffers)
+    {
+        buffers.resize(batchSize);
+
+        size_t byteCount = 0;
+        for (size_t batchStart = 0; batchStart < paths.size(); batchStart += batchSize)
+        {
+            const size_t count = (min)(batchSize, paths.size() - batchStart);
+
+            mutex mutex;
+            condition_variable readsDone;
+            size_t pendingCount = count;
+            vector<uint8_t> succeeded(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                pool.Submit([&, i]
+                {
+                    succeeded[i] = TryReadFileDirect(paths[batchStart + i], buffers[i]);
+
+                    lock_guard lock(mutex);
+                    if (--pendingCount == 0)
+                    {
+                        readsDone.notify_one();
+                    }
+                });
+            }
+
+            unique_lock lock(mutex);
+            readsDone.wait(lock, [&] { return pendingCount == 0; });
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                byteCount += succeeded[i] ? buffers[i].size() : 0;
+            }
+        }
+
+        return byteCount;
+    }
+
+    vector<wstring> CreateFiles(filesystem::path const& folder, size_t fileCount, size_t fileSize)
+    {
+        filesystem::create_directories(folder);
+
+        vector<char> content(fileSize);
+        for (auto& byte : content)
+        {
+            byte = static_cast<char>(Random()());
+        }
+
+        vector<wstring> paths;
+        for (size_t i = 0; i < fileCount; ++i)
+        {
+            const auto path = folder / ("file" + to_string(i) + ".bin");
+            ofstream(path, ios::binary).write(content.data(), content.size());
+            paths.push_back(path.wstring());
+        }
+
+        return paths;
+    }
+}
+
+int main()
+{
+    const auto root = filesystem::temp_directory_path() / "AoaFileReaderBenchmark";
+    filesystem::remove_all(root);
+
+    ThreadPool pool;
+    vector<vector<uint8_t>> buffers;
+
+    // The same 64 MiB as many small files, such as shaders and small models, and as a few large models.
+    // Files were just written, so reads come from the page cache and measure the reader rather than the disk.
+    struct Scenario
+    {
+        char const* Name;
+        size_t FileCount;
+        size_t FileSize;
+    };
+
+    for (auto const& scenario : { Scenario{ "small", 4096, 16 << 10 }, Scenario{ "large", 8, 8 << 20 } })
+    {
+        const auto paths = CreateFiles(root / scenario.Name, scenario.FileCount, scenario.FileSize);
+        const double megabytes = scenario.FileCount * scenario.FileSize / double(1 << 20);
+
+        printf("%5zu files of %5zu KiB:\n", scenario.FileCount, scenario.FileSize >> 10);
+
+        // Reports the best of a few runs of the reads, which return the number of bytes read.
+        auto report = [&](char const* name, function<size_t()> const& read)
+        {
+            size_t byteCount = 0;
+            const double seconds = MeasureSeconds([&] { byteCount = read(); });
+
+            if (byteCount != scenario.FileCount * scenario.FileSize)
+            {
+                printf("    %-28s read %zu bytes instead of %zu\n", name, byteCount, scenario.FileCount * scenario.FileSize);
+                return;
+            }
+
+            printf("    %-28s %9.0f files/s %8.0f MiB/s\n", name, scenario.FileCount / seconds, megabytes / seconds);
+        };
+
+        report("sequential, new buffers", [&] { return ReadSequentially(paths); });
+        report("batches of 8, reused buffers", [&] { return ReadInBatches(pool, paths, c_modelReadBatchSize, buffers); });
+        report("one batch, reused buffers", [&] { return ReadInBatches(pool, paths, paths.size(), buffers); });
+    }
+
+    filesystem::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/HeadPosePredictor.h"
+#include "HeadTrajectories.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+    // Distance of the search area placed in front of the user, as the app places it by air-tap.
+    constexpr float c_observationDistance = 2.0f;
+
+    // Predictions are made at this rate, rather than at every pose, to keep the replay short.
+    constexpr double c_predictionInterval = 0.1;
+
+    struct Errors
+    {
+        vector<float> Position;         // Meters.
+        vector<float> Direction;        // Degrees.
+        vector<float> SearchCenter;     // Meters, between the predicted and actual point in front of the user.
+    };
+
+    float GetAngleInDegrees(XMFLOAT3 const& left, XMFLOAT3 const& right)
+    {
+        return XMConvertToDegrees(XMVectorGetX(XMVector3AngleBetweenNormals(XMVector3Normalize(XMLoadFloat3(&left)), XMVector3Normalize(XMLoadFloat3(&right)))));
+    }
+
+    XMVECTOR GetSearchCenter(XMFLOAT3 const& position, XMFLOAT3 const& forwardDirection)
+    {
+        return XMVectorMultiplyAdd(XMLoadFloat3(&forwardDirection), XMVectorReplicate(c_observationDistance), XMLoadFloat3(&position));
+    }
+
+    // Feeds the trajectory to the predictor as the app does, and compares each prediction to the pose the
+    // trajectory actually reaches. Without prediction, the latest pose is used, as the app did at first.
+    Errors Replay(HeadTrajectory const& trajectory, HeadPosePredictorSettings const& settings, milliseconds predictionTime, bool predict)
+    {
+        Errors errors;
+        HeadPosePredictor predictor(settings);
+
+        const auto start = steady_clock::time_point{};
+        const double horizon = duration<double>(predictionTime).count();
+        const double end = trajectory.Poses.back().Time - horizon;
+        double nextPredictionTime = 0.0;
+
+        for (auto const& pose : trajectory.Poses)
+        {
+            if (pose.Time > end)
+            {
+                break;
+            }
+
+            predictor.AddHeadPose(pose.Position, pose.ForwardDirection, pose.UpDirection, start + duration_cast<steady_clock::duration>(duration<double>(pose.Time)));
+
+            // Skip the first second, so that every prediction has a full history.
+            if (pose.Time < (max)(1.0, nextPredictionTime))
+            {
+                continue;
+            }
+
+            nextPredictionTime = pose.Time + c_predictionInterval;
+
+            const auto predicted = predict ? *predictor.Predict(predictionTime) : PredictedHeadPose{ pose.Position, pose.ForwardDirection, pose.UpDirection };
+            const auto actual = GetHeadPoseAt(trajectory, pose.Time + horizon);
+
+            errors.Position.push_back(XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&predicted.Position), XMLoadFloat3(&actual.Position)))));
+            errors.Direction.push_back(GetAngleInDegrees(predicted.ForwardDirection, actual.ForwardDirection));
+            errors.SearchCenter.push_back(XMVectorGetX(XMVector3Length(XMVectorSubtract(
+                GetSearchCenter(predicted.Position, predicted.ForwardDirection),
+                GetSearchCenter(actual.Position, actual.ForwardDirection)))));
+        }
+
+        return errors;
+    }
+
+    float GetPercentile(vector<float> values, double percentile)
+    {
+        if (values.empty())
+        {
+            return 0.0f;
+        }
+
+        const size_t index = (min)(values.size() - 1, static_cast<size_t>(values.size() * percentile));
+        nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    void Report(char const* name, Errors const& errors)
+    {
+        printf("    %-26s position %5.1f / %5.1f cm, direction %5.1f / %5.1f deg, area center %5.1f / %5.1f cm\n",
+            name,
+            GetPercentile(errors.Position, 0.5) * 100.0f, GetPercentile(errors.Position, 0.9) * 100.0f,
+            GetPercentile(errors.Direction, 0.5), GetPercentile(errors.Direction, 0.9),
+            GetPercentile(errors.SearchCenter, 0.5) * 100.0f, GetPercentile(errors.SearchCenter, 0.9) * 100.0f);
+    }
+}
+
+// Replays head trajectories recorded on a device if given as arguments, or synthetic ones otherwise, and reports
+// the median and 90th percentile errors of the predicted head pose against the pose actually reached.
+int main(int argc, char** argv)
+{
+    vector<HeadTrajectory> trajectories;
+    for (int i = 1; i < argc; ++i)
+    {
+        trajectories.push_back(LoadHeadTrajectory(argv[i]));
+        if (trajectories.back().Poses.empty())
+        {
+            fprintf(stderr, "No head poses in %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (trajectories.empty())
+    {
+        trajectories = CreateHeadTrajectories();
+    }
+
+    HeadPosePredictorSettings shortHistory;
+    shortHistory.History = milliseconds(250);
+
+    HeadPosePredictorSettings longHistory;
+    longHistory.History = milliseconds(1000);
+
+    for (auto const& trajectory : trajectories)
+    {
+        printf("%s, %.0f s:\n", trajectory.Name.c_str(), trajectory.Poses.back().Time);
+
+        // The app predicts 500 ms ahead, about when a new search area is first searched.
+        for (const auto predictionTime : { milliseconds(250), milliseconds(500), milliseconds(1000) })
+        {
+            printf("  %lld ms ahead:\n", static_cast<long long>(predictionTime.count()));
+
+            Report("latest pose", Replay(trajectory, {}, predictionTime, false));
+            Report("predicted, 250 ms history", Replay(trajectory, shortHistory, predictionTime, true));
+            Report("predicted, 500 ms history", Replay(trajectory, {}, predictionTime, true));
+            Report("predicted, 1 s history", Replay(trajectory, longHistory, predictionTime, true));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include "TestUtilities.h"
+
+#include <DirectXMath.h>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace AoaSampleApp::Tests
+{
+    // A head pose of a trajectory, in the stationary frame of reference with Y up, as the app gets them from
+    // SpatialPointerPose. Time is in seconds from the start of the trajectory.
+    struct HeadPoseSample
+    {
+        double Time;
+        DirectX::XMFLOAT3 Position;
+        DirectX::XMFLOAT3 ForwardDirection;
+        DirectX::XMFLOAT3 UpDirection;
+    };
+
+    struct HeadTrajectory
+    {
+        std::string Name;
+        std::vector<HeadPoseSample> Poses;      // Ordered by time.
+    };
+
+    // Loads head poses recorded on a device, one per line as time, position, forward and up directions, separated
+    // by spaces or commas. Lines that don't start with a number, such as a header, are skipped.
+    inline HeadTrajectory LoadHeadTrajectory(std::string const& path)
+    {
+        HeadTrajectory trajectory;
+        trajectory.Name = path;
+
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            for (auto& c : line)
+            {
+                c = c == ',' ? ' ' : c;
+            }
+
+            std::istringstream values(line);
+            HeadPoseSample pose;
+            if (values >> pose.Time
+                >> pose.Position.x >> pose.Position.y >> pose.Position.z
+                >> pose.ForwardDirection.x >> pose.ForwardDirection.y >> pose.ForwardDirection.z
+                >> pose.UpDirection.x >> pose.UpDirection.y >> pose.UpDirection.z)
+            {
+                trajectory.Poses.push_back(pose);
+            }
+        }
+
+        return trajectory;
+    }
+
+    // Head pose at 60 Hz from yaw and pitch in radians, with the jitter of head tracking added.
+    template <typename Func>
+    HeadTrajectory CreateHeadTrajectory(std::string name, double duration, Func&& getPose)
+    {
+        using namespace DirectX;
+
+        HeadTrajectory trajectory;
+        trajectory.Name = std::move(name);
+
+        for (double time = 0.0; time <= duration; time += 1.0 / 60.0)
+        {
+            XMFLOAT3 position;
+            float yaw;
+            float pitch;
+            getPose(time, position, yaw, pitch);
+
+            yaw += XMConvertToRadians(RandomFloat(-0.2f, 0.2f));
+            pitch += XMConvertToRadians(RandomFloat(-0.2f, 0.2f));
+
+            HeadPoseSample pose;
+            pose.Time = time;
+            pose.Position = { position.x + RandomFloat(-0.002f, 0.002f), position.y + RandomFloat(-0.002f, 0.002f), position.z + RandomFloat(-0.002f, 0.002f) };
+            pose.ForwardDirection = { std::sin(yaw) * std::cos(pitch), std::sin(pitch), std::cos(yaw) * std::cos(pitch) };
+            pose.UpDirection = { -std::sin(yaw) * std::sin(pitch), std::cos(pitch), -std::cos(yaw) * std::sin(pitch) };
+            trajectory.Poses.push_back(pose);
+        }
+
+        return trajectory;
+    }
+
+    // Stand-ins for recorded trajectories: looking around from one spot, walking down an aisle while glancing at
+    // the shelves, and walking between work stations to look down at them.
+    inline std::vector<HeadTrajectory> CreateHeadTrajectories(double duration = 60.0)
+    {
+        constexpr float c_headHeight = 1.6f;
+
+        std::vector<HeadTrajectory> trajectories;
+
+        trajectories.push_back(CreateHeadTrajectory("look around", duration, [&](double time, DirectX::XMFLOAT3& position, float& yaw, float& pitch)
+        {
+            position = { 0.0f, c_headHeight, 0.0f };
+            yaw = DirectX::XM_PIDIV2 * static_cast<float>(std::sin(time * DirectX::XM_2PI / 12.0) + 0.3 * std::sin(time * DirectX::XM_2PI / 5.0));
+            pitch = -0.3f + 0.2f * static_cast<float>(std::sin(time * DirectX::XM_2PI / 7.0));
+        }));
+
+        trajectories.push_back(CreateHeadTrajectory("walk aisle", duration, [&](double time, DirectX::XMFLOAT3& position, float& yaw, float& pitch)
+        {
+            // Back and forth along 8 m at 0.8 m/s, turning around at each end.
+            const double lap = std::fmod(time, 20.0);
+            const bool isReturning = lap >= 10.0;
+            const float z = static_cast<float>(isReturning ? 8.0 - 0.8 * (lap - 10.0) : 0.8 * lap);
+            const float walkYaw = isReturning ? DirectX::XM_PI : 0.0f;
+
+            position = { 0.05f * static_cast<float>(std::sin(time * DirectX::XM_2PI)), c_headHeight, z };
+            yaw = walkYaw + DirectX::XM_PIDIV4 * static_cast<float>(std::sin(time * DirectX::XM_2PI / 4.0));
+            pitch = -0.2f;
+        }));
+
+        trajectories.push_back(CreateHeadTrajectory("work stations", duration, [&](double time, DirectX::XMFLOAT3& position, float& yaw, float& pitch)
+        {
+            // Three stations at the corners of a triangle, 4 s at each and 3 s to walk to the next.
+            constexpr DirectX::XMFLOAT3 c_stations[] = { { 0.0f, 0.0f, 0.0f }, { 4.0f, 0.0f, 2.0f }, { 0.0f, 0.0f, 4.0f } };
+
+            const double cycle = std::fmod(time, 21.0);
+            const int station = static_cast<int>(cycle / 7.0);
+            const double stationTime = cycle - station * 7.0;
+
+            auto const& from = c_stations[station];
+            auto const& to = c_stations[(station + 1) % 3];
+            const float walkYaw = std::atan2(to.x - from.x, to.z - from.z);
+
+            if (stationTime < 4.0)
+            {
+                position = { from.x, c_headHeight, from.z };
+                yaw = walkYaw + DirectX::XM_PIDIV2 + 0.5f * static_cast<float>(std::sin(stationTime * DirectX::XM_2PI / 4.0));
+                pitch = -0.7f;
+            }
+            else
+            {
+                const float t = static_cast<float>((stationTime - 4.0) / 3.0);
+                position = { from.x + (to.x - from.x) * t, c_headHeight, from.z + (to.z - from.z) * t };
+                yaw = walkYaw;
+                pitch = -0.15f;
+            }
+        }));
+
+        return trajectories;
+    }
+
+    // Head pose at the given time, interpolated between the poses around it.
+    inline HeadPoseSample GetHeadPoseAt(HeadTrajectory const& trajectory, double time)
+    {
+        using namespace DirectX;
+
+        auto const& poses = trajectory.Poses;
+        auto next = std::lower_bound(poses.begin(), poses.end(), time, [](HeadPoseSample const& pose, double t) { return pose.Time < t; });
+
+        if (next == poses.begin())
+        {
+            return poses.front();
+        }
+        if (next == poses.end())
+        {
+            return poses.back();
+        }
+
+        auto const& previous = *(next - 1);
+        const float t = static_cast<float>((time - previous.Time) / (next->Time - previous.Time));
+
+        auto lerp = [t](XMFLOAT3 const& from, XMFLOAT3 const& to, bool normalize)
+        {
+            XMVECTOR value = XMVectorLerp(XMLoadFloat3(&from), XMLoadFloat3(&to), t);
+            XMFLOAT3 result;
+            XMStoreFloat3(&result, normalize ? XMVector3Normalize(value) : value);
+            return result;
+        };
+
+        return { time, lerp(previous.Position, next->Position, false), lerp(previous.ForwardDirection, next->ForwardDirection, true), lerp(previous.UpDirection, next->UpDirection, true) };
+    }
+}
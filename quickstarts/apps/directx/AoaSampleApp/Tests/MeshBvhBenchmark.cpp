@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshBvh.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr size_t c_rayCount = 200000;
+    constexpr float c_maxDistance = 20.0f;
+
+    struct Ray
+    {
+        XMFLOAT3 Origin;
+        XMFLOAT3 Direction;
+    };
+
+    // Gaze-like rays from a few meters away into a narrow cone around the model, as picking casts them, and rays
+    // in random directions from random points around it.
+    vector<Ray> CreateRays(bool isCoherent)
+    {
+        vector<Ray> rays(c_rayCount);
+        for (auto& ray : rays)
+        {
+            const XMVECTOR origin = isCoherent
+                ? XMVectorSet(RandomFloat(-0.2f, 0.2f), RandomFloat(-0.2f, 0.2f), 3.0f, 0.0f)
+                : XMVectorSet(RandomFloat(-3.0f, 3.0f), RandomFloat(-3.0f, 3.0f), RandomFloat(-3.0f, 3.0f), 0.0f);
+            const XMVECTOR target = isCoherent
+                ? XMVectorSet(RandomFloat(-0.8f, 0.8f), RandomFloat(-0.8f, 0.8f), 0.0f, 0.0f)
+                : XMVectorSet(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), 0.0f);
+
+            XMStoreFloat3(&ray.Origin, origin);
+            XMStoreFloat3(&ray.Direction, XMVector3Normalize(XMVectorSubtract(target, origin)));
+        }
+
+        return rays;
+    }
+}
+
+int main()
+{
+    const auto coherentRays = CreateRays(true);
+    const auto randomRays = CreateRays(false);
+
+    for (const uint32_t ringCount : { 64, 256, 512 })
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(ringCount * 2, ringCount, 0.1f, vertices, indices);
+
+        optional<MeshBvh> bvh;
+        const double buildSeconds = MeasureSeconds([&]
+        {
+            bvh.emplace(vertices, indices.data(), indices.size());
+        }, 3);
+
+        printf("%7zu triangles: built %zu nodes in %.1f ms\n", indices.size() / 3, bvh->GetNodeCount(), buildSeconds * 1e3);
+
+        for (const bool isCoherent : { true, false })
+        {
+            auto const& rays = isCoherent ? coherentRays : randomRays;
+
+            size_t hitCount = 0;
+            const double seconds = MeasureSeconds([&]
+            {
+                hitCount = 0;
+                for (auto const& ray : rays)
+                {
+                    hitCount += bvh->Intersect(XMLoadFloat3(&ray.Origin), XMLoadFloat3(&ray.Direction), c_maxDistance).has_value();
+                }
+            });
+
+            printf("    %s rays: %6.2f M rays/s, %4.1f%% hit\n", isCoherent ? "gaze  " : "random", rays.size() / seconds * 1e-6, 100.0 * hitCount / rays.size());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshBvh.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr int c_rayCount = 1000;
+
+    // Hits found by both are at the same distance up to float rounding, relative to the size of the sphere.
+    constexpr float c_distanceTolerance = 1e-4f;
+
+    struct Ray
+    {
+        XMFLOAT3 Origin;
+        XMFLOAT3 Direction;
+        float MaxDistance;
+    };
+
+    // Distance at which a ray hits a triangle from either side, or infinity, computed in doubles independently
+    // of the hierarchy's own test.
+    double IntersectTriangle(XMFLOAT3 const& a, XMFLOAT3 const& b, XMFLOAT3 const& c, Ray const& ray)
+    {
+        const auto subtract = [](XMFLOAT3 const& p, XMFLOAT3 const& q) { return array<double, 3>{ double(p.x) - q.x, double(p.y) - q.y, double(p.z) - q.z }; };
+        const auto cross = [](array<double, 3> const& p, array<double, 3> const& q)
+        {
+            return array<double, 3>{ p[1] * q[2] - p[2] * q[1], p[2] * q[0] - p[0] * q[2], p[0] * q[1] - p[1] * q[0] };
+        };
+        const auto dot = [](array<double, 3> const& p, array<double, 3> const& q) { return p[0] * q[0] + p[1] * q[1] + p[2] * q[2]; };
+
+        const array<double, 3> direction{ ray.Direction.x, ray.Direction.y, ray.Direction.z };
+        const auto edge1 = subtract(b, a);
+        const auto edge2 = subtract(c, a);
+        const auto p = cross(direction, edge2);
+        const double determinant = dot(edge1, p);
+        if (determinant == 0.0)
+        {
+            return numeric_limits<double>::infinity();
+        }
+
+        const auto s = subtract(ray.Origin, a);
+        const double u = dot(s, p) / determinant;
+        const auto q = cross(s, edge1);
+        const double v = dot(direction, q) / determinant;
+        const double distance = dot(edge2, q) / determinant;
+
+        return u >= 0.0 && v >= 0.0 && u + v <= 1.0 && distance >= 0.0 ? distance : numeric_limits<double>::infinity();
+    }
+
+    XMFLOAT3 RandomDirection()
+    {
+        XMFLOAT3 direction;
+        XMStoreFloat3(&direction, XMVector3Normalize(XMVectorSet(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), 0.0f)));
+        return direction;
+    }
+
+    // Rays at the sphere from outside, out of it from inside, past it, along the axes, with unnormalized
+    // directions, and with short maximum distances.
+    vector<Ray> CreateRays()
+    {
+        vector<Ray> rays;
+        for (int i = 0; i < c_rayCount; ++i)
+        {
+            Ray ray;
+            switch (i % 5)
+            {
+            case 0:
+            {
+                const XMFLOAT3 direction = RandomDirection();
+                ray.Origin = { -3.0f * direction.x, -3.0f * direction.y, -3.0f * direction.z };
+                ray.Direction = { direction.x + RandomFloat(-0.3f, 0.3f), direction.y + RandomFloat(-0.3f, 0.3f), direction.z + RandomFloat(-0.3f, 0.3f) };
+                ray.MaxDistance = 100.0f;
+                break;
+            }
+            case 1:
+                ray.Origin = { RandomFloat(-0.5f, 0.5f), RandomFloat(-0.5f, 0.5f), RandomFloat(-0.5f, 0.5f) };
+                ray.Direction = RandomDirection();
+                ray.MaxDistance = 100.0f;
+                break;
+            case 2:
+                ray.Origin = { RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f) };
+                ray.Direction = RandomDirection();
+                ray.MaxDistance = 100.0f;
+                break;
+            case 3:
+            {
+                const int axis = i / 5 % 3;
+                const float sign = i / 15 % 2 ? 1.0f : -1.0f;
+                ray.Origin = { RandomFloat(-1.2f, 1.2f), RandomFloat(-1.2f, 1.2f), RandomFloat(-1.2f, 1.2f) };
+                ray.Direction = { axis == 0 ? sign : 0.0f, axis == 1 ? sign : 0.0f, axis == 2 ? sign : 0.0f };
+                ray.MaxDistance = 100.0f;
+                break;
+            }
+            default:
+            {
+                const XMFLOAT3 direction = RandomDirection();
+                const float length = RandomFloat(0.1f, 10.0f);
+                ray.Origin = { RandomFloat(-1.5f, 1.5f), RandomFloat(-1.5f, 1.5f), RandomFloat(-1.5f, 1.5f) };
+                ray.Direction = { direction.x * length, direction.y * length, direction.z * length };
+                ray.MaxDistance = RandomFloat(0.0f, 1.0f) / length;
+                break;
+            }
+            }
+
+            rays.push_back(ray);
+        }
+
+        return rays;
+    }
+
+    void TestHitsMatchBruteForce()
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(128, 64, 0.1f, vertices, indices);
+
+        const MeshBvh bvh(vertices, indices.data(), indices.size());
+        CHECK(bvh.GetTriangleCount() == indices.size() / 3);
+
+        size_t hitCount = 0;
+        size_t mismatchCount = 0;
+        size_t wrongTriangleCount = 0;
+
+        for (auto const& ray : CreateRays())
+        {
+            double nearest = numeric_limits<double>::infinity();
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                nearest = (min)(nearest, IntersectTriangle(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], ray));
+            }
+
+            const bool expectsHit = nearest <= ray.MaxDistance;
+            const auto hit = bvh.Intersect(XMLoadFloat3(&ray.Origin), XMLoadFloat3(&ray.Direction), ray.MaxDistance);
+
+            // Hits right at the maximum distance may fall either way.
+            if (hit.has_value() != expectsHit && fabs(nearest - ray.MaxDistance) > c_distanceTolerance)
+            {
+                ++mismatchCount;
+                continue;
+            }
+
+            if (!hit || !expectsHit)
+            {
+                continue;
+            }
+
+            ++hitCount;
+            if (fabs(hit->Distance - nearest) > c_distanceTolerance)
+            {
+                ++mismatchCount;
+            }
+
+            // Rays through a shared edge may report either triangle, but it must be hit at that distance.
+            const uint32_t* corners = &indices[size_t{ hit->Triangle } * 3];
+            if (hit->Triangle >= indices.size() / 3 ||
+                fabs(IntersectTriangle(vertices[corners[0]], vertices[corners[1]], vertices[corners[2]], ray) - hit->Distance) > c_distanceTolerance)
+            {
+                ++wrongTriangleCount;
+            }
+        }
+
+        CHECK(mismatchCount == 0);
+        CHECK(wrongTriangleCount == 0);
+
+        // Most rays are aimed at the sphere or start inside it.
+        CHECK(hitCount > c_rayCount / 2);
+    }
+
+    void TestEmptyMesh()
+    {
+        const vector<XMFLOAT3> vertices;
+        const MeshBvh bvh(vertices, nullptr, 0);
+
+        CHECK(bvh.GetTriangleCount() == 0);
+        CHECK(!bvh.Intersect(XMVectorZero(), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), 100.0f));
+    }
+}
+
+int main()
+{
+    TestHitsMatchBruteForce();
+    TestEmptyMesh();
+
+    return FailureCount();
+}
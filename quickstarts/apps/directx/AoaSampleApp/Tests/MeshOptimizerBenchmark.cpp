@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshOptimizer.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // Post-transform cache size the app reports ratios for, the smallest of current GPUs.
+    constexpr size_t c_cacheSize = 16;
+
+    // PrimitiveRenderer switches to 16-bit indices up to this many vertices.
+    constexpr size_t c_max16BitVertexCount = 0x10000;
+
+    struct Mesh
+    {
+        string Name;
+        vector<XMFLOAT3> Vertices;
+        vector<uint32_t> Indices;
+    };
+
+    // Models come from scans and exporters with triangles in any order, some with every triangle having vertices
+    // of its own.
+    Mesh CreateMesh(uint32_t segmentCount, uint32_t ringCount, bool isSoup, bool isShuffled)
+    {
+        Mesh mesh;
+        mesh.Name = "sphere " + to_string(segmentCount) + "x" + to_string(ringCount) + (isSoup ? ", soup" : "") + (isShuffled ? ", shuffled" : "");
+        CreateBumpySphere(segmentCount, ringCount, 0.1f, mesh.Vertices, mesh.Indices);
+
+        if (isShuffled)
+        {
+            vector<array<uint32_t, 3>> triangles;
+            for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+            {
+                triangles.push_back({ mesh.Indices[i], mesh.Indices[i + 1], mesh.Indices[i + 2] });
+            }
+
+            shuffle(triangles.begin(), triangles.end(), Random());
+
+            for (size_t t = 0; t < triangles.size(); ++t)
+            {
+                copy(triangles[t].cbegin(), triangles[t].cend(), mesh.Indices.begin() + t * 3);
+            }
+        }
+
+        if (isSoup)
+        {
+            vector<XMFLOAT3> vertices;
+            for (auto& index : mesh.Indices)
+            {
+                vertices.push_back(mesh.Vertices[index]);
+                index = static_cast<uint32_t>(vertices.size() - 1);
+            }
+
+            mesh.Vertices = move(vertices);
+        }
+
+        return mesh;
+    }
+
+    size_t GetIndexBytes(size_t vertexCount, size_t indexCount)
+    {
+        return indexCount * (vertexCount <= c_max16BitVertexCount ? sizeof(uint16_t) : sizeof(uint32_t));
+    }
+}
+
+// Runs the optimizations the app applies to each model mesh, and reports what each one saves: vertices merged by
+// welding, vertices transformed per triangle (ACMR) after reordering, and index buffer bytes once welding lets
+// the mesh use 16-bit indices.
+int main()
+{
+    vector<Mesh> meshes;
+    meshes.push_back(CreateMesh(64, 32, false, false));
+    meshes.push_back(CreateMesh(64, 32, true, true));
+    meshes.push_back(CreateMesh(380, 172, false, true));
+    meshes.push_back(CreateMesh(380, 172, true, true));
+    meshes.push_back(CreateMesh(512, 256, false, true));
+
+    for (auto const& mesh : meshes)
+    {
+        auto vertices = mesh.Vertices;
+        auto indices = mesh.Indices;
+        const double weldSeconds = MeasureSeconds([&]
+        {
+            vertices = mesh.Vertices;
+            indices = mesh.Indices;
+            WeldVertices(vertices, indices);
+        }, 3);
+
+        const float inputRatio = GetAverageCacheMissRatio(indices.data(), indices.size(), 3, c_cacheSize);
+
+        auto optimized = indices;
+        const double optimizeSeconds = MeasureSeconds([&]
+        {
+            optimized = indices;
+            OptimizeVertexCache(optimized.data(), optimized.size());
+        }, 3);
+
+        const float optimizedRatio = GetAverageCacheMissRatio(optimized.data(), optimized.size(), 3, c_cacheSize);
+
+        const size_t originalBytes = mesh.Indices.size() * sizeof(uint32_t);
+        const size_t weldedBytes = GetIndexBytes(vertices.size(), indices.size());
+
+        printf("%s, %zu triangles:\n", mesh.Name.c_str(), mesh.Indices.size() / 3);
+        printf("    weld        %7zu -> %7zu vertices, %7.2f ms\n", mesh.Vertices.size(), vertices.size(), weldSeconds * 1e3);
+        printf("    reorder     ACMR %.3f -> %.3f, %7.2f ms\n", inputRatio, optimizedRatio, optimizeSeconds * 1e3);
+        printf("    indices     %8zu bytes 32-bit -> %8zu bytes %s-bit, %.0f%% saved\n",
+            originalBytes, weldedBytes, vertices.size() <= c_max16BitVertexCount ? "16" : "32", 100.0 * (originalBytes - weldedBytes) / originalBytes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshOptimizer.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // Post-transform cache size of the ratio checks, the smallest of current GPUs.
+    constexpr size_t c_cacheSize = 16;
+
+    constexpr uint32_t c_segmentCount = 64;
+    constexpr uint32_t c_ringCount = 32;
+
+    void ShuffleTriangles(uint32_t* indices, size_t indexCount)
+    {
+        vector<array<uint32_t, 3>> triangles;
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+        }
+
+        shuffle(triangles.begin(), triangles.end(), Random());
+
+        for (size_t t = 0; t < triangles.size(); ++t)
+        {
+            copy(triangles[t].cbegin(), triangles[t].cend(), indices + t * 3);
+        }
+    }
+
+    bool HaveSamePositions(XMFLOAT3 const& a, XMFLOAT3 const& b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    void TestWeldMergesRepeatedVertices()
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(c_segmentCount, c_ringCount, 0.1f, vertices, indices);
+
+        const auto originalVertices = vertices;
+        const auto originalIndices = indices;
+
+        WeldVertices(vertices, indices);
+
+        // One vertex per position: the rings between the poles, without their seam vertex, and the poles.
+        CHECK(vertices.size() == c_segmentCount * (c_ringCount - 1) + 2);
+        CHECK(indices.size() == originalIndices.size());
+
+        bool keepsCorners = true;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            keepsCorners &= indices[i] < vertices.size() && HaveSamePositions(vertices[indices[i]], originalVertices[originalIndices[i]]);
+        }
+
+        CHECK(keepsCorners);
+
+        bool isUnique = true;
+        for (size_t i = 0; i < vertices.size() && isUnique; ++i)
+        {
+            for (size_t j = i + 1; j < vertices.size() && isUnique; ++j)
+            {
+                isUnique = !HaveSamePositions(vertices[i], vertices[j]);
+            }
+        }
+
+        CHECK(isUnique);
+    }
+
+    void TestWeldDropsCollapsedTriangles()
+    {
+        // Vertex 3 repeats vertex 1, with a negative zero, so the second triangle collapses. The last one
+        // refers to a vertex that doesn't exist.
+        vector<XMFLOAT3> vertices{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { -0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+        vector<uint32_t> indices{ 4, 0, 2, 1, 3, 2, 0, 1, 9 };
+
+        WeldVertices(vertices, indices);
+
+        // Vertices come in the order they are first used.
+        CHECK(vertices.size() == 3);
+        CHECK(indices == vector<uint32_t>({ 0, 1, 2 }));
+        CHECK(vertices.size() == 3 && HaveSamePositions(vertices[0], { 0.0f, 0.0f, 1.0f }) && HaveSamePositions(vertices[1], { 1.0f, 0.0f, 0.0f }));
+    }
+
+    void TestCacheMissRatio()
+    {
+        const vector<uint32_t> triangle{ 0, 1, 2 };
+        CHECK(GetAverageCacheMissRatio(triangle.data(), triangle.size(), 3, c_cacheSize) == 3.0f);
+
+        // A quad shares two vertices between its triangles.
+        const vector<uint32_t> quad{ 0, 1, 2, 2, 1, 3 };
+        CHECK(GetAverageCacheMissRatio(quad.data(), quad.size(), 3, c_cacheSize) == 2.0f);
+
+        // A strip of lines shares one vertex between each line and the next.
+        const vector<uint32_t> lines{ 0, 1, 1, 2, 2, 3 };
+        CHECK(GetAverageCacheMissRatio(lines.data(), lines.size(), 2, c_cacheSize) == 4.0f / 3.0f);
+
+        // With room for only three vertices, first-in first-out evicts vertex 0 before it is used again.
+        const vector<uint32_t> fan{ 0, 1, 2, 0, 2, 3, 0, 3, 4 };
+        CHECK(GetAverageCacheMissRatio(fan.data(), fan.size(), 3, 3) > GetAverageCacheMissRatio(fan.data(), fan.size(), 3, 4));
+    }
+
+    void TestOptimizeReordersTriangles()
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(c_segmentCount, c_ringCount, 0.1f, vertices, indices);
+        WeldVertices(vertices, indices);
+
+        // Triangles in random order, as after a simplification or meshlet building.
+        auto shuffled = indices;
+        ShuffleTriangles(shuffled.data(), shuffled.size());
+
+        auto optimized = shuffled;
+        OptimizeVertexCache(optimized.data(), optimized.size());
+
+        CHECK(GetSortedTriangles(optimized.data(), optimized.size()) == GetSortedTriangles(shuffled.data(), shuffled.size()));
+
+        // Close to the one vertex per two triangles of a regular grid, and far below the shuffled order.
+        const float shuffledRatio = GetAverageCacheMissRatio(shuffled.data(), shuffled.size(), 3, c_cacheSize);
+        const float optimizedRatio = GetAverageCacheMissRatio(optimized.data(), optimized.size(), 3, c_cacheSize);
+        CHECK(shuffledRatio > 2.0f);
+        CHECK(optimizedRatio < 0.8f);
+
+        // The indices of the original order are already good, and stay so.
+        auto ordered = indices;
+        OptimizeVertexCache(ordered.data(), ordered.size());
+        CHECK(GetAverageCacheMissRatio(ordered.data(), ordered.size(), 3, c_cacheSize) <= GetAverageCacheMissRatio(indices.data(), indices.size(), 3, c_cacheSize) * 1.05f);
+    }
+
+    void TestOptimizeKeepsOtherRanges()
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(c_segmentCount, c_ringCount, 0.1f, vertices, indices);
+        ShuffleTriangles(indices.data() + 300, 600);
+
+        // Only the second of three ranges is reordered, within itself.
+        auto optimized = indices;
+        OptimizeVertexCache(optimized.data() + 300, 600);
+
+        CHECK(equal(optimized.cbegin(), optimized.cbegin() + 300, indices.cbegin()));
+        CHECK(equal(optimized.cbegin() + 900, optimized.cend(), indices.cbegin() + 900));
+        CHECK(GetSortedTriangles(optimized.data() + 300, 600) == GetSortedTriangles(indices.data() + 300, 600));
+    }
+}
+
+int main()
+{
+    TestWeldMergesRepeatedVertices();
+    TestWeldDropsCollapsedTriangles();
+    TestCacheMissRatio();
+    TestOptimizeReordersTriangles();
+    TestOptimizeKeepsOtherRanges();
+
+    return FailureCount();
+}
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshOptimizer.h"
+#include "../Common/MeshSimplifier.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+#include <thread>
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // Same number of levels as the app builds.
+    constexpr size_t c_levelCount = 4;
+    constexpr float c_bumpHeight = 0.1f;
+
+    // Models loaded together are simplified on their own thread pool work items in the app.
+    constexpr size_t c_modelCount = 8;
+    constexpr uint32_t c_modelRingCount = 160;
+
+    struct Mesh
+    {
+        vector<XMFLOAT3> Vertices;
+        vector<uint32_t> Indices;
+    };
+
+    // A bumpy sphere welded as the app welds model meshes before simplifying them.
+    Mesh CreateMesh(uint32_t ringCount)
+    {
+        Mesh mesh;
+        CreateBumpySphere(ringCount * 2, ringCount, c_bumpHeight, mesh.Vertices, mesh.Indices);
+        WeldVertices(mesh.Vertices, mesh.Indices);
+        return mesh;
+    }
+
+    // Distance from the centroids of the triangles to the surface the sphere was tessellated from, relative to
+    // the radius of the sphere, which is how far a level of detail strays from the shape.
+    void GetSurfaceError(Mesh const& mesh, MeshLevelOfDetail const& level, float& meanError, float& maxError)
+    {
+        double sum = 0.0;
+        maxError = 0.0f;
+
+        for (uint32_t i = level.StartIndex; i + 2 < level.StartIndex + level.IndexCount; i += 3)
+        {
+            const XMVECTOR centroid = XMVectorScale(
+                XMVectorAdd(XMVectorAdd(XMLoadFloat3(&mesh.Vertices[mesh.Indices[i]]), XMLoadFloat3(&mesh.Vertices[mesh.Indices[i + 1]])), XMLoadFloat3(&mesh.Vertices[mesh.Indices[i + 2]])),
+                1.0f / 3.0f);
+
+            XMFLOAT3 point;
+            XMStoreFloat3(&point, centroid);
+
+            const float distance = XMVectorGetX(XMVector3Length(centroid));
+            const float theta = acosf((max)(-1.0f, (min)(1.0f, point.y / distance)));
+            const float phi = atan2f(point.z, point.x);
+            const float radius = 1.0f + c_bumpHeight * sinf(4.0f * theta) * sinf(5.0f * phi);
+
+            const float error = fabsf(distance - radius);
+            sum += error;
+            maxError = (max)(maxError, error);
+        }
+
+        meanError = static_cast<float>(sum / (level.IndexCount / 3));
+    }
+}
+
+int main()
+{
+    for (const uint32_t ringCount : { 160u, 320u, 500u })
+    {
+        const Mesh mesh = CreateMesh(ringCount);
+
+        Mesh levels = mesh;
+        vector<MeshLevelOfDetail> ranges;
+        const double seconds = MeasureSeconds([&]
+        {
+            levels.Indices = mesh.Indices;
+            ranges = BuildMeshLevelsOfDetail(levels.Vertices, levels.Indices, c_levelCount);
+        }, 3);
+
+        printf("%7zu triangles, %7zu vertices: BuildMeshLevelsOfDetail %8.1f ms, %5.2f M triangles/s\n",
+            mesh.Indices.size() / 3, mesh.Vertices.size(), seconds * 1e3, mesh.Indices.size() / 3 / seconds * 1e-6);
+
+        for (size_t i = 0; i < ranges.size(); ++i)
+        {
+            float meanError;
+            float maxError;
+            GetSurfaceError(levels, ranges[i], meanError, maxError);
+
+            printf("    level %zu %7u triangles, surface error mean %.5f, max %.5f\n", i, ranges[i].IndexCount / 3, meanError, maxError);
+        }
+    }
+
+    //
+    // Models simplified one after the other, then on a thread each.
+    //
+
+    vector<Mesh> models(c_modelCount, CreateMesh(c_modelRingCount));
+
+    const double sequentialSeconds = MeasureSeconds([&]
+    {
+        for (auto& model : models)
+        {
+            auto indices = model.Indices;
+            BuildMeshLevelsOfDetail(model.Vertices, indices, c_levelCount);
+        }
+    }, 3);
+
+    const double parallelSeconds = MeasureSeconds([&]
+    {
+        vector<thread> threads;
+        for (auto& model : models)
+        {
+            threads.emplace_back([&model]
+            {
+                auto indices = model.Indices;
+                BuildMeshLevelsOfDetail(model.Vertices, indices, c_levelCount);
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }, 3);
+
+    printf("%zu models of %zu triangles on %u hardware threads: one after the other %8.1f ms, a thread each %8.1f ms, %.1fx\n",
+        models.size(), models[0].Indices.size() / 3, thread::hardware_concurrency(), sequentialSeconds * 1e3, parallelSeconds * 1e3, sequentialSeconds / parallelSeconds);
+
+    return 0;
+}
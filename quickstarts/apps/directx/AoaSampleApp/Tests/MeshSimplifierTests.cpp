@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshSimplifier.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // Square grid of quads in the XY plane, with unit size.
+    void MakeGrid(uint32_t size, vector<XMFLOAT3>& vertices, vector<uint32_t>& indices)
+    {
+        for (uint32_t y = 0; y <= size; ++y)
+        {
+            for (uint32_t x = 0; x <= size; ++x)
+            {
+                vertices.push_back({ float(x) / size, float(y) / size, 0.0f });
+            }
+        }
+
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                const uint32_t corner = y * (size + 1) + x;
+                indices.insert(indices.end(), { corner, corner + 1, corner + size + 2, corner, corner + size + 2, corner + size + 1 });
+            }
+        }
+    }
+
+    // Signed area of the triangles, facing +Z.
+    double GetArea(vector<XMFLOAT3> const& vertices, vector<uint32_t> const& indices)
+    {
+        double area = 0.0;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            XMFLOAT3 const& a = vertices[indices[i]];
+            XMFLOAT3 const& b = vertices[indices[i + 1]];
+            XMFLOAT3 const& c = vertices[indices[i + 2]];
+            area += 0.5 * ((double(b.x) - a.x) * (double(c.y) - a.y) - (double(b.y) - a.y) * (double(c.x) - a.x));
+        }
+
+        return area;
+    }
+
+    bool HasDegenerateTriangles(vector<uint32_t> const& indices)
+    {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i + 2] == indices[i])
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void TestBoundaryIsKept()
+    {
+        // Every collapse inside a flat grid is free, so only the boundary planes keep collapses from eroding its outline.
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        MakeGrid(32, vertices, indices);
+
+        const auto simplified = SimplifyMesh(vertices, indices, indices.size() / 3 / 8);
+
+        CHECK(simplified.size() < indices.size() / 4);
+        CHECK(!HasDegenerateTriangles(simplified));
+
+        const double area = GetArea(vertices, simplified);
+        if (!CHECK(fabs(area - 1.0) < 1e-4))
+        {
+            fprintf(stderr, "  simplified grid covers %g of its area\n", area);
+        }
+    }
+
+    void TestDegenerateTriangles()
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        MakeGrid(16, vertices, indices);
+
+        // Triangles with a repeated index contribute no plane and no edge, and must not come out.
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            indices.insert(indices.end(), { i, i, i + 1, i + 2, i + 3, i + 2, i, i, i });
+        }
+
+        const auto simplified = SimplifyMesh(vertices, indices, 64);
+
+        CHECK(!simplified.empty());
+        CHECK(!HasDegenerateTriangles(simplified));
+        CHECK(fabs(GetArea(vertices, simplified) - 1.0) < 1e-4);
+    }
+}
+
+int main()
+{
+    TestBoundaryIsKept();
+    TestDegenerateTriangles();
+
+    return FailureCount();
+}
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshletBuilder.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr size_t c_maxTriangleCount = 64;
+    constexpr size_t c_frameCount = 1000;
+
+    // Stereo object to clip transforms of a head walking around the model, as the app passes them in.
+    vector<array<XMFLOAT4X4, 2>> CreateViewProjections()
+    {
+        const XMMATRIX projection = XMMatrixPerspectiveFovRH(XMConvertToRadians(60.0f), 1.0f, 0.05f, 20.0f);
+
+        vector<array<XMFLOAT4X4, 2>> frames(c_frameCount);
+        for (size_t frame = 0; frame < frames.size(); ++frame)
+        {
+            const float angle = XM_2PI * frame / frames.size();
+            const XMVECTOR eye = XMVectorSet(2.5f * cosf(angle), RandomFloat(-0.5f, 0.5f), 2.5f * sinf(angle), 0.0f);
+            const XMVECTOR target = XMVectorSet(RandomFloat(-0.8f, 0.8f), RandomFloat(-0.8f, 0.8f), RandomFloat(-0.8f, 0.8f), 0.0f);
+
+            for (size_t i = 0; i < frames[frame].size(); ++i)
+            {
+                const XMVECTOR viewEye = XMVectorAdd(eye, XMVectorSet(0.065f * i, 0.0f, 0.0f, 0.0f));
+                XMStoreFloat4x4(&frames[frame][i], XMMatrixLookAtRH(viewEye, target, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)) * projection);
+            }
+        }
+
+        return frames;
+    }
+}
+
+int main()
+{
+    const auto frames = CreateViewProjections();
+
+    for (const uint32_t ringCount : { 64, 256, 512 })
+    {
+        vector<XMFLOAT3> vertices;
+        vector<uint32_t> indices;
+        CreateBumpySphere(ringCount * 2, ringCount, 0.1f, vertices, indices);
+
+        vector<Meshlet> meshlets;
+        const double buildSeconds = MeasureSeconds([&]
+        {
+            auto reordered = indices;
+            meshlets = BuildMeshlets(vertices, reordered, { 0, static_cast<uint32_t>(reordered.size()) }, c_maxTriangleCount);
+        }, 3);
+
+        for (const bool cullBackFacing : { false, true })
+        {
+            vector<MeshLevelOfDetail> visibleRanges;
+            size_t visibleIndexCount = 0;
+
+            const double cullSeconds = MeasureSeconds([&]
+            {
+                visibleIndexCount = 0;
+                for (auto const& objectToClip : frames)
+                {
+                    CullMeshlets(meshlets.data(), meshlets.size(), objectToClip.data(), objectToClip.size(), cullBackFacing, visibleRanges);
+                    for (auto const& range : visibleRanges)
+                    {
+                        visibleIndexCount += range.IndexCount;
+                    }
+                }
+            });
+
+            printf("%7zu triangles, %5zu meshlets: BuildMeshlets %6.2f M triangles/s, CullMeshlets%s %7.2f M meshlets/s, %.0f us/frame, %4.1f%% of triangles drawn\n",
+                indices.size() / 3, meshlets.size(), indices.size() / 3 / buildSeconds * 1e-6,
+                cullBackFacing ? " with back facing" : "                 ",
+                double(meshlets.size()) * frames.size() / cullSeconds * 1e-6, cullSeconds / frames.size() * 1e6,
+                100.0 * visibleIndexCount / (double(indices.size()) * frames.size()));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/MeshletBuilder.h"
+#include "TestMeshes.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr size_t c_maxTriangleCount = 64;
+    constexpr size_t c_viewCount = 2;
+    constexpr int c_viewTrialCount = 300;
+    constexpr int c_samplesPerTriangle = 8;
+
+    struct View
+    {
+        XMFLOAT4X4 ObjectToClip;
+        XMFLOAT3 Eye;
+    };
+
+    // A stereo pair of perspective views from somewhere around the unit sphere, some of them inside it,
+    // looking near its center, with far planes close enough to cut it at times.
+    array<View, c_viewCount> CreateRandomViews()
+    {
+        const XMVECTOR eye = XMVectorScale(
+            XMVector3Normalize(XMVectorSet(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), 0.0f)),
+            RandomFloat(0.5f, 5.0f));
+        const XMVECTOR target = XMVectorSet(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), 0.0f);
+        const XMVECTOR separation = XMVectorSet(0.065f, 0.0f, 0.0f, 0.0f);
+
+        const XMMATRIX projection = XMMatrixPerspectiveFovRH(XMConvertToRadians(RandomFloat(30.0f, 90.0f)), RandomFloat(0.5f, 2.0f), 0.05f, RandomFloat(1.0f, 10.0f));
+
+        array<View, c_viewCount> views;
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            const XMVECTOR viewEye = i == 0 ? eye : XMVectorAdd(eye, separation);
+            XMStoreFloat4x4(&views[i].ObjectToClip, XMMatrixLookAtRH(viewEye, target, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)) * projection);
+            XMStoreFloat3(&views[i].Eye, viewEye);
+        }
+
+        return views;
+    }
+
+    bool IsInClipVolume(FXMVECTOR point, XMFLOAT4X4 const& objectToClip)
+    {
+        XMFLOAT4 clip;
+        XMStoreFloat4(&clip, XMVector4Transform(XMVectorSetW(point, 1.0f), XMLoadFloat4x4(&objectToClip)));
+
+        return clip.w > 0.0f && fabsf(clip.x) <= clip.w && fabsf(clip.y) <= clip.w && clip.z >= 0.0f && clip.z <= clip.w;
+    }
+
+    // Whether a view sees any of a few points of the triangle, from the side its normal faces if cullBackFacing
+    // is set. Points are only a sample of the triangle, so a triangle found visible is visible, but not the reverse.
+    bool IsTriangleVisible(vector<XMFLOAT3> const& vertices, uint32_t const* corners, View const& view, bool cullBackFacing)
+    {
+        const XMVECTOR a = XMLoadFloat3(&vertices[corners[0]]);
+        const XMVECTOR b = XMLoadFloat3(&vertices[corners[1]]);
+        const XMVECTOR c = XMLoadFloat3(&vertices[corners[2]]);
+
+        if (cullBackFacing)
+        {
+            const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a));
+            if (XMVectorGetX(XMVector3Dot(normal, XMVectorSubtract(XMLoadFloat3(&view.Eye), a))) <= 0.0f)
+            {
+                return false;
+            }
+        }
+
+        for (int sample = 0; sample < c_samplesPerTriangle; ++sample)
+        {
+            // The corners first, then points within the triangle.
+            float u = sample == 1 ? 1.0f : 0.0f;
+            float v = sample == 2 ? 1.0f : 0.0f;
+            if (sample >= 3)
+            {
+                u = RandomFloat(0.0f, 1.0f);
+                v = RandomFloat(0.0f, 1.0f - u);
+            }
+
+            const XMVECTOR point = XMVectorAdd(a, XMVectorAdd(XMVectorScale(XMVectorSubtract(b, a), u), XMVectorScale(XMVectorSubtract(c, a), v)));
+            if (IsInClipVolume(point, view.ObjectToClip))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void TestBuildKeepsTriangles(vector<XMFLOAT3> const& vertices, vector<uint32_t> const& original, vector<uint32_t> const& indices, vector<Meshlet> const& meshlets)
+    {
+        CHECK(!meshlets.empty());
+
+        uint32_t nextIndex = 0;
+        for (auto const& meshlet : meshlets)
+        {
+            CHECK(meshlet.StartIndex == nextIndex);
+            CHECK(meshlet.IndexCount > 0 && meshlet.IndexCount <= c_maxTriangleCount * 3 && meshlet.IndexCount % 3 == 0);
+
+            // The bounding sphere holds all of the meshlet's vertices.
+            for (uint32_t i = meshlet.StartIndex; i < meshlet.StartIndex + meshlet.IndexCount; ++i)
+            {
+                const float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&vertices[indices[i]]), XMLoadFloat3(&meshlet.Center))));
+                CHECK(distance <= meshlet.Radius * 1.0001f + 1e-6f);
+            }
+
+            nextIndex += meshlet.IndexCount;
+        }
+
+        CHECK(nextIndex == indices.size());
+
+        // Same triangles, with the same winding, in another order.
+        CHECK(GetSortedTriangles(original.data(), original.size()) == GetSortedTriangles(indices.data(), indices.size()));
+    }
+
+    // Every triangle seen by a view must be in one of the visible ranges, whatever else they hold.
+    void TestCullingIsConservative(vector<XMFLOAT3> const& vertices, vector<uint32_t> const& indices, vector<Meshlet> const& meshlets, bool cullBackFacing)
+    {
+        size_t missedCount = 0;
+        size_t visibleIndexCount = 0;
+        vector<MeshLevelOfDetail> visibleRanges;
+
+        for (int trial = 0; trial < c_viewTrialCount; ++trial)
+        {
+            const auto views = CreateRandomViews();
+
+            array<XMFLOAT4X4, c_viewCount> objectToClip;
+            for (size_t i = 0; i < views.size(); ++i)
+            {
+                objectToClip[i] = views[i].ObjectToClip;
+            }
+
+            CullMeshlets(meshlets.data(), meshlets.size(), objectToClip.data(), objectToClip.size(), cullBackFacing, visibleRanges);
+
+            vector<bool> drawn(indices.size(), false);
+            for (auto const& range : visibleRanges)
+            {
+                fill(drawn.begin() + range.StartIndex, drawn.begin() + range.StartIndex + range.IndexCount, true);
+                visibleIndexCount += range.IndexCount;
+            }
+
+            for (size_t i = 0; i + 2 < indices.size(); i += 3)
+            {
+                const bool visible = any_of(views.cbegin(), views.cend(), [&](View const& view)
+                {
+                    return IsTriangleVisible(vertices, indices.data() + i, view, cullBackFacing);
+                });
+
+                if (visible && !drawn[i])
+                {
+                    ++missedCount;
+                }
+            }
+        }
+
+        CHECK(missedCount == 0);
+
+        // Culling that never culls would pass the above, so it must also have dropped a fair part of the mesh.
+        CHECK(visibleIndexCount < indices.size() * c_viewTrialCount * 3 / 4);
+    }
+}
+
+int main()
+{
+    vector<XMFLOAT3> vertices;
+    vector<uint32_t> original;
+    CreateBumpySphere(96, 48, 0.1f, vertices, original);
+
+    auto indices = original;
+    const auto meshlets = BuildMeshlets(vertices, indices, { 0, static_cast<uint32_t>(indices.size()) }, c_maxTriangleCount);
+
+    TestBuildKeepsTriangles(vertices, original, indices, meshlets);
+    TestCullingIsConservative(vertices, indices, meshlets, false);
+    TestCullingIsConservative(vertices, indices, meshlets, true);
+
+    return FailureCount();
+}
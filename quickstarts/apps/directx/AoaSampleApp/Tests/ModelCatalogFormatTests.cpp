@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/ModelCatalogFormat.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    vector<ModelCatalogEntry> CreateEntries(size_t count)
+    {
+        vector<ModelCatalogEntry> entries(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& entry = entries[i];
+            entry.Path = L"C:\\Data\\Users\\Objects3D\\model" + to_wstring(i) + L".ou";
+            entry.Size = 1000 + i;
+            entry.ModifiedTime = 132000000000000000ll + static_cast<int64_t>(i);
+            entry.ContentHash = 0x0123456789abcdefull * (i + 1);
+            entry.ModelId.Data1 = static_cast<uint32_t>(i + 1);
+            entry.ModelId.Data4[7] = static_cast<uint8_t>(i);
+
+            XMFLOAT4 orientation;
+            XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI)));
+            entry.BoundingBox = BoundingOrientedBox(
+                { RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) },
+                { RandomFloat(0.1f, 2.0f), RandomFloat(0.1f, 2.0f), RandomFloat(0.1f, 2.0f) },
+                orientation);
+        }
+
+        return entries;
+    }
+
+    bool AreEqual(ModelCatalogEntry const& left, ModelCatalogEntry const& right)
+    {
+        return left.Path == right.Path &&
+            left.Size == right.Size &&
+            left.ModifiedTime == right.ModifiedTime &&
+            left.ContentHash == right.ContentHash &&
+            left.ModelId == right.ModelId &&
+            memcmp(&left.BoundingBox, &right.BoundingBox, sizeof(BoundingOrientedBox)) == 0;
+    }
+
+    void TestRoundTrip()
+    {
+        for (const size_t count : { 0, 1, 100 })
+        {
+            const auto entries = CreateEntries(count);
+            const auto data = EncodeModelCatalog(entries);
+
+            vector<ModelCatalogEntry> decoded;
+            CHECK(DecodeModelCatalog(data.data(), data.size(), decoded));
+            CHECK(decoded.size() == entries.size());
+
+            for (size_t i = 0; i < (min)(decoded.size(), entries.size()); ++i)
+            {
+                CHECK(AreEqual(decoded[i], entries[i]));
+            }
+        }
+    }
+
+    // Paths are stored as UTF-16 code units, two bytes each whatever the size of wchar_t.
+    void TestPathsAreUtf16()
+    {
+        vector<ModelCatalogEntry> entries(1);
+        entries[0].Path = L"\u00e9t\u00e9.ou";
+
+        const auto data = EncodeModelCatalog(entries);
+        CHECK(data.size() == 16 + 88 + entries[0].Path.size() * 2);
+
+        vector<ModelCatalogEntry> decoded;
+        CHECK(DecodeModelCatalog(data.data(), data.size(), decoded));
+        CHECK(decoded.size() == 1 && decoded[0].Path == entries[0].Path);
+    }
+
+    // Every truncation, and a catalog with trailing bytes, are rejected rather than partially read.
+    void TestIncompleteCatalogsAreRejected()
+    {
+        const auto data = EncodeModelCatalog(CreateEntries(3));
+
+        for (size_t size = 0; size < data.size(); ++size)
+        {
+            vector<ModelCatalogEntry> decoded(1);
+            CHECK(!DecodeModelCatalog(data.data(), size, decoded));
+            CHECK(decoded.empty());
+        }
+
+        auto extended = data;
+        extended.push_back(0);
+
+        vector<ModelCatalogEntry> decoded;
+        CHECK(!DecodeModelCatalog(extended.data(), extended.size(), decoded));
+    }
+
+    void TestMalformedCatalogsAreRejected()
+    {
+        const auto data = EncodeModelCatalog(CreateEntries(3));
+        vector<ModelCatalogEntry> decoded;
+
+        // Magic, then version.
+        for (const size_t offset : { 0, 4 })
+        {
+            auto corrupted = data;
+            corrupted[offset] ^= 1;
+            CHECK(!DecodeModelCatalog(corrupted.data(), corrupted.size(), decoded));
+        }
+
+        // A record whose path runs past the end of the string table, through its path offset then its length.
+        for (const size_t field : { 80, 84 })
+        {
+            auto corrupted = data;
+            const size_t offset = 16 + 2 * 88 + field;
+
+            uint32_t value;
+            memcpy(&value, &corrupted[offset], sizeof(value));
+            value += 1000;
+            memcpy(&corrupted[offset], &value, sizeof(value));
+
+            CHECK(!DecodeModelCatalog(corrupted.data(), corrupted.size(), decoded));
+            CHECK(decoded.empty());
+        }
+    }
+
+    void TestContentHash()
+    {
+        // FNV-1a test vectors.
+        CHECK(ComputeModelContentHash(nullptr, 0) == 0xcbf29ce484222325ull);
+        CHECK(ComputeModelContentHash(reinterpret_cast<uint8_t const*>("a"), 1) == 0xaf63dc4c8601ec8cull);
+        CHECK(ComputeModelContentHash(reinterpret_cast<uint8_t const*>("foobar"), 6) == 0x85944171f73967e8ull);
+    }
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestPathsAreUtf16();
+    TestIncompleteCatalogsAreRejected();
+    TestMalformedCatalogsAreRejected();
+    TestContentHash();
+
+    return FailureCount();
+}
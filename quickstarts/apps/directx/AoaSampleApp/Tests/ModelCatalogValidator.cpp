@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/ModelCatalogFormat.h"
+
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+
+using namespace AoaSampleApp;
+using namespace DirectX;
+using namespace std;
+
+// Checks model catalog files copied off a device, e.g. from the LocalCache folder of the app:
+//
+//    ModelCatalogValidator ModelCatalog.bin [more catalogs...]
+//
+// Prints the number of entries of each catalog and the problems found, and returns the number of invalid catalogs.
+namespace
+{
+    string ToString(wstring const& path)
+    {
+        string narrow;
+        for (const wchar_t character : path)
+        {
+            narrow.push_back(character < 0x80 ? static_cast<char>(character) : '?');
+        }
+
+        return narrow;
+    }
+
+    // Problems the format alone doesn't rule out.
+    vector<string> FindProblems(vector<ModelCatalogEntry> const& entries)
+    {
+        vector<string> problems;
+        unordered_set<wstring> paths;
+        const Guid noModelId{};
+
+        for (auto const& entry : entries)
+        {
+            const string path = ToString(entry.Path);
+
+            if (entry.Path.empty())
+            {
+                problems.push_back("entry with an empty path");
+            }
+
+            if (!paths.insert(entry.Path).second)
+            {
+                problems.push_back(path + ": more than one entry");
+            }
+
+            if (entry.ModelId == noModelId)
+            {
+                problems.push_back(path + ": no model id");
+            }
+
+            auto const& box = entry.BoundingBox;
+            const XMVECTOR extents = XMLoadFloat3(&box.Extents);
+            if (XMVector3IsNaN(XMLoadFloat3(&box.Center)) || XMVector3IsInfinite(XMLoadFloat3(&box.Center)) ||
+                XMVector3IsNaN(extents) || XMVector3IsInfinite(extents) || !XMVector3GreaterOrEqual(extents, XMVectorZero()))
+            {
+                problems.push_back(path + ": invalid bounding box");
+            }
+            else if (fabsf(XMVectorGetX(XMVector4Length(XMLoadFloat4(&box.Orientation))) - 1.0f) > 1e-3f)
+            {
+                problems.push_back(path + ": bounding box orientation isn't a unit quaternion");
+            }
+        }
+
+        return problems;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <catalog>...\n", argv[0]);
+        return -1;
+    }
+
+    int invalidCount = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        ifstream file(argv[i], ios::binary);
+        if (!file)
+        {
+            printf("%s: can't be opened\n", argv[i]);
+            ++invalidCount;
+            continue;
+        }
+
+        const vector<uint8_t> data{ istreambuf_iterator<char>(file), istreambuf_iterator<char>() };
+
+        vector<ModelCatalogEntry> entries;
+        if (!DecodeModelCatalog(data.data(), data.size(), entries))
+        {
+            printf("%s: not a catalog of the current version, or truncated (%zu bytes)\n", argv[i], data.size());
+            ++invalidCount;
+            continue;
+        }
+
+        const auto problems = FindProblems(entries);
+
+        printf("%s: %zu entries, %zu problems\n", argv[i], entries.size(), problems.size());
+        for (auto const& problem : problems)
+        {
+            printf("    %s\n", problem.c_str());
+        }
+
+        invalidCount += problems.empty() ? 0 : 1;
+    }
+
+    return invalidCount;
+}
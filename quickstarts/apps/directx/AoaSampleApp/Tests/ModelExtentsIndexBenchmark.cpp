@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/ModelExtentsIndex.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr size_t c_modelCount = 10000;
+    constexpr size_t c_tapCount = 10000;
+
+    struct Model
+    {
+        Guid Id;
+        XMFLOAT3 Extents;
+    };
+
+    // Models from a few centimeters to a few meters, as in a catalog of parts and assemblies.
+    vector<Model> CreateModels()
+    {
+        vector<Model> models(c_modelCount);
+        for (size_t i = 0; i < models.size(); ++i)
+        {
+            models[i].Id = Guid{ static_cast<uint32_t>(i), static_cast<uint16_t>(Random()()), static_cast<uint16_t>(Random()()), {} };
+
+            const float scale = exp2f(RandomFloat(-5.0f, 2.0f));
+            models[i].Extents = { scale * RandomFloat(0.2f, 1.0f), scale * RandomFloat(0.2f, 1.0f), scale * RandomFloat(0.2f, 1.0f) };
+        }
+
+        return models;
+    }
+
+    // What UpdateObjectSearchArea computed on every tap before the index, over data already copied out of the
+    // models, so it leaves out the per-model WinRT calls.
+    ModelExtentsSummary ScanModels(vector<Model> const& models)
+    {
+        ModelExtentsSummary summary;
+        summary.ModelCount = models.size();
+
+        for (auto const& model : models)
+        {
+            summary.MaxExtents = { (max)(summary.MaxExtents.x, model.Extents.x), (max)(summary.MaxExtents.y, model.Extents.y), (max)(summary.MaxExtents.z, model.Extents.z) };
+
+            const float maxExtent = (max)((max)(model.Extents.x, model.Extents.y), model.Extents.z);
+            if (maxExtent > summary.MaxModelExtent)
+            {
+                summary.MaxModelExtent = maxExtent;
+                summary.MaxModelDiagonal = XMVectorGetX(XMVector3Length(XMLoadFloat3(&model.Extents)));
+            }
+        }
+
+        return summary;
+    }
+}
+
+int main()
+{
+    const auto models = CreateModels();
+
+    ModelExtentsIndex index;
+    const double addSeconds = MeasureSeconds([&]
+    {
+        index = {};
+        for (auto const& model : models)
+        {
+            index.Add(model.Id, model.Extents);
+        }
+    }, 3);
+
+    printf("%zu models:\n", models.size());
+    printf("    add all                 %8.2f ms\n", addSeconds * 1e3);
+
+    ModelExtentsSummary scanned;
+    const double scanSeconds = MeasureSeconds([&]
+    {
+        for (size_t tap = 0; tap < c_tapCount / 100; ++tap)
+        {
+            scanned = ScanModels(models);
+        }
+    }) / (c_tapCount / 100);
+
+    // Keeps the reads from being optimized out.
+    volatile float sink = 0.0f;
+    const double summarySeconds = MeasureSeconds([&]
+    {
+        for (size_t tap = 0; tap < c_tapCount; ++tap)
+        {
+            auto const& summary = index.GetSummary();
+            sink = summary.MaxModelExtent + index.GetSizeClassSummaries().front().second.MaxModelDiagonal;
+        }
+    }) / c_tapCount;
+
+    // Reloading a model, as releasing and reloading its file does.
+    const double updateSeconds = MeasureSeconds([&]
+    {
+        for (size_t i = 0; i < c_tapCount; ++i)
+        {
+            auto const& model = models[i % models.size()];
+            index.Remove(model.Id);
+            index.Add(model.Id, model.Extents);
+        }
+    }) / c_tapCount;
+
+    auto const& summary = index.GetSummary();
+    const bool isSame = summary.ModelCount == scanned.ModelCount &&
+        summary.MaxExtents.x == scanned.MaxExtents.x && summary.MaxExtents.y == scanned.MaxExtents.y && summary.MaxExtents.z == scanned.MaxExtents.z &&
+        summary.MaxModelExtent == scanned.MaxModelExtent;
+
+    printf("    scan per tap            %8.2f us\n", scanSeconds * 1e6);
+    printf("    index summaries per tap %8.3f us\n", summarySeconds * 1e6);
+    printf("    remove and add a model  %8.2f us\n", updateSeconds * 1e6);
+    printf("    summaries %s\n", isSame ? "match the scan" : "DIFFER from the scan");
+
+    return isSame ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/PointCloudDownsampler.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr float c_leafSize = 0.01f;
+    constexpr size_t c_levelCount = 4;
+
+    // Points scattered over the faces of a 2 m box with a few millimeters of noise, like a scan of an object.
+    vector<XMFLOAT3> CreateScannedBox(size_t pointCount)
+    {
+        vector<XMFLOAT3> points(pointCount);
+        for (auto& point : points)
+        {
+            float coordinates[3] = { RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) };
+            const size_t face = Random()() % 6;
+            coordinates[face / 2] = (face % 2 ? 1.0f : -1.0f) + RandomFloat(-0.003f, 0.003f);
+
+            point = { coordinates[0], coordinates[1], coordinates[2] };
+        }
+
+        return points;
+    }
+}
+
+int main()
+{
+    for (const size_t pointCount : { 1000000, 4000000, 8000000 })
+    {
+        const auto points = CreateScannedBox(pointCount);
+
+        vector<uint32_t> indices(pointCount);
+        iota(indices.begin(), indices.end(), 0u);
+
+        size_t keptCount = 0;
+        const double downsampleSeconds = MeasureSeconds([&]
+        {
+            keptCount = DownsamplePointCloud(points, indices, c_leafSize).size();
+        }, 3);
+
+        size_t levelCount = 0;
+        const double levelsSeconds = MeasureSeconds([&]
+        {
+            auto levelIndices = indices;
+            levelCount = BuildPointCloudLevelsOfDetail(points, levelIndices, c_leafSize, c_levelCount).size();
+        }, 3);
+
+        printf("%zu points: DownsamplePointCloud %6.2f M points/s (%zu kept), BuildPointCloudLevelsOfDetail %6.2f M points/s (%zu levels)\n",
+            pointCount, pointCount / downsampleSeconds * 1e-6, keptCount, pointCount / levelsSeconds * 1e-6, levelCount);
+    }
+
+    return 0;
+}
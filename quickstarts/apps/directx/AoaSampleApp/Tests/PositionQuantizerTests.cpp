@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/PositionQuantizer.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+using namespace std;
+
+namespace
+{
+    constexpr float c_stepCount = 65535.0f;
+
+    // Rounding to the nearest step leaves at most half a step per axis, plus the float rounding of positions
+    // of this magnitude.
+    XMVECTOR GetErrorBound(FXMVECTOR minimum, FXMVECTOR maximum)
+    {
+        const XMVECTOR magnitude = XMVectorMax(XMVectorAbs(minimum), XMVectorAbs(maximum));
+        return XMVectorAdd(
+            XMVectorScale(XMVectorSubtract(maximum, minimum), 0.5f / c_stepCount),
+            XMVectorScale(magnitude, 4.0f * FLT_EPSILON));
+    }
+
+    void TestRandomClouds()
+    {
+        for (int trial = 0; trial < 100; ++trial)
+        {
+            // From millimeter parts to rooms, away from the origin.
+            const float size = powf(10.0f, RandomFloat(-3.0f, 2.0f));
+            const XMFLOAT3 offset{ RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f) };
+
+            vector<XMFLOAT3> positions(1000);
+            for (auto& position : positions)
+            {
+                position = { offset.x + RandomFloat(0.0f, size), offset.y + RandomFloat(0.0f, size * 0.5f), offset.z + RandomFloat(0.0f, size * 2.0f) };
+            }
+
+            XMVECTOR minimum = g_XMFltMax;
+            XMVECTOR maximum = XMVectorNegate(g_XMFltMax);
+            for (auto const& position : positions)
+            {
+                minimum = XMVectorMin(minimum, XMLoadFloat3(&position));
+                maximum = XMVectorMax(maximum, XMLoadFloat3(&position));
+            }
+
+            const XMVECTOR bound = GetErrorBound(minimum, maximum);
+
+            const PositionQuantizer quantizer(positions.data(), positions.size());
+            const XMMATRIX positionToPrimitive = quantizer.GetPositionToPrimitive();
+
+            size_t outOfBoundCount = 0;
+            size_t mismatchCount = 0;
+            for (auto const& position : positions)
+            {
+                const XMUSHORTN4 quantized = quantizer.Quantize(XMLoadFloat3(&position));
+                const XMVECTOR dequantized = quantizer.Dequantize(quantized);
+
+                if (!XMVector3LessOrEqual(XMVectorAbs(XMVectorSubtract(dequantized, XMLoadFloat3(&position))), bound))
+                {
+                    ++outOfBoundCount;
+                }
+
+                // The model transform, which is what the vertex shader applies, maps to the same position.
+                const XMVECTOR transformed = XMVector3TransformCoord(XMLoadUShortN4(&quantized), positionToPrimitive);
+                if (!XMVector3NearEqual(transformed, dequantized, XMVectorScale(bound, 0.01f)))
+                {
+                    ++mismatchCount;
+                }
+
+                CHECK(quantized.w == 0xffff);
+            }
+
+            CHECK(outOfBoundCount == 0);
+            CHECK(mismatchCount == 0);
+        }
+    }
+
+    void TestBoxCornersUseFullRange()
+    {
+        const vector<XMFLOAT3> positions{ { -1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.5f }, { 0.0f, 3.0f, 4.0f } };
+        const PositionQuantizer quantizer(positions.data(), positions.size());
+
+        const XMUSHORTN4 minimum = quantizer.Quantize(XMVectorSet(-1.0f, 2.0f, 3.0f, 0.0f));
+        const XMUSHORTN4 maximum = quantizer.Quantize(XMVectorSet(4.0f, 5.0f, 6.5f, 0.0f));
+
+        CHECK(minimum.x == 0 && minimum.y == 0 && minimum.z == 0);
+        CHECK(maximum.x == 0xffff && maximum.y == 0xffff && maximum.z == 0xffff);
+        CHECK(XMVector3Equal(quantizer.Dequantize(minimum), XMVectorSet(-1.0f, 2.0f, 3.0f, 0.0f)));
+    }
+
+    void TestFlatAndSinglePointClouds()
+    {
+        // Points in a plane keep their coordinate across it exactly.
+        vector<XMFLOAT3> flat;
+        for (int i = 0; i < 100; ++i)
+        {
+            flat.push_back({ RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), 0.25f });
+        }
+
+        const PositionQuantizer flatQuantizer(flat.data(), flat.size());
+        for (auto const& position : flat)
+        {
+            const XMUSHORTN4 quantized = flatQuantizer.Quantize(XMLoadFloat3(&position));
+            CHECK(quantized.z == 0);
+            CHECK(XMVectorGetZ(flatQuantizer.Dequantize(quantized)) == 0.25f);
+        }
+
+        const XMFLOAT3 point{ 1.5f, -2.0f, 7.0f };
+        const PositionQuantizer pointQuantizer(&point, 1);
+        CHECK(XMVector3Equal(pointQuantizer.Dequantize(pointQuantizer.Quantize(XMLoadFloat3(&point))), XMLoadFloat3(&point)));
+
+        // No positions at all doesn't give a transform with NaNs in it.
+        const PositionQuantizer emptyQuantizer(nullptr, 0);
+        XMFLOAT4X4 transform;
+        XMStoreFloat4x4(&transform, emptyQuantizer.GetPositionToPrimitive());
+        CHECK(all_of(&transform.m[0][0], &transform.m[0][0] + 16, [](float value) { return isfinite(value); }));
+    }
+}
+
+int main()
+{
+    TestRandomClouds();
+    TestBoxCornersUseFullRange();
+    TestFlatAndSinglePointClouds();
+
+    return FailureCount();
+}
@@ -0,0 +1,161 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Content/PrimitiveRenderBackend.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr uint32_t c_pointOffsetCount = 5;
+
+    struct RecordedDraw
+    {
+        uint32_t IndexCount;
+        uint32_t InstanceCount;
+        uint32_t StartIndex;
+
+        bool operator==(RecordedDraw const& other) const
+        {
+            return IndexCount == other.IndexCount && InstanceCount == other.InstanceCount && StartIndex == other.StartIndex;
+        }
+    };
+
+    // Records the calls instead of making them on a device.
+    class RecordingRenderBackend : public IPrimitiveRenderBackend
+    {
+    public:
+        void BindPipeline(bool isPointList, uint32_t firstPointOffset) override
+        {
+            ++BindCount;
+            BoundPointList = isPointList;
+            FirstPointOffset = firstPointOffset;
+        }
+
+        void UpdateModelConstantBuffer(ModelConstantBuffer const& data) override
+        {
+            // Updates must come after the pipeline is bound, and before the draws that use them.
+            CHECK(BindCount > 0 && Draws.empty());
+            ++UpdateCount;
+            LastUpdate = data;
+        }
+
+        void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startIndex) override
+        {
+            CHECK(UpdateCount > 0);
+            Draws.push_back({ indexCount, instanceCount, startIndex });
+        }
+
+        int BindCount{ 0 };
+        int UpdateCount{ 0 };
+        bool BoundPointList{ false };
+        uint32_t FirstPointOffset{ 0 };
+        ModelConstantBuffer LastUpdate{};
+        vector<RecordedDraw> Draws;
+    };
+
+    ModelConstantBuffer CreateModelConstants()
+    {
+        ModelConstantBuffer constants{};
+        XMStoreFloat4x4(&constants.model, XMMatrixTranslation(1.0f, 2.0f, 3.0f));
+        constants.color = { 1.0f, 0.0f, 1.0f, 1.0f };
+        return constants;
+    }
+
+    PrimitiveDraw CreateDraw(bool isPointList, MeshLevelOfDetail drawnIndices, vector<MeshLevelOfDetail> const* visibleIndices, ModelConstantBuffer const& constants)
+    {
+        PrimitiveDraw draw{};
+        draw.IsPointList = isPointList;
+        draw.PointOffsetCount = c_pointOffsetCount;
+        draw.DrawnIndices = drawnIndices;
+        draw.VisibleIndices = visibleIndices;
+        draw.ModelConstants = &constants;
+        return draw;
+    }
+
+    // A point cloud takes one update and one draw of an instance pair per offset, whatever its level of detail.
+    void TestPointCloudIsOneDraw()
+    {
+        const auto constants = CreateModelConstants();
+
+        for (const MeshLevelOfDetail level : { MeshLevelOfDetail{ 0, 100000 }, MeshLevelOfDetail{ 100000, 25000 } })
+        {
+            RecordingRenderBackend backend;
+            DrawPrimitive(backend, CreateDraw(true, level, nullptr, constants));
+
+            CHECK(backend.BindCount == 1);
+            CHECK(backend.BoundPointList);
+            CHECK(backend.FirstPointOffset == 0);
+            CHECK(backend.UpdateCount == 1);
+            CHECK(memcmp(&backend.LastUpdate, &constants, sizeof(constants)) == 0);
+            CHECK(backend.Draws == vector<RecordedDraw>({ { level.IndexCount, 2 * c_pointOffsetCount, level.StartIndex } }));
+        }
+    }
+
+    // Other primitives are drawn once for both eyes, from the offset of no shift.
+    void TestLinesWithoutMeshletsAreOneDraw()
+    {
+        const auto constants = CreateModelConstants();
+
+        RecordingRenderBackend backend;
+        DrawPrimitive(backend, CreateDraw(false, { 24, 48 }, nullptr, constants));
+
+        CHECK(backend.BindCount == 1);
+        CHECK(!backend.BoundPointList);
+        CHECK(backend.FirstPointOffset == c_pointOffsetCount - 1);
+        CHECK(backend.UpdateCount == 1);
+        CHECK(backend.Draws == vector<RecordedDraw>({ { 48, 2, 24 } }));
+    }
+
+    // Meshes with meshlets draw each visible range, with a single update for all of them.
+    void TestVisibleMeshletRangesAreDrawn()
+    {
+        const auto constants = CreateModelConstants();
+        const vector<MeshLevelOfDetail> visible{ { 0, 300 }, { 600, 90 }, { 1200, 0 }, { 1500, 30 } };
+
+        RecordingRenderBackend backend;
+        DrawPrimitive(backend, CreateDraw(false, { 0, 3000 }, &visible, constants));
+
+        CHECK(backend.BindCount == 1);
+        CHECK(backend.UpdateCount == 1);
+        CHECK(backend.Draws == vector<RecordedDraw>({ { 300, 2, 0 }, { 90, 2, 600 }, { 30, 2, 1500 } }));
+    }
+
+    // Nothing visible or nothing to draw costs no state changes or updates.
+    void TestNothingToDraw()
+    {
+        const auto constants = CreateModelConstants();
+        const vector<MeshLevelOfDetail> noneVisible;
+        const vector<MeshLevelOfDetail> emptyRanges{ { 300, 0 } };
+
+        for (auto const& draw :
+            {
+                CreateDraw(false, { 0, 3000 }, &noneVisible, constants),
+                CreateDraw(false, { 0, 3000 }, &emptyRanges, constants),
+                CreateDraw(false, { 0, 0 }, nullptr, constants),
+                CreateDraw(true, { 0, 0 }, nullptr, constants),
+            })
+        {
+            RecordingRenderBackend backend;
+            DrawPrimitive(backend, draw);
+
+            CHECK(backend.BindCount == 0);
+            CHECK(backend.UpdateCount == 0);
+            CHECK(backend.Draws.empty());
+        }
+    }
+}
+
+int main()
+{
+    TestPointCloudIsOneDraw();
+    TestLinesWithoutMeshletsAreOneDraw();
+    TestVisibleMeshletRangesAreDrawn();
+    TestNothingToDraw();
+
+    return FailureCount();
+}
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Content/PrimitiveTables.h"
+#include "ReferenceSphere.h"
+#include "TestUtilities.h"
+
+#include <map>
+#include <mutex>
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr size_t c_lookupCount = 1000000;
+
+    // The previous GetUnitSphereLineMesh, which generated each tessellation on first use and then looked it up
+    // under a lock at every draw.
+    ReferenceMesh const& GetCachedReferenceSphere(unsigned short tessellation)
+    {
+        static mutex s_lock;
+        static map<unsigned short, ReferenceMesh> s_meshes;
+
+        lock_guard lock(s_lock);
+
+        auto [it, inserted] = s_meshes.try_emplace(tessellation);
+        if (inserted)
+        {
+            it->second = MakeReferenceSphere(tessellation);
+        }
+
+        return it->second;
+    }
+
+    template <uint32_t Tessellation>
+    void Benchmark()
+    {
+        auto const& vertices = PrimitiveTables::c_sphereVertices<Tessellation>;
+        auto const& indices = PrimitiveTables::c_sphereIndices<Tessellation>;
+
+        // Keeps the meshes from being optimized out.
+        volatile float sink = 0.0f;
+
+        const double generateSeconds = MeasureSeconds([&]
+        {
+            sink = MakeReferenceSphere(Tessellation).Vertices.back().x;
+        });
+
+        GetCachedReferenceSphere(Tessellation);
+        const double cachedSeconds = MeasureSeconds([&]
+        {
+            for (size_t i = 0; i < c_lookupCount; ++i)
+            {
+                sink = GetCachedReferenceSphere(Tessellation).Vertices.back().x;
+            }
+        }) / c_lookupCount;
+
+        const double tableSeconds = MeasureSeconds([&]
+        {
+            for (size_t i = 0; i < c_lookupCount; ++i)
+            {
+                sink = vertices.back().x;
+            }
+        }) / c_lookupCount;
+
+        const size_t bytes = vertices.size() * sizeof(XMFLOAT3) + indices.size() * sizeof(uint32_t);
+        printf("tessellation %2u, %4zu vertices, %5zu indices, %6zu bytes: generate %7.2f us, per draw: cached %6.2f ns, table %6.2f ns\n",
+            Tessellation, vertices.size(), indices.size(), bytes, generateSeconds * 1e6, cachedSeconds * 1e9, tableSeconds * 1e9);
+    }
+}
+
+// Compares the sphere wireframe tables to the run-time generator they replaced: the cost of generating a mesh on
+// first use, and of getting it at every draw, which used to take a lock and a map lookup.
+int main()
+{
+    Benchmark<8>();
+    Benchmark<15>();        // The tessellation the app draws search spheres with.
+    Benchmark<32>();
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Content/PrimitiveTables.h"
+#include "ReferenceSphere.h"
+#include "TestUtilities.h"
+
+#include <utility>
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // XMScalarSinCos is accurate to a few float ulps, while the tables are rounded from double precision.
+    constexpr float c_tolerance = 1e-6f;
+
+    template <uint32_t Tessellation>
+    void TestSphere()
+    {
+        auto const& vertices = PrimitiveTables::c_sphereVertices<Tessellation>;
+        auto const& indices = PrimitiveTables::c_sphereIndices<Tessellation>;
+
+        const ReferenceMesh reference = MakeReferenceSphere(Tessellation);
+
+        if (!CHECK(vertices.size() == reference.Vertices.size() && indices.size() == reference.Indices.size()))
+        {
+            return;
+        }
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            maxError = (max)({ maxError,
+                fabsf(vertices[i].x - reference.Vertices[i].x),
+                fabsf(vertices[i].y - reference.Vertices[i].y),
+                fabsf(vertices[i].z - reference.Vertices[i].z) });
+        }
+
+        if (!CHECK(maxError <= c_tolerance))
+        {
+            fprintf(stderr, "  tessellation %u: vertices differ by up to %g\n", Tessellation, maxError);
+        }
+
+        CHECK(equal(indices.cbegin(), indices.cend(), reference.Indices.cbegin()));
+    }
+
+    template <uint32_t... Tessellations>
+    void TestSpheres(integer_sequence<uint32_t, Tessellations...>)
+    {
+        (TestSphere<Tessellations + 3>(), ...);
+    }
+
+    void TestSinCos()
+    {
+        // The constexpr functions are evaluated in double precision, so they should match the standard library
+        // well beyond float precision, including angles outside [-pi, pi].
+        double maxError = 0.0;
+        for (double angle = -20.0; angle <= 20.0; angle += 0.001)
+        {
+            maxError = (max)({ maxError,
+                fabs(PrimitiveTables::Detail::Sin(angle) - sin(angle)),
+                fabs(PrimitiveTables::Detail::Cos(angle) - cos(angle)) });
+        }
+
+        if (!CHECK(maxError < 1e-9))
+        {
+            fprintf(stderr, "  Sin/Cos differ from the standard library by up to %g\n", maxError);
+        }
+    }
+}
+
+int main()
+{
+    TestSinCos();
+
+    // Tessellations 3 to 32, around the one the app draws search spheres with.
+    TestSpheres(make_integer_sequence<uint32_t, 30>{});
+
+    return FailureCount();
+}
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace AoaSampleApp::Tests
+{
+    struct ReferenceMesh
+    {
+        std::vector<DirectX::XMFLOAT3> Vertices;
+        std::vector<uint32_t> Indices;
+    };
+
+    // The sphere generator PrimitiveTables replaced, which built the mesh at run time with XMScalarSinCos.
+    inline ReferenceMesh MakeReferenceSphere(uint32_t tessellation)
+    {
+        using namespace DirectX;
+
+        ReferenceMesh mesh;
+
+        const uint32_t verticalSegments = tessellation;
+        const uint32_t horizontalSegments = tessellation * 2;
+        const uint32_t ringCount = verticalSegments - 1;
+
+        mesh.Vertices.reserve(2 + ringCount * horizontalSegments);
+        mesh.Vertices.push_back({ 0.0f, -1.0f, 0.0f });
+        mesh.Vertices.push_back({ 0.0f, 1.0f, 0.0f });
+
+        for (uint32_t i = 1; i <= ringCount; i++)
+        {
+            float dy, dxz;
+            XMScalarSinCos(&dy, &dxz, (i * XM_PI / verticalSegments) - XM_PIDIV2);
+
+            for (uint32_t j = 0; j < horizontalSegments; j++)
+            {
+                float dx, dz;
+                XMScalarSinCos(&dx, &dz, j * XM_2PI / horizontalSegments);
+
+                mesh.Vertices.push_back({ dx * dxz, dy, dz * dxz });
+            }
+        }
+
+        const auto ringVertex = [&](uint32_t ring, uint32_t segment)
+        {
+            return 2 + ring * horizontalSegments + segment % horizontalSegments;
+        };
+
+        mesh.Indices.reserve(2 * (ringCount * horizontalSegments + verticalSegments * horizontalSegments));
+
+        for (uint32_t i = 0; i < ringCount; i++)
+        {
+            for (uint32_t j = 0; j < horizontalSegments; j++)
+            {
+                mesh.Indices.push_back(ringVertex(i, j));
+                mesh.Indices.push_back(ringVertex(i, j + 1));
+            }
+        }
+
+        for (uint32_t j = 0; j < horizontalSegments; j++)
+        {
+            mesh.Indices.push_back(0);
+            mesh.Indices.push_back(ringVertex(0, j));
+
+            for (uint32_t i = 0; i + 1 < ringCount; i++)
+            {
+                mesh.Indices.push_back(ringVertex(i, j));
+                mesh.Indices.push_back(ringVertex(i + 1, j));
+            }
+
+            mesh.Indices.push_back(ringVertex(ringCount - 1, j));
+            mesh.Indices.push_back(1);
+        }
+
+        return mesh;
+    }
+}
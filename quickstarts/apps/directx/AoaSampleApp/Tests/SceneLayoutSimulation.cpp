@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/SceneLayout.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    // The production cell searched when no model is expected anywhere, as by an air-tap search area.
+    constexpr XMFLOAT3 c_cellExtents{ 4.0f, 2.0f, 4.0f };      // Full widths.
+
+    // Models sit on fixtures of this many models each, within a meter of each other.
+    constexpr size_t c_modelsPerFixture = 4;
+
+    // Cost of a detection pass: a fixed cost per query plus the cost of the points in its search area. Each model
+    // in its search area is detected with the same probability per pass whatever the size of the area.
+    constexpr double c_secondsPerQuery = 0.05;
+    constexpr double c_secondsPerCubicMeter = 0.01;
+    constexpr float c_detectionProbability = 0.5f;
+
+    // Number of passes over a targeted area and its tolerance, as ObjectTracker and ParseSceneLayout default to.
+    constexpr uint32_t c_targetedSearchPasses = 3;
+    constexpr float c_tolerance = 0.25f;
+
+    // Models are off their place in the layout by a few centimeters, and now and then moved farther than the
+    // tolerance. Detected poses are off by a couple of centimeters and a degree.
+    constexpr float c_placementError = 0.05f;
+    constexpr float c_movedProbability = 0.1f;
+    constexpr float c_movedDistance = 0.6f;
+    constexpr float c_positionError = 0.02f;
+    constexpr float c_yawErrorInDegrees = 1.0f;
+
+    constexpr size_t c_trialCount = 200;
+    constexpr double c_maxTime = 600.0;
+
+    struct SceneModel
+    {
+        XMFLOAT3 Position;      // Center of the bounding box.
+        XMFLOAT4 Orientation;
+        XMFLOAT3 Extents;       // Full widths.
+    };
+
+    struct Scene
+    {
+        vector<SceneModel> Models;
+        SceneLayout Layout;
+    };
+
+    Guid GetModelId(size_t index)
+    {
+        Guid id{};
+        id.Data1 = static_cast<uint32_t>(index + 1);
+        return id;
+    }
+
+    size_t GetModelIndex(Guid const& id)
+    {
+        return id.Data1 - 1;
+    }
+
+    XMFLOAT4 RotationY(float yaw)
+    {
+        XMFLOAT4 orientation;
+        XMStoreFloat4(&orientation, XMQuaternionRotationAxis(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), yaw));
+        return orientation;
+    }
+
+    // Fixtures at random places well inside the cell. The layout relates every pair of models of a fixture by
+    // their nominal poses, while the models are placed with some error.
+    Scene CreateScene(size_t modelCount)
+    {
+        Scene scene;
+        vector<SceneModel> nominalModels;
+
+        for (size_t fixture = 0; fixture * c_modelsPerFixture < modelCount; ++fixture)
+        {
+            const XMFLOAT3 fixturePosition{ RandomFloat(-0.8f, 0.8f), RandomFloat(-0.5f, 0.5f), RandomFloat(-0.8f, 0.8f) };
+            const float fixtureYaw = RandomFloat(-XM_PI, XM_PI);
+
+            const size_t first = nominalModels.size();
+            for (size_t i = first; i < (min)(first + c_modelsPerFixture, modelCount); ++i)
+            {
+                const float size = RandomFloat(0.1f, 0.4f);
+
+                SceneModel nominal;
+                nominal.Position = { fixturePosition.x + RandomFloat(-0.5f, 0.5f), fixturePosition.y + RandomFloat(-0.2f, 0.2f), fixturePosition.z + RandomFloat(-0.5f, 0.5f) };
+                nominal.Orientation = RotationY(fixtureYaw + XM_PIDIV2 * static_cast<float>(i % 4));
+                nominal.Extents = { size * RandomFloat(0.5f, 1.0f), size * RandomFloat(0.5f, 1.0f), size * RandomFloat(0.5f, 1.0f) };
+                nominalModels.push_back(nominal);
+
+                for (size_t j = first; j < i; ++j)
+                {
+                    // Pose of model i in the coordinate system of model j.
+                    const XMVECTOR orientation = XMLoadFloat4(&nominalModels[j].Orientation);
+                    const XMVECTOR inverseOrientation = XMQuaternionInverse(orientation);
+
+                    XMFLOAT3 relativePosition;
+                    XMFLOAT4 relativeOrientation;
+                    XMStoreFloat3(&relativePosition, XMVector3Rotate(XMVectorSubtract(XMLoadFloat3(&nominal.Position), XMLoadFloat3(&nominalModels[j].Position)), inverseOrientation));
+                    XMStoreFloat4(&relativeOrientation, XMQuaternionMultiply(XMLoadFloat4(&nominal.Orientation), inverseOrientation));
+
+                    scene.Layout.AddRelation(GetModelId(j), GetModelId(i), relativePosition, relativeOrientation, c_tolerance);
+                }
+            }
+        }
+
+        for (auto model : nominalModels)
+        {
+            const float offset = RandomFloat(0.0f, 1.0f) < c_movedProbability ? c_movedDistance : c_placementError;
+            model.Position = { model.Position.x + RandomFloat(-offset, offset), model.Position.y, model.Position.z + RandomFloat(-offset, offset) };
+            scene.Models.push_back(model);
+        }
+
+        return scene;
+    }
+
+    struct SearchArea
+    {
+        BoundingOrientedBox Box;
+        uint32_t RemainingPasses;
+    };
+
+    bool Contains(BoundingOrientedBox const& box, XMFLOAT3 const& position)
+    {
+        return box.Contains(XMLoadFloat3(&position)) != DISJOINT;
+    }
+
+    double GetCost(BoundingOrientedBox const& box)
+    {
+        return c_secondsPerQuery + c_secondsPerCubicMeter * 8.0 * box.Extents.x * box.Extents.y * box.Extents.z;
+    }
+
+    // Runs detection passes as ObjectTracker does until every model is detected, and returns the time it took.
+    // With the layout, the neighbors of each detected model are searched first, in areas around their expected
+    // pose as ObjectTracker::AddTargetedSearchArea makes them.
+    double Simulate(Scene const& scene, bool useLayout)
+    {
+        const BoundingOrientedBox cell({}, { c_cellExtents.x * 0.5f, c_cellExtents.y * 0.5f, c_cellExtents.z * 0.5f }, { 0.0f, 0.0f, 0.0f, 1.0f });
+
+        vector<bool> isDetected(scene.Models.size(), false);
+        size_t detectedCount = 0;
+        unordered_map<size_t, SearchArea> targetedSearchAreas;
+        double time = 0.0;
+
+        while (detectedCount < scene.Models.size() && time < c_maxTime)
+        {
+            vector<pair<size_t, BoundingOrientedBox>> queries;
+            for (auto it = targetedSearchAreas.begin(); it != targetedSearchAreas.end();)
+            {
+                queries.emplace_back(it->first, it->second.Box);
+                it = --it->second.RemainingPasses == 0 ? targetedSearchAreas.erase(it) : next(it);
+            }
+
+            if (queries.empty())
+            {
+                for (size_t i = 0; i < scene.Models.size(); ++i)
+                {
+                    if (!isDetected[i])
+                    {
+                        queries.emplace_back(i, cell);
+                    }
+                }
+            }
+
+            for (auto const& [index, area] : queries)
+            {
+                time += GetCost(area);
+            }
+
+            for (auto const& [index, area] : queries)
+            {
+                auto const& model = scene.Models[index];
+                if (isDetected[index] || !Contains(area, model.Position) || RandomFloat(0.0f, 1.0f) >= c_detectionProbability)
+                {
+                    continue;
+                }
+
+                isDetected[index] = true;
+                ++detectedCount;
+                targetedSearchAreas.erase(index);
+
+                if (!useLayout)
+                {
+                    continue;
+                }
+
+                XMFLOAT3 detectedPosition{ model.Position.x + RandomFloat(-c_positionError, c_positionError), model.Position.y + RandomFloat(-c_positionError, c_positionError), model.Position.z + RandomFloat(-c_positionError, c_positionError) };
+                const XMFLOAT4 yawError = RotationY(XMConvertToRadians(RandomFloat(-c_yawErrorInDegrees, c_yawErrorInDegrees)));
+                XMFLOAT4 detectedOrientation;
+                XMStoreFloat4(&detectedOrientation, XMQuaternionMultiply(XMLoadFloat4(&model.Orientation), XMLoadFloat4(&yawError)));
+
+                for (auto const& neighbor : scene.Layout.GetNeighbors(GetModelId(index)))
+                {
+                    const size_t neighborIndex = GetModelIndex(neighbor.ModelId);
+                    if (isDetected[neighborIndex])
+                    {
+                        continue;
+                    }
+
+                    XMFLOAT3 position;
+                    XMFLOAT4 orientation;
+                    neighbor.GetPose(detectedPosition, detectedOrientation, position, orientation);
+
+                    // The model's bounding box at the expected pose, grown by the tolerance.
+                    auto const& extents = scene.Models[neighborIndex].Extents;
+                    const XMFLOAT3 halfExtents{ extents.x * 0.5f + neighbor.Tolerance, extents.y * 0.5f + neighbor.Tolerance, extents.z * 0.5f + neighbor.Tolerance };
+
+                    targetedSearchAreas.insert_or_assign(neighborIndex, SearchArea{ BoundingOrientedBox(position, halfExtents, orientation), c_targetedSearchPasses });
+                }
+            }
+        }
+
+        return time;
+    }
+
+    void Report(char const* name, vector<double> times)
+    {
+        sort(times.begin(), times.end());
+        printf("    %-16s median %6.1f s, 90th percentile %6.1f s\n", name, times[times.size() / 2], times[times.size() * 9 / 10]);
+    }
+}
+
+// Simulates the time until every model of a production cell is detected, with and without scene layout priors,
+// over random scenes. Detection is modeled by its cost and a detection probability per pass, so the times compare
+// the two searches rather than predict times on a device.
+int main()
+{
+    for (const size_t modelCount : { size_t(4), size_t(8), size_t(16), size_t(32) })
+    {
+        vector<double> withoutLayout;
+        vector<double> withLayout;
+
+        for (size_t trial = 0; trial < c_trialCount; ++trial)
+        {
+            const auto scene = CreateScene(modelCount);
+            withoutLayout.push_back(Simulate(scene, false));
+            withLayout.push_back(Simulate(scene, true));
+        }
+
+        printf("%zu models, %zu per fixture, time until all are detected:\n", modelCount, c_modelsPerFixture);
+        Report("without layout", withoutLayout);
+        Report("with layout", withLayout);
+    }
+
+    return 0;
+}
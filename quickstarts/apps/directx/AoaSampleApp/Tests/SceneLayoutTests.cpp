@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/SceneLayout.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    Guid CreateModelId(uint32_t number)
+    {
+        Guid id{};
+        id.Data1 = number;
+        return id;
+    }
+
+    bool IsNear(XMFLOAT3 const& left, XMFLOAT3 const& right)
+    {
+        return XMVector3NearEqual(XMLoadFloat3(&left), XMLoadFloat3(&right), XMVectorReplicate(1e-4f));
+    }
+
+    // A quaternion and its negation are the same rotation.
+    bool IsSameRotation(XMFLOAT4 const& left, XMFLOAT4 const& right)
+    {
+        return fabsf(XMVectorGetX(XMVector4Dot(XMLoadFloat4(&left), XMLoadFloat4(&right)))) > 1.0f - 1e-4f;
+    }
+
+    XMFLOAT4 RandomOrientation()
+    {
+        XMFLOAT4 orientation;
+        XMStoreFloat4(&orientation, XMQuaternionRotationRollPitchYaw(RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI), RandomFloat(-XM_PI, XM_PI)));
+        return orientation;
+    }
+
+    // The neighbor is placed at its relative pose, and the model is found back from the neighbor's pose through the
+    // inverse relation.
+    void TestInverseRelation()
+    {
+        const auto a = CreateModelId(1);
+        const auto b = CreateModelId(2);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const XMFLOAT3 relativePosition{ RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f), RandomFloat(-2.0f, 2.0f) };
+            const XMFLOAT4 relativeOrientation = RandomOrientation();
+
+            SceneLayout layout;
+            layout.AddRelation(a, b, relativePosition, relativeOrientation, 0.1f);
+
+            auto const& neighborsOfA = layout.GetNeighbors(a);
+            auto const& neighborsOfB = layout.GetNeighbors(b);
+            CHECK(neighborsOfA.size() == 1 && neighborsOfB.size() == 1);
+            if (neighborsOfA.size() != 1 || neighborsOfB.size() != 1)
+            {
+                return;
+            }
+
+            CHECK(neighborsOfA[0].ModelId == b && neighborsOfB[0].ModelId == a);
+            CHECK(neighborsOfA[0].Tolerance == 0.1f && neighborsOfB[0].Tolerance == 0.1f);
+
+            const XMFLOAT3 positionOfA{ RandomFloat(-5.0f, 5.0f), RandomFloat(0.0f, 2.0f), RandomFloat(-5.0f, 5.0f) };
+            const XMFLOAT4 orientationOfA = RandomOrientation();
+
+            // Relative to an unrotated model at the origin, the neighbor is at the relative pose itself.
+            XMFLOAT3 position;
+            XMFLOAT4 orientation;
+            neighborsOfA[0].GetPose({}, { 0.0f, 0.0f, 0.0f, 1.0f }, position, orientation);
+            CHECK(IsNear(position, relativePosition) && IsSameRotation(orientation, relativeOrientation));
+
+            XMFLOAT3 positionOfB;
+            XMFLOAT4 orientationOfB;
+            neighborsOfA[0].GetPose(positionOfA, orientationOfA, positionOfB, orientationOfB);
+
+            neighborsOfB[0].GetPose(positionOfB, orientationOfB, position, orientation);
+            CHECK(IsNear(position, positionOfA) && IsSameRotation(orientation, orientationOfA));
+        }
+    }
+
+    void TestNoNeighbors()
+    {
+        SceneLayout layout;
+        CHECK(layout.Empty());
+        CHECK(layout.GetNeighbors(CreateModelId(1)).empty());
+
+        layout.AddRelation(CreateModelId(1), CreateModelId(2), { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, 0.25f);
+        layout.AddRelation(CreateModelId(1), CreateModelId(3), { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, 0.25f);
+
+        CHECK(!layout.Empty());
+        CHECK(layout.GetNeighbors(CreateModelId(1)).size() == 2);
+        CHECK(layout.GetNeighbors(CreateModelId(2)).size() == 1);
+        CHECK(layout.GetNeighbors(CreateModelId(4)).empty());
+    }
+}
+
+int main()
+{
+    TestInverseRelation();
+    TestNoNeighbors();
+
+    return FailureCount();
+}
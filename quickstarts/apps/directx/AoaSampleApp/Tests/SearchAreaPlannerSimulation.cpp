@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/HeadPosePredictor.h"
+#include "../Common/ModelExtentsIndex.h"
+#include "../Common/SearchAreaPlanner.h"
+#include "HeadTrajectories.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+    // Same timing as the app: how long each area is searched, and how far ahead the head pose is predicted.
+    constexpr double c_dwellTime = 2.0;
+    constexpr milliseconds c_predictionTime{ 500 };
+
+    // An object is detected once it has been inside the search area and in view for this long.
+    constexpr double c_observationTime = 1.0;
+    constexpr float c_maxViewAngleInDegrees = 30.0f;
+    constexpr float c_maxViewDistance = 5.0f;
+
+    constexpr double c_stepTime = 0.1;
+    constexpr size_t c_objectCount = 12;
+
+    struct SceneObject
+    {
+        XMFLOAT3 Position;
+        XMFLOAT3 Extents;       // Half widths.
+    };
+
+    // Objects around the places the user passes, at heights from the floor to a work bench, so that the user
+    // can see all of them at some point of the trajectory.
+    vector<SceneObject> CreateScene(HeadTrajectory const& trajectory)
+    {
+        vector<SceneObject> objects(c_objectCount);
+        for (auto& object : objects)
+        {
+            auto const& pose = trajectory.Poses[uniform_int_distribution<size_t>(0, trajectory.Poses.size() - 1)(Random())];
+
+            const float yaw = atan2f(pose.ForwardDirection.x, pose.ForwardDirection.z) + XMConvertToRadians(RandomFloat(-90.0f, 90.0f));
+            const float distance = RandomFloat(1.0f, 3.5f);
+
+            object.Position = { pose.Position.x + sinf(yaw) * distance, RandomFloat(0.0f, 1.2f), pose.Position.z + cosf(yaw) * distance };
+
+            const float size = RandomFloat(0.1f, 0.5f);
+            object.Extents = { size * RandomFloat(0.5f, 1.0f), size * RandomFloat(0.5f, 1.0f), size * RandomFloat(0.5f, 1.0f) };
+        }
+
+        return objects;
+    }
+
+    bool IsInView(HeadPoseSample const& head, XMFLOAT3 const& position)
+    {
+        const XMVECTOR offset = XMVectorSubtract(XMLoadFloat3(&position), XMLoadFloat3(&head.Position));
+        const float distance = XMVectorGetX(XMVector3Length(offset));
+        if (distance > c_maxViewDistance)
+        {
+            return false;
+        }
+
+        return distance == 0.0f || XMVectorGetX(XMVector3Dot(offset, XMLoadFloat3(&head.ForwardDirection))) / distance >= cosf(XMConvertToRadians(c_maxViewAngleInDegrees));
+    }
+
+    bool Contains(SearchAreaProposal const& area, XMFLOAT3 const& position)
+    {
+        XMFLOAT3 halfExtents;
+        XMStoreFloat3(&halfExtents, XMVectorScale(XMLoadFloat3(&area.Extents), 0.5f));
+
+        return BoundingOrientedBox(area.Center, halfExtents, area.Orientation).Contains(XMLoadFloat3(&position)) != DISJOINT;
+    }
+
+    // An upright area centered in front of the head, as an air-tap places it.
+    SearchAreaProposal PlaceInFront(HeadPoseSample const& head, XMFLOAT3 const& extents)
+    {
+        constexpr float c_observationDistance = 2.0f;
+
+        SearchAreaProposal area;
+        XMStoreFloat3(&area.Center, XMVectorMultiplyAdd(XMLoadFloat3(&head.ForwardDirection), XMVectorReplicate(c_observationDistance), XMLoadFloat3(&head.Position)));
+        XMStoreFloat4(&area.Orientation, XMQuaternionRotationAxis(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), atan2f(head.ForwardDirection.x, head.ForwardDirection.z)));
+        area.Extents = extents;
+        return area;
+    }
+
+    // Times at which each object was detected, or a negative time if it wasn't.
+    template <typename Func>
+    vector<double> Simulate(HeadTrajectory const& trajectory, vector<SceneObject> const& objects, Func&& placeArea)
+    {
+        vector<double> observedTimes(objects.size(), 0.0);
+        vector<double> detectionTimes(objects.size(), -1.0);
+
+        optional<SearchAreaProposal> area;
+        double nextPlacementTime = 0.0;
+        const double duration = trajectory.Poses.back().Time;
+
+        for (double time = 0.0; time <= duration; time += c_stepTime)
+        {
+            if (time >= nextPlacementTime)
+            {
+                area = placeArea(time);
+                nextPlacementTime = time + c_dwellTime;
+            }
+
+            if (!area)
+            {
+                continue;
+            }
+
+            const auto head = GetHeadPoseAt(trajectory, time);
+            for (size_t i = 0; i < objects.size(); ++i)
+            {
+                if (detectionTimes[i] < 0.0 && Contains(*area, objects[i].Position) && IsInView(head, objects[i].Position))
+                {
+                    observedTimes[i] += c_stepTime;
+                    if (observedTimes[i] >= c_observationTime)
+                    {
+                        detectionTimes[i] = time;
+                    }
+                }
+            }
+        }
+
+        return detectionTimes;
+    }
+
+    void Report(char const* policy, vector<double> detectionTimes)
+    {
+        detectionTimes.erase(remove_if(detectionTimes.begin(), detectionTimes.end(), [](double time) { return time < 0.0; }), detectionTimes.end());
+        sort(detectionTimes.begin(), detectionTimes.end());
+
+        printf("    %-12s %2zu of %zu detected", policy, detectionTimes.size(), c_objectCount);
+        if (!detectionTimes.empty())
+        {
+            printf(", time to detect: median %5.1f s, 90th percentile %5.1f s", detectionTimes[detectionTimes.size() / 2], detectionTimes[detectionTimes.size() * 9 / 10]);
+        }
+        printf("\n");
+    }
+}
+
+// Compares the search area planner to areas placed in front of the user, on head trajectories recorded on a
+// device if given as arguments, or on synthetic ones otherwise.
+int main(int argc, char** argv)
+{
+    vector<HeadTrajectory> trajectories;
+    for (int i = 1; i < argc; ++i)
+    {
+        trajectories.push_back(LoadHeadTrajectory(argv[i]));
+        if (trajectories.back().Poses.empty())
+        {
+            fprintf(stderr, "No head poses in %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (trajectories.empty())
+    {
+        trajectories = CreateHeadTrajectories();
+    }
+
+    for (auto const& trajectory : trajectories)
+    {
+        const auto objects = CreateScene(trajectory);
+
+        ModelExtentsIndex models;
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            models.Add(Guid{ static_cast<uint32_t>(i + 1) }, objects[i].Extents);
+        }
+
+        printf("%s, %.0f s:\n", trajectory.Name.c_str(), trajectory.Poses.back().Time);
+
+        //
+        // The planner, fed with head poses up to the time of each proposal.
+        //
+
+        HeadPosePredictor predictor;
+        SearchAreaPlanner planner;
+        optional<SearchAreaProposal> searchedArea;
+        size_t poseCount = 0;
+        const auto start = steady_clock::time_point{};
+
+        const auto plannedTimes = Simulate(trajectory, objects, [&](double time) -> optional<SearchAreaProposal>
+        {
+            for (; poseCount < trajectory.Poses.size() && trajectory.Poses[poseCount].Time <= time; ++poseCount)
+            {
+                auto const& pose = trajectory.Poses[poseCount];
+                predictor.AddHeadPose(pose.Position, pose.ForwardDirection, pose.UpDirection, start + duration_cast<steady_clock::duration>(duration<double>(pose.Time)));
+            }
+
+            const auto now = start + duration_cast<steady_clock::duration>(duration<double>(time));
+            if (searchedArea)
+            {
+                planner.MarkSearched(*searchedArea, now);
+            }
+
+            const auto headPose = predictor.Predict(c_predictionTime);
+            searchedArea = headPose ? planner.Propose(*headPose, models.GetSummary(), {}, now) : nullopt;
+            return searchedArea;
+        });
+
+        Report("planner", plannedTimes);
+
+        //
+        // Areas of the same size placed in front of the user, as if the user air-tapped at every dwell.
+        //
+
+        optional<XMFLOAT3> extents;
+        const auto headLockedTimes = Simulate(trajectory, objects, [&](double time) -> optional<SearchAreaProposal>
+        {
+            const auto head = GetHeadPoseAt(trajectory, time);
+            if (!extents)
+            {
+                // The planner sizes its areas the same way whatever the pose.
+                PredictedHeadPose pose{ head.Position, head.ForwardDirection, head.UpDirection };
+                extents = SearchAreaPlanner().Propose(pose, models.GetSummary(), {}, steady_clock::time_point{})->Extents;
+            }
+
+            return PlaceInFront(head, *extents);
+        });
+
+        Report("head-locked", headLockedTimes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/SightingIndex.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    constexpr size_t c_sightingCount = 100000;
+    constexpr uint32_t c_modelCount = 200;
+    constexpr size_t c_maxPriorLocations = 8;       // As the app asks for.
+    constexpr size_t c_queryCount = 100;
+
+    struct Sighting
+    {
+        Guid ModelId;
+        XMFLOAT3 Position;
+    };
+
+    // Each model is mostly seen at a few spots, such as its shelf and a work bench, with the error of the detected
+    // pose, and now and then anywhere else in a 20 m by 20 m hall.
+    vector<Sighting> CreateSightings()
+    {
+        vector<vector<XMFLOAT3>> spots(c_modelCount);
+        for (auto& modelSpots : spots)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                modelSpots.push_back({ RandomFloat(-10.0f, 10.0f), RandomFloat(0.0f, 1.5f), RandomFloat(-10.0f, 10.0f) });
+            }
+        }
+
+        vector<Sighting> sightings(c_sightingCount);
+        for (auto& sighting : sightings)
+        {
+            const uint32_t model = uniform_int_distribution<uint32_t>(0, c_modelCount - 1)(Random());
+            sighting.ModelId = Guid{};
+            sighting.ModelId.Data1 = model + 1;
+
+            if (RandomFloat(0.0f, 1.0f) < 0.9f)
+            {
+                auto const& spot = spots[model][uniform_int_distribution<size_t>(0, 2)(Random())];
+                sighting.Position = { spot.x + RandomFloat(-0.1f, 0.1f), spot.y + RandomFloat(-0.05f, 0.05f), spot.z + RandomFloat(-0.1f, 0.1f) };
+            }
+            else
+            {
+                sighting.Position = { RandomFloat(-10.0f, 10.0f), RandomFloat(0.0f, 1.5f), RandomFloat(-10.0f, 10.0f) };
+            }
+        }
+
+        return sightings;
+    }
+
+    vector<Guid> GetModelIds(uint32_t count)
+    {
+        vector<Guid> modelIds(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            modelIds[i] = Guid{};
+            modelIds[i].Data1 = i + 1;
+        }
+
+        return modelIds;
+    }
+}
+
+int main()
+{
+    const auto sightings = CreateSightings();
+
+    SightingIndex index;
+    const double addSeconds = MeasureSeconds([&]
+    {
+        index.Clear();
+        for (auto const& sighting : sightings)
+        {
+            index.Add(sighting.ModelId, sighting.Position);
+        }
+    }, 3);
+
+    const auto data = index.Encode();
+    printf("%zu sightings of %u models, %zu cells, %zu KiB on disk\n", index.Size(), c_modelCount, (data.size() - 16) / 32, data.size() >> 10);
+    printf("    add all                     %8.2f ms\n", addSeconds * 1e3);
+
+    SightingIndex decoded;
+    const double decodeSeconds = MeasureSeconds([&] { decoded.Decode(data.data(), data.size()); }, 3);
+    printf("    load                        %8.2f ms\n", decodeSeconds * 1e3);
+
+    // Keeps the queries from being optimized out.
+    volatile uint32_t sink = 0;
+
+    // The app asks for the models that aren't tracked, which is most of them until some are found.
+    for (const uint32_t queriedModelCount : { 1u, 10u, c_modelCount })
+    {
+        const auto modelIds = GetModelIds(queriedModelCount);
+
+        const double seconds = MeasureSeconds([&]
+        {
+            for (size_t i = 0; i < c_queryCount; ++i)
+            {
+                sink = index.GetPriorLocations(modelIds, c_maxPriorLocations).front().SightingCount;
+            }
+        }) / c_queryCount;
+
+        printf("    query %3u models            %8.2f us\n", queriedModelCount, seconds * 1e6);
+    }
+
+    return 0;
+}
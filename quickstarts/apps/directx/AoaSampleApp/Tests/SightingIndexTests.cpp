@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#include "pch.h"
+#include "../Common/SightingIndex.h"
+#include "TestUtilities.h"
+
+using namespace AoaSampleApp;
+using namespace AoaSampleApp::Tests;
+using namespace DirectX;
+using namespace std;
+
+namespace
+{
+    Guid CreateModelId(uint32_t number)
+    {
+        Guid id{};
+        id.Data1 = number;
+        return id;
+    }
+
+    bool IsNear(XMFLOAT3 const& left, XMFLOAT3 const& right)
+    {
+        return XMVector3NearEqual(XMLoadFloat3(&left), XMLoadFloat3(&right), XMVectorReplicate(1e-5f));
+    }
+
+    // Sightings in the same cell merge to their mean position, and the most sighted locations come first.
+    void TestPriorLocations()
+    {
+        SightingIndex index(0.5f);
+        const auto a = CreateModelId(1);
+        const auto b = CreateModelId(2);
+
+        index.Add(a, { 0.1f, 0.1f, 0.1f });
+        index.Add(a, { 0.3f, 0.1f, 0.1f });
+        index.Add(a, { 2.1f, 0.1f, 0.1f });
+        index.Add(b, { 5.1f, 0.1f, 0.1f });
+        index.Add(b, { 5.2f, 0.1f, 0.1f });
+        index.Add(b, { 5.3f, 0.1f, 0.1f });
+
+        CHECK(index.Size() == 6);
+
+        const auto locations = index.GetPriorLocations({ a, b }, 2);
+        CHECK(locations.size() == 2);
+        if (locations.size() == 2)
+        {
+            CHECK(locations[0].ModelId == b && locations[0].SightingCount == 3 && IsNear(locations[0].Position, { 5.2f, 0.1f, 0.1f }));
+            CHECK(locations[1].ModelId == a && locations[1].SightingCount == 2 && IsNear(locations[1].Position, { 0.2f, 0.1f, 0.1f }));
+        }
+
+        // Models not asked for aren't returned.
+        const auto onlyA = index.GetPriorLocations({ a, CreateModelId(3) }, 10);
+        CHECK(onlyA.size() == 2);
+        CHECK(all_of(onlyA.begin(), onlyA.end(), [&](PriorLocation const& location) { return location.ModelId == a; }));
+    }
+
+    void TestRoundTrip()
+    {
+        SightingIndex index;
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            index.Add(CreateModelId(i % 7), { RandomFloat(-5.0f, 5.0f), RandomFloat(0.0f, 2.0f), RandomFloat(-5.0f, 5.0f) });
+        }
+
+        const auto data = index.Encode();
+
+        SightingIndex decoded;
+        CHECK(decoded.Decode(data.data(), data.size()));
+        CHECK(decoded.Size() == index.Size());
+
+        // Decoded cells are the same, so the index encodes to the same records, maybe in another order.
+        vector<Guid> modelIds;
+        for (uint32_t i = 0; i < 7; ++i)
+        {
+            modelIds.push_back(CreateModelId(i));
+        }
+
+        auto expected = index.GetPriorLocations(modelIds, 10000);
+        auto actual = decoded.GetPriorLocations(modelIds, 10000);
+        CHECK(actual.size() == expected.size());
+
+        auto byPosition = [](PriorLocation const& left, PriorLocation const& right)
+        {
+            return tie(left.ModelId.Data1, left.Position.x, left.Position.y, left.Position.z) < tie(right.ModelId.Data1, right.Position.x, right.Position.y, right.Position.z);
+        };
+        sort(expected.begin(), expected.end(), byPosition);
+        sort(actual.begin(), actual.end(), byPosition);
+
+        for (size_t i = 0; i < (min)(actual.size(), expected.size()); ++i)
+        {
+            CHECK(actual[i].ModelId == expected[i].ModelId && actual[i].SightingCount == expected[i].SightingCount && IsNear(actual[i].Position, expected[i].Position));
+        }
+    }
+
+    // Every truncation, and an index with trailing bytes, are rejected and leave the index empty.
+    void TestMalformedIndex()
+    {
+        SightingIndex index;
+        index.Add(CreateModelId(1), { 1.0f, 2.0f, 3.0f });
+        index.Add(CreateModelId(2), { 4.0f, 5.0f, 6.0f });
+
+        auto data = index.Encode();
+
+        for (size_t size = 0; size < data.size(); ++size)
+        {
+            SightingIndex decoded;
+            decoded.Add(CreateModelId(3), {});
+
+            CHECK(!decoded.Decode(data.data(), size));
+            CHECK(decoded.Size() == 0);
+        }
+
+        data.push_back(0);
+        SightingIndex decoded;
+        CHECK(!decoded.Decode(data.data(), data.size()));
+    }
+}
+
+int main()
+{
+    TestPriorLocations();
+    TestRoundTrip();
+    TestMalformedIndex();
+
+    return FailureCount();
+}
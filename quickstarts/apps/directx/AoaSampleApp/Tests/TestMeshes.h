@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace AoaSampleApp::Tests
+{
+    // Unit sphere of segmentCount by ringCount quads with its triangles facing out, with bumps of the given
+    // height so that it isn't convex. Vertices along the seam and at the poles are repeated, as in scanned models.
+    inline void CreateBumpySphere(
+        uint32_t segmentCount,
+        uint32_t ringCount,
+        float bumpHeight,
+        std::vector<DirectX::XMFLOAT3>& vertices,
+        std::vector<uint32_t>& indices)
+    {
+        vertices.clear();
+        indices.clear();
+
+        // Repeated vertices have the exact same position, which rounding of the angles would otherwise break.
+        for (uint32_t ring = 0; ring <= ringCount; ++ring)
+        {
+            const bool isPole = ring == 0 || ring == ringCount;
+            const float theta = DirectX::XM_PI * ring / ringCount;
+            const float sinTheta = isPole ? 0.0f : std::sin(theta);
+            const float cosTheta = ring == 0 ? 1.0f : ring == ringCount ? -1.0f : std::cos(theta);
+            const float bump = isPole ? 0.0f : bumpHeight * std::sin(4.0f * theta);
+
+            for (uint32_t segment = 0; segment <= segmentCount; ++segment)
+            {
+                const float phi = DirectX::XM_2PI * (segment % segmentCount) / segmentCount;
+                const float radius = 1.0f + bump * std::sin(5.0f * phi);
+                vertices.push_back({ radius * sinTheta * std::cos(phi), radius * cosTheta, radius * sinTheta * std::sin(phi) });
+            }
+        }
+
+        for (uint32_t ring = 0; ring < ringCount; ++ring)
+        {
+            for (uint32_t segment = 0; segment < segmentCount; ++segment)
+            {
+                const uint32_t a = ring * (segmentCount + 1) + segment;
+                const uint32_t b = a + 1;
+                const uint32_t c = a + segmentCount + 1;
+                const uint32_t d = c + 1;
+
+                // The quads at the poles are triangles.
+                if (ring != 0)
+                {
+                    indices.insert(indices.end(), { a, b, c });
+                }
+
+                if (ring != ringCount - 1)
+                {
+                    indices.insert(indices.end(), { b, d, c });
+                }
+            }
+        }
+    }
+
+    // Triangles of a triangle list in sorted order, each rotated so that its smallest index comes first, which
+    // keeps its winding. Lists with the same triangles in any order give the same result.
+    inline std::vector<std::array<uint32_t, 3>> GetSortedTriangles(uint32_t const* indices, size_t indexCount)
+    {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            std::array<uint32_t, 3> triangle{ indices[i], indices[i + 1], indices[i + 2] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
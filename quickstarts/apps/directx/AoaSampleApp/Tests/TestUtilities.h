@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+
+namespace AoaSampleApp::Tests
+{
+    // Failed checks are counted rather than aborting, so that a run reports all of them. Test executables
+    // return the count from main, which ctest reports as a failure when it isn't zero.
+    inline int& FailureCount()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool Check(bool condition, char const* expression, char const* file, int line)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+            ++FailureCount();
+        }
+
+        return condition;
+    }
+
+    // Same seed on every run, so that failures reproduce.
+    inline std::mt19937& Random()
+    {
+        static std::mt19937 generator(12345);
+        return generator;
+    }
+
+    inline float RandomFloat(float minimum, float maximum)
+    {
+        return std::uniform_real_distribution<float>(minimum, maximum)(Random());
+    }
+
+    // Best time of a few runs of the function, in seconds, so that a single slow run doesn't skew the result.
+    template <typename Func>
+    double MeasureSeconds(Func&& func, int runCount = 5)
+    {
+        double best = (std::numeric_limits<double>::max)();
+        for (int run = 0; run < runCount; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            best = (std::min)(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        return best;
+    }
+}
+
+#define CHECK(condition) ::AoaSampleApp::Tests::Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+#pragma once
+
+// Stands in for the app's precompiled header, with only the headers the portable sources rely on.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
@@ -11,6 +11,7 @@
 #include <DirectXCollision.h>
 #include <DirectXColors.h>
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
 #include <dwrite_2.h>
 #include <functional>	// For bind
 #include <future>